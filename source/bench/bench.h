@@ -0,0 +1,143 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/*!
+ * @file bench.h
+ * @brief A tiny benchmark harness for the `sc::list` operations.
+ *
+ * Each case runs a few untimed warmup repetitions and then a number of timed
+ * repetitions. Only the operation itself is timed; the (optional) preparation
+ * step that restores the input runs outside the clock. Results are reported
+ * as a table, or as CSV or JSON for tracking regressions.
+ */
+
+#include <algorithm>  // sort
+#include <chrono>
+#include <cstddef>
+#include <iomanip>    // setw
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+    /// Prevents the compiler from optimizing away a value computed by the benchmark.
+    template < typename T >
+    inline void escape( const T & value )
+    {
+        asm volatile( "" : : "r,m"( value ) : "memory" );
+    }
+
+    /// The outcome of a single benchmark case.
+    struct Result {
+        std::string name; //!< Case name.
+        size_t n;         //!< Problem size.
+        size_t ops;       //!< Operations performed by one repetition (usually `n`).
+        size_t reps;      //!< Timed repetitions.
+        double median_ns; //!< Median time of one repetition, in nanoseconds.
+        double p99_ns;    //!< 99th percentile of the time of one repetition, in nanoseconds.
+
+        /// Median time per operation.
+        double ns_per_op( void ) const { return ops == 0 ? median_ns : median_ns / ops; }
+
+        /// Returns a copy of this result, where one repetition performs `count` operations.
+        Result per( size_t count ) const { Result r{ *this }; r.ops = count; return r; }
+    };
+
+    /*!
+     * Times `op` `reps` times, calling `prepare` (untimed) before each run.
+     * @param name Case name.
+     * @param n Problem size, used to report the time per element.
+     * @param reps Number of timed repetitions.
+     * @param prepare Nullary callable that sets up the input of a run.
+     * @param op Nullary callable with the operation under test.
+     * @param warmup Number of untimed repetitions run first.
+     */
+    template < typename Prepare, typename Op >
+    Result measure( const std::string & name, size_t n, size_t reps, Prepare prepare, Op op, size_t warmup = 1 )
+    {
+        using clock = std::chrono::steady_clock;
+        for ( size_t i{0} ; i < warmup ; ++i )
+        {
+            prepare();
+            op();
+        }
+        std::vector< double > samples;
+        samples.reserve( reps );
+        for ( size_t i{0} ; i < reps ; ++i )
+        {
+            prepare();
+            auto start = clock::now();
+            op();
+            auto stop = clock::now();
+            samples.push_back( std::chrono::duration< double, std::nano >( stop - start ).count() );
+        }
+        std::sort( samples.begin(), samples.end() );
+        size_t p99 = ( samples.size() * 99 + 99 ) / 100 - 1; // ceil(0.99 * size) - 1
+        return Result{ name, n, n, reps, samples[ samples.size() / 2 ], samples[ p99 ] };
+    }
+
+    /// Number of repetitions for a problem of size `n`: about `budget` elements in total, within [lo, hi].
+    inline size_t reps_for( size_t n, size_t budget = 1000000, size_t lo = 3, size_t hi = 1000 )
+    {
+        size_t r = n == 0 ? hi : budget / n;
+        return std::max( lo, std::min( hi, r ) );
+    }
+
+    /// Output formats.
+    enum class format { table, csv, json };
+
+    /// Writes the results, one by one, in the chosen format.
+    class Reporter {
+        private:
+            format m_format;    //!< Output format.
+            std::ostream & m_os;  //!< Output stream.
+            size_t m_count;     //!< Results written so far.
+
+        public:
+            explicit Reporter( format f = format::table, std::ostream & os = std::cout )
+                : m_format{ f }, m_os( os ), m_count{ 0 }
+            { /* empty */ }
+
+            /// Writes the header (table and CSV) or opens the array (JSON).
+            void begin( void )
+            {
+                if ( m_format == format::table )
+                    m_os << std::left << std::setw( 36 ) << "case" << std::right
+                         << std::setw( 10 ) << "n" << std::setw( 7 ) << "reps"
+                         << std::setw( 15 ) << "median (ns)" << std::setw( 15 ) << "p99 (ns)"
+                         << std::setw( 12 ) << "ns/op" << '\n';
+                else if ( m_format == format::csv )
+                    m_os << "case,n,ops,reps,median_ns,p99_ns,ns_per_op\n";
+                else
+                    m_os << "[";
+            }
+
+            /// Writes one result.
+            void add( const Result & r )
+            {
+                if ( m_format == format::table )
+                    m_os << std::left << std::setw( 36 ) << r.name << std::right
+                         << std::setw( 10 ) << r.n << std::setw( 7 ) << r.reps << std::fixed
+                         << std::setw( 15 ) << std::setprecision( 0 ) << r.median_ns
+                         << std::setw( 15 ) << r.p99_ns
+                         << std::setw( 12 ) << std::setprecision( 2 ) << r.ns_per_op() << '\n';
+                else if ( m_format == format::csv )
+                    m_os << r.name << ',' << r.n << ',' << r.ops << ',' << r.reps << std::fixed << std::setprecision( 1 )
+                         << ',' << r.median_ns << ',' << r.p99_ns << ',' << std::setprecision( 3 ) << r.ns_per_op() << '\n';
+                else
+                    m_os << ( m_count == 0 ? "\n" : ",\n" ) << std::fixed << std::setprecision( 1 )
+                         << "  {\"case\": \"" << r.name << "\", \"n\": " << r.n << ", \"ops\": " << r.ops
+                         << ", \"reps\": " << r.reps << ", \"median_ns\": " << r.median_ns
+                         << ", \"p99_ns\": " << r.p99_ns << ", \"ns_per_op\": " << std::setprecision( 3 ) << r.ns_per_op() << "}";
+                m_os.flush();
+                ++m_count;
+            }
+
+            /// Closes the array (JSON).
+            void end( void )
+            {
+                if ( m_format == format::json ) m_os << "\n]\n";
+            }
+    };
+}
+#endif
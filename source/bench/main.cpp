@@ -0,0 +1,676 @@
+#include <algorithm>
+#include <cmath>     // pow
+#include <atomic>
+#include <cstdlib>   // strtoul
+#include <cstring>   // strcmp
+#include <list>
+#include <mutex>
+#include <numeric>  // accumulate
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "../include/list.h"
+#include "../include/unrolled_list.h"
+#include "../include/indexed_list.h"
+#include "../include/concurrent_list.h"
+#include "../include/lockfree_list_queue.h"
+#include "../include/linked_hash_map.h"
+#include "../include/sharded_lru.h"
+#include "../include/sorted_list.h"
+
+// ============================================================================
+// BENCHMARKING sc::list OPERATIONS
+// ============================================================================
+//
+// Usage: list_bench [--csv | --json] [max_n]
+// Sizes grow by powers of 10, from 10 up to max_n (default 10^7).
+// Results go to the standard output, as a table (default), CSV or JSON.
+
+namespace {
+    /// Overwrites the list values (in the current node order) with pseudo-random numbers.
+    template < typename List >
+    void scramble( List & l, std::mt19937 & rng )
+    {
+        for ( auto & e : l ) e = static_cast< int >( rng() );
+    }
+
+    /// Fills 'l' with 'n' values produced by 'value( i )'.
+    template < typename List, typename Value >
+    void fill( List & l, size_t n, Value value )
+    {
+        l.clear();
+        for ( size_t i{0} ; i < n ; ++i ) l.push_back( value( i ) );
+    }
+
+    /*! The common list operations, run on `List` (sc::list or std::list, for comparison).
+     *  Every case is named "<operation>/<lib>"; the time per operation is per element,
+     *  except for splice, which is a single operation.
+     */
+    template < typename List >
+    void bench_container( bench::Reporter & out, const std::string & lib, size_t n, std::mt19937 & rng )
+    {
+        auto reps = bench::reps_for( n );
+        auto iota = []( size_t i ){ return static_cast< int >( i ); };
+        List base;
+        fill( base, n, iota );
+        List l;
+
+        out.add( bench::measure( "push_back/" + lib, n, reps,
+            [&]{ l.clear(); },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) l.push_back( static_cast< int >( i ) ); } ) );
+
+        out.add( bench::measure( "push_front/" + lib, n, reps,
+            [&]{ l.clear(); },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) l.push_front( static_cast< int >( i ) ); } ) );
+
+        out.add( bench::measure( "pop_back/" + lib, n, reps,
+            [&]{ l = base; },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) l.pop_back(); } ) );
+
+        out.add( bench::measure( "pop_front/" + lib, n, reps,
+            [&]{ l = base; },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) l.pop_front(); } ) );
+
+        // n elements inserted before (or erased from) the middle of a list of n elements.
+        typename List::iterator pos;
+        out.add( bench::measure( "insert-mid/" + lib, n, reps,
+            [&]{ l = base; pos = std::next( l.begin(), n / 2 ); },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) l.insert( pos, static_cast< int >( i ) ); } ) );
+
+        out.add( bench::measure( "erase-mid/" + lib, n, reps,
+            [&]{ l = base; pos = std::next( l.begin(), n / 2 ); },
+            [&]{
+                for ( size_t i{0} ; i < n ; ++i ) {
+                    pos = l.erase( pos );
+                    if ( pos == l.end() ) pos = l.begin();
+                }
+            } ) );
+
+        // Bulk operations: a whole range inserted, erased or filtered at once.
+        out.add( bench::measure( "insert-range/" + lib, n, reps,
+            [&]{ fill( l, 2, iota ); },
+            [&]{ l.insert( std::next( l.begin() ), base.begin(), base.end() ); } ) );
+
+        out.add( bench::measure( "erase-range/" + lib, n, reps,
+            [&]{ l = base; },
+            [&]{ l.erase( l.begin(), l.end() ); } ) );
+
+        out.add( bench::measure( "remove_if/" + lib, n, reps,
+            [&]{ l = base; },
+            [&]{ l.remove_if( []( int e ){ return e % 4 < 2; } ); } ) );
+
+        long long sum{ 0 };
+        out.add( bench::measure( "traverse/" + lib, n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( const auto & e : base ) sum += e; bench::escape( sum ); } ) );
+
+        // The same walk through std algorithms over a const list: it should cost the same as the loop above.
+        const List & cbase = base;
+        out.add( bench::measure( "accumulate/" + lib, n, reps,
+            [&]{ sum = 0; },
+            [&]{ sum = std::accumulate( cbase.begin(), cbase.end(), 0LL ); bench::escape( sum ); } ) );
+
+        bool found{ false };
+        out.add( bench::measure( "find_if/" + lib, n, reps,
+            [&]{ found = false; },
+            [&]{ found = std::find_if( cbase.begin(), cbase.end(), []( int e ){ return e < 0; } ) != cbase.end(); bench::escape( found ); } ) );
+
+        out.add( bench::measure( "copy/" + lib, n, reps,
+            [&]{ l.clear(); },
+            [&]{ l = base; } ) );
+
+        // Assigning over a list of about the same size: the nodes already there are reused.
+        out.add( bench::measure( "copy-over/" + lib, n, reps,
+            [&]{ fill( l, n, []( size_t i ){ return static_cast< int >( i ); } ); },
+            [&]{ l = base; } ) );
+
+        out.add( bench::measure( "copy-construct/" + lib, n, reps,
+            [&]{ l.clear(); },
+            [&]{ List copy{ base }; l.swap( copy ); } ) );
+
+        out.add( bench::measure( "reverse/" + lib, n, reps,
+            [&]{ },
+            [&]{ l.reverse(); } ) );
+
+        out.add( bench::measure( "unique/" + lib, n, reps,
+            [&]{ fill( l, n, []( size_t i ){ return static_cast< int >( i / 2 ); } ); },
+            [&]{ l.unique(); } ) );
+
+        out.add( bench::measure( "sort/" + lib, n, reps,
+            [&]{ l = base; scramble( l, rng ); },
+            [&]{ l.sort(); } ) );
+
+        // Two sorted halves: the even and the odd numbers.
+        List other;
+        out.add( bench::measure( "merge/" + lib, n, reps,
+            [&]{
+                fill( l, n / 2, []( size_t i ){ return static_cast< int >( 2 * i ); } );
+                fill( other, n - n / 2, []( size_t i ){ return static_cast< int >( 2 * i + 1 ); } );
+            },
+            [&]{ l.merge( other ); } ) );
+
+        typename List::const_iterator cpos;
+        out.add( bench::measure( "splice/" + lib, n, reps,
+            [&]{
+                fill( l, n / 2, iota );
+                fill( other, n - n / 2, iota );
+                cpos = std::next( l.cbegin(), n / 4 );
+            },
+            [&]{ l.splice( cpos, other ); } ).per( 1 ) );
+
+        // Every element moved, one at a time, to the end of another list (no node is reallocated).
+        out.add( bench::measure( "splice-one/" + lib, n, reps,
+            [&]{ fill( l, n, iota ); other.clear(); },
+            [&]{ while ( not l.empty() ) other.splice( other.cend(), l, l.cbegin() ); } ) );
+    }
+
+    /// The parallel sc::list::sort() against the sequential one, both radix sorting the ints.
+    void bench_sort( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        sc::list<int> l( n );
+        auto reps = bench::reps_for( n );
+
+        out.add( bench::measure( "sort-par/sc::list", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.sort( sc::execution::par ); } ) );
+
+        out.add( bench::measure( "sort-seq/sc::list", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.sort(); } ) );
+    }
+
+    /*! sc::list::sort() on ints, which picks the LSD radix sort, against the merge sort it
+     *  uses for any other comparison (forced here with a lambda), per element.
+     */
+    void bench_radix( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        sc::list<int> l( n );
+        auto reps = bench::reps_for( n, 1000000, n >= 10000000 ? 1 : 3 );   // Uma repetição basta a partir de 10^7 nós.
+
+        out.add( bench::measure( "sort-radix/sc::list", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.sort(); } ) );
+
+        out.add( bench::measure( "sort-merge/sc::list", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.sort( []( int a, int b ){ return a < b; } ); } ) );
+    }
+
+    /*! The 100 smallest ints of a list with partial_sort(), against sorting it whole, and the
+     *  median with nth_element(), per element (from 10^3 elements up).
+     */
+    void bench_select( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        if ( n < 1000 ) return;
+        sc::list<int> l( n );
+        auto reps = bench::reps_for( n, 1000000, n >= 10000000 ? 1 : 3 );
+
+        out.add( bench::measure( "top-100/sc::list-partial_sort", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.partial_sort( 100 ); } ) );
+
+        out.add( bench::measure( "top-100/sc::list-sort", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ l.sort(); } ) );
+
+        out.add( bench::measure( "nth-element/sc::list", n, reps,
+            [&]{ scramble( l, rng ); },
+            [&]{ bench::escape( *l.nth_element( n / 2 ) ); } ) );
+    }
+
+    /// sc::list::find() against the naive loop (std::find over the iterators), scanning the whole list.
+    void bench_find( bench::Reporter & out, size_t n )
+    {
+        sc::list<int> l;
+        for ( size_t i{0} ; i < n ; ++i ) l.push_back( static_cast< int >( i ) );
+        auto reps = bench::reps_for( n, 10000000 );
+        bool found{ false };
+
+        out.add( bench::measure( "find/sc::list", n, reps,
+            []{},
+            [&]{ found = l.find( -1 ) != l.end(); bench::escape( found ); } ) );
+
+        out.add( bench::measure( "find/naive-loop", n, reps,
+            []{},
+            [&]{ found = std::find( l.begin(), l.end(), -1 ) != l.end(); bench::escape( found ); } ) );
+    }
+
+    /// operator== and operator< on two equal lists, which are walked to the end: ns/elem stays flat as n grows.
+    void bench_compare( bench::Reporter & out, size_t n )
+    {
+        sc::list<int> l1;
+        for ( size_t i{0} ; i < n ; ++i ) l1.push_back( static_cast< int >( i ) );
+        sc::list<int> l2{ l1 };
+        auto reps = bench::reps_for( n, 10000000 );
+        bool result{ false };
+
+        out.add( bench::measure( "compare-equal/sc::list", n, reps,
+            []{},
+            [&]{ result = l1 == l2; bench::escape( result ); } ) );
+
+        out.add( bench::measure( "compare-less/sc::list", n, reps,
+            []{},
+            [&]{ result = l1 < l2; bench::escape( result ); } ) );
+    }
+
+    /*! A range of n/2 elements spliced from the middle of one list into another, per splice:
+     *  O(k) when the size is kept eagerly (the range is counted), O(1) when it is lazy. The
+     *  "+size" case calls size() on both lists right after, which is where the lazy policy
+     *  pays for the count.
+     */
+    template < typename List >
+    void bench_splice_range( bench::Reporter & out, const std::string & name, size_t n, bool ask_size )
+    {
+        auto iota = []( size_t i ){ return static_cast< int >( i ); };
+        List base, l, other;
+        fill( base, n, iota );
+        typename List::const_iterator first, last;
+        size_t total{ 0 };
+        out.add( bench::measure( name, n, bench::reps_for( n ),
+            [&]{
+                List copy{ base };              // Nós do construtor de cópia: em blocos, soltos um a um depois.
+                l.swap( copy );
+                fill( other, 2, iota );
+                first = std::next( l.cbegin(), n / 4 );
+                last = std::next( first, n / 2 );
+            },
+            [&]{
+                other.splice( std::next( other.cbegin() ), l, first, last );
+                if ( ask_size ) { total = l.size() + other.size(); bench::escape( total ); }
+            } ).per( 1 ) );
+    }
+
+    void bench_size_policy( bench::Reporter & out, size_t n )
+    {
+        using lazy_list = sc::list< int, std::allocator<int>, sc::lazy_size >;
+        bench_splice_range< sc::list<int> >( out, "splice-range/sc::list", n, false );
+        bench_splice_range< lazy_list >( out, "splice-range/sc::list-lazy", n, false );
+        bench_splice_range< lazy_list >( out, "splice-range+size/sc::list-lazy", n, true );
+        bench_splice_range< std::list<int> >( out, "splice-range/std::list", n, false );
+    }
+
+    /// The usual hand-made LRU cache, for comparison: a hash map of iterators into an sc::list relinked by splice().
+    class list_lru
+    {
+        private:
+            using entry_list = sc::list< std::pair< int, int > >;
+            entry_list m_order;
+            std::unordered_map< int, entry_list::iterator > m_index;
+            size_t m_capacity;
+
+        public:
+            explicit list_lru( size_t capacity_ ) : m_capacity{ capacity_ } { m_index.reserve( capacity_ ); }
+
+            int * get( int key_ )
+            {
+                auto found = m_index.find( key_ );
+                if ( found == m_index.end() ) return nullptr;
+                m_order.splice( m_order.cend(), m_order, found->second );
+                return &found->second->second;
+            }
+
+            void put( int key_, int value_ )
+            {
+                auto found = m_index.find( key_ );
+                if ( found != m_index.end() ) {
+                    found->second->second = value_;
+                    m_order.splice( m_order.cend(), m_order, found->second );
+                    return;
+                }
+                if ( m_index.size() >= m_capacity ) {
+                    m_index.erase( m_order.front().first );
+                    m_order.pop_front();
+                }
+                m_order.emplace_back( key_, value_ );
+                m_index.emplace( key_, std::prev( m_order.end() ) );
+            }
+    };
+
+    /*! A cache of n entries: "get-hit" looks up random keys that are all present (the hit path:
+     *  one hash lookup plus the policy update), "put-evict" inserts new random keys into the
+     *  full cache, so every insertion evicts one entry. Reported per operation.
+     */
+    template < typename Cache >
+    void bench_cache_case( bench::Reporter & out, const std::string & lib, size_t n, const std::vector<int> & keys )
+    {
+        Cache cache( n );
+        for ( size_t i{0} ; i < n ; ++i ) cache.put( static_cast< int >( i ), static_cast< int >( i ) );
+        long long sum{ 0 };
+        std::mt19937 fresh{ 7 };                // Chaves novas: sempre acima de n.
+
+        out.add( bench::measure( "get-hit/" + lib, n, bench::reps_for( n, 100000 ),
+            [&]{ sum = 0; },
+            [&]{ for ( auto k : keys ) sum += *cache.get( k ); bench::escape( sum ); } ).per( keys.size() ) );
+
+        out.add( bench::measure( "put-evict/" + lib, n, bench::reps_for( n, 100000 ),
+            []{},
+            [&]{
+                for ( size_t i{0} ; i < keys.size() ; ++i ) {
+                    int key = static_cast< int >( n + fresh() % ( 1u << 30 ) );
+                    cache.put( key, key );
+                }
+            } ).per( keys.size() ) );
+    }
+
+    void bench_cache( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        std::vector<int> keys( std::min< size_t >( n, 100000 ) );
+        for ( auto & k : keys ) k = static_cast< int >( rng() % n );
+        bench_cache_case< sc::linked_hash_map< int, int > >( out, "sc::linked_hash_map-lru", n, keys );
+        bench_cache_case< sc::linked_hash_map< int, int, sc::lfu_policy > >( out, "sc::linked_hash_map-lfu", n, keys );
+        bench_cache_case< sc::linked_hash_map< int, int, sc::clock_policy > >( out, "sc::linked_hash_map-clock", n, keys );
+        bench_cache_case< list_lru >( out, "std::unordered_map+sc::list", n, keys );
+    }
+
+    /*! Keeping a list sorted: inserting n random values into sc::sorted_list, against the scan
+     *  to the insertion point on sc::list (O(n) per insert, so only up to 10^4 elements), then
+     *  100 random lookups, a traversal and a merge of two halves on sc::sorted_list.
+     */
+    void bench_sorted( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        auto reps = bench::reps_for( n );
+        std::vector<int> values( n );
+        for ( auto & v : values ) v = static_cast< int >( rng() );
+        sc::sorted_list<int> sorted, other;
+        long long sum{ 0 };
+
+        out.add( bench::measure( "sorted-insert/sc::sorted_list", n, reps,
+            [&]{ sorted.clear(); },
+            [&]{ for ( auto v : values ) sorted.insert( v ); } ) );
+
+        if ( n <= 10000 ) {
+            sc::list<int> l;
+            out.add( bench::measure( "sorted-insert/sc::list", n, reps,
+                [&]{ l.clear(); },
+                [&]{
+                    for ( auto v : values ) {
+                        auto pos = l.cbegin();
+                        while ( pos != l.cend() and *pos < v ) ++pos;
+                        l.insert( pos, v );
+                    }
+                } ) );
+        }
+
+        const size_t queries{ 100 };
+        out.add( bench::measure( "sorted-find/sc::sorted_list", n, bench::reps_for( n, 100000 ),
+            [&]{ sum = 0; },
+            [&]{ for ( size_t q{0} ; q < queries ; ++q ) sum += *sorted.lower_bound( values[ q * 7 % n ] ); bench::escape( sum ); } ).per( queries ) );
+
+        out.add( bench::measure( "traverse/sc::sorted_list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( const auto & e : sorted ) sum += e; bench::escape( sum ); } ) );
+
+        out.add( bench::measure( "merge/sc::sorted_list", n, reps,
+            [&]{
+                sorted.clear();
+                other.clear();
+                for ( size_t i{0} ; i < n ; ++i ) ( i % 2 ? other : sorted ).insert( static_cast< int >( i ) );
+            },
+            [&]{ sorted.merge( other ); } ) );
+    }
+
+    /// Access by position: 100 random positions, reported per access (O(n) each on sc::list, O(log n) on sc::indexed_list).
+    void bench_indexed( bench::Reporter & out, size_t n, std::mt19937 & rng )
+    {
+        const size_t queries{ 100 };
+        std::vector< size_t > positions( queries );
+        for ( auto & p : positions ) p = rng() % n;
+        sc::list<int> l;
+        sc::indexed_list<int> il;
+        for ( size_t i{0} ; i < n ; ++i ) {
+            l.push_back( static_cast< int >( i ) );
+            il.push_back( static_cast< int >( i ) );
+        }
+        auto reps = bench::reps_for( n, 100000 );
+        long long sum{ 0 };
+
+        out.add( bench::measure( "at/sc::list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( auto p : positions ) sum += *std::next( l.begin(), p ); bench::escape( sum ); } ).per( queries ) );
+
+        out.add( bench::measure( "at/sc::indexed_list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( auto p : positions ) sum += il[ p ]; bench::escape( sum ); } ).per( queries ) );
+
+        out.add( bench::measure( "distance/sc::indexed_list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( auto p : positions ) sum += il.cend() - ( il.cbegin() + p ); bench::escape( sum ); } ).per( queries ) );
+
+        out.add( bench::measure( "traverse/sc::indexed_list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( const auto & e : il ) sum += e; bench::escape( sum ); } ) );
+    }
+
+    /// The sc::unrolled_list cases to compare with the sc::list ones (one cache line per node).
+    void bench_unrolled( bench::Reporter & out, size_t n )
+    {
+        auto reps = bench::reps_for( n );
+        sc::unrolled_list<int> u;
+        long long sum{ 0 };
+
+        out.add( bench::measure( "push_back/sc::unrolled_list", n, reps,
+            [&]{ u.clear(); },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) u.push_back( static_cast< int >( i ) ); } ) );
+
+        out.add( bench::measure( "traverse/sc::unrolled_list", n, reps,
+            [&]{ sum = 0; },
+            [&]{ for ( const auto & e : u ) sum += e; bench::escape( sum ); } ) );
+
+        // n elements inserted into the middle of a list of n elements, each right after the previous one.
+        sc::unrolled_list<int>::iterator pos;
+        out.add( bench::measure( "insert-mid/sc::unrolled_list", n, reps,
+            [&]{
+                u.clear();
+                for ( size_t i{0} ; i < n ; ++i ) u.push_back( static_cast< int >( i ) );
+                pos = std::next( u.begin(), n / 2 );
+            },
+            [&]{ for ( size_t i{0} ; i < n ; ++i ) pos = std::next( u.insert( pos, static_cast< int >( i ) ) ); } ) );
+    }
+
+    /// An sc::list behind a single mutex: the baseline for the concurrent containers.
+    class locked_list
+    {
+        std::mutex m_lock;
+        sc::list<int> m_list;
+
+        public:
+            void push_back( int value_ )
+            {
+                std::lock_guard< std::mutex > guard( m_lock );
+                m_list.push_back( value_ );
+            }
+            bool try_pop_front( int & value_ )
+            {
+                std::lock_guard< std::mutex > guard( m_lock );
+                if ( m_list.empty() ) return false;
+                value_ = m_list.front();
+                m_list.pop_front();
+                return true;
+            }
+    };
+
+    /// Gives sc::lockfree_list_queue the push_back() that run_pipeline() calls.
+    struct lockfree_channel
+    {
+        sc::lockfree_list_queue<int> queue;
+        void push_back( int value_ ) { queue.push( value_ ); }
+    };
+
+    /*! Moves 'items' elements through 'channel', with 'threads' threads: half push at the back,
+     *  the others call 'consume( channel )', which returns how many elements it took. A single
+     *  thread pushes everything and then consumes it.
+     */
+    template < typename Channel, typename Consume >
+    void run_pipeline( Channel & channel, size_t items, unsigned threads, Consume consume )
+    {
+        unsigned producers = std::max( 1u, threads / 2 ), consumers = threads - producers;
+        std::atomic< size_t > remaining{ items };
+        auto produce = [&]( unsigned p ){
+            for ( size_t i = p ; i < items ; i += producers ) channel.push_back( static_cast< int >( i ) );
+        };
+        auto drain = [&]{
+            while ( remaining > 0 ) {
+                size_t taken = consume( channel );
+                if ( taken == 0 ) std::this_thread::yield();
+                else remaining -= taken;
+            }
+        };
+        if ( consumers == 0 ) { produce( 0 ); drain(); return; }
+        std::vector< std::thread > pool;
+        for ( unsigned p{0} ; p < producers ; ++p ) pool.emplace_back( produce, p );
+        for ( unsigned c{0} ; c < consumers ; ++c ) pool.emplace_back( drain );
+        for ( auto & t : pool ) t.join();
+    }
+
+    /// Producer/consumer throughput from 1 to 64 threads: one mutex around an sc::list vs. sc::concurrent_list and sc::lockfree_list_queue.
+    void bench_concurrent( bench::Reporter & out, size_t items )
+    {
+        const size_t reps{ 3 };
+        for ( unsigned t{1} ; t <= 64 ; t *= 2 ) {
+            std::string threads = "/t=" + std::to_string( t );
+            out.add( bench::measure( "mpmc/locked-sc::list" + threads, items, reps,
+                []{},
+                [&]{
+                    locked_list channel;
+                    run_pipeline( channel, items, t, []( locked_list & c ){ int v; return c.try_pop_front( v ) ? 1 : 0; } );
+                } ) );
+
+            out.add( bench::measure( "mpmc/sc::concurrent_list" + threads, items, reps,
+                []{},
+                [&]{
+                    sc::concurrent_list<int> channel;
+                    run_pipeline( channel, items, t, []( sc::concurrent_list<int> & c ){ int v; return c.try_pop_front( v ) ? 1 : 0; } );
+                } ) );
+
+            out.add( bench::measure( "mpmc/sc::concurrent_list-batch" + threads, items, reps,
+                []{},
+                [&]{
+                    sc::concurrent_list<int> channel;
+                    run_pipeline( channel, items, t, []( sc::concurrent_list<int> & c ){ return c.splice_out( 64 ).size(); } );
+                } ) );
+
+            out.add( bench::measure( "mpmc/sc::lockfree_list_queue" + threads, items, reps,
+                []{},
+                [&]{
+                    lockfree_channel channel;
+                    run_pipeline( channel, items, t, []( lockfree_channel & c ){ int v; return c.queue.try_pop( v ) ? 1 : 0; } );
+                } ) );
+        }
+    }
+
+    /// A single LRU cache behind one mutex: the baseline for sc::sharded_lru.
+    struct locked_lru
+    {
+        std::mutex lock;
+        sc::linked_hash_map< int, int > cache;
+
+        explicit locked_lru( size_t capacity_ ) : cache( capacity_ ) { }
+        bool get( int key_, int & value_ )
+        {
+            std::lock_guard< std::mutex > guard( lock );
+            int * found = cache.get( key_ );
+            if ( found == nullptr ) return false;
+            value_ = *found;
+            return true;
+        }
+        void put( int key_, int value_ )
+        {
+            std::lock_guard< std::mutex > guard( lock );
+            cache.put( key_, value_ );
+        }
+    };
+
+    /// 'count' keys drawn from a Zipf distribution (exponent 'skew') over [0, universe), by inverting its CDF.
+    std::vector<int> zipf_keys( size_t count, size_t universe, double skew, std::mt19937 & rng )
+    {
+        std::vector< double > cdf( universe );
+        double total{ 0 };
+        for ( size_t i{0} ; i < universe ; ++i ) cdf[i] = total += 1.0 / std::pow( double( i + 1 ), skew );
+        std::uniform_real_distribution< double > uniform( 0.0, total );
+        std::vector<int> keys( count );
+        for ( auto & k : keys )
+            k = static_cast< int >( std::lower_bound( cdf.begin(), cdf.end(), uniform( rng ) ) - cdf.begin() );
+        return keys;
+    }
+
+    /*! Read-through cache traffic: every thread looks up its share of 'keys' and stores the
+     *  keys it misses. The cache holds a tenth of the key universe, so with Zipfian keys
+     *  (exponent 0.99) most lookups are hits.
+     */
+    template < typename Cache >
+    void run_zipf( Cache & cache, const std::vector<int> & keys, unsigned threads )
+    {
+        auto work = [&]( unsigned t ){
+            int value;
+            for ( size_t i = t ; i < keys.size() ; i += threads )
+                if ( not cache.get( keys[i], value ) ) cache.put( keys[i], keys[i] );
+        };
+        std::vector< std::thread > pool;
+        for ( unsigned t{1} ; t < threads ; ++t ) pool.emplace_back( work, t );
+        work( 0 );
+        for ( auto & th : pool ) th.join();
+    }
+
+    /// Zipfian read-through traffic from 1 to 16 threads: one mutex around an sc::linked_hash_map vs. sc::sharded_lru.
+    void bench_zipf( bench::Reporter & out, size_t universe, std::mt19937 & rng )
+    {
+        const size_t reps{ 3 };
+        std::vector<int> keys = zipf_keys( 1u << 20, universe, 0.99, rng );
+        for ( unsigned t{1} ; t <= 16 ; t *= 2 ) {
+            std::string threads = "/t=" + std::to_string( t );
+            locked_lru locked( universe / 10 );
+            out.add( bench::measure( "zipf/locked-sc::linked_hash_map" + threads, keys.size(), reps,
+                []{},
+                [&]{ run_zipf( locked, keys, t ); } ) );
+
+            sc::sharded_lru< int, int > sharded( universe / 10, 64 );
+            out.add( bench::measure( "zipf/sc::sharded_lru" + threads, keys.size(), reps,
+                []{},
+                [&]{ run_zipf( sharded, keys, t ); } ) );
+        }
+    }
+}
+
+int main( int argc, char * argv[] )
+{
+    size_t max_n{ 10000000 };
+    size_t sort_max_n{ 0 };     // --sort-max=N: bench_radix() alone continues up to N (10^8 nodes need ~2.4 GB).
+    bench::format format{ bench::format::table };
+    for ( int i{1} ; i < argc ; ++i )
+    {
+        if ( std::strcmp( argv[i], "--csv" ) == 0 ) format = bench::format::csv;
+        else if ( std::strcmp( argv[i], "--json" ) == 0 ) format = bench::format::json;
+        else if ( std::strncmp( argv[i], "--sort-max=", 11 ) == 0 ) sort_max_n = std::strtoul( argv[i] + 11, nullptr, 10 );
+        else max_n = std::strtoul( argv[i], nullptr, 10 );
+    }
+    std::mt19937 rng{ 42 };
+    bench::Reporter out{ format };
+
+    out.begin();
+    for ( size_t n{10} ; n <= max_n ; n *= 10 )
+    {
+        bench_container< sc::list<int> >( out, "sc::list", n, rng );
+        bench_container< std::list<int> >( out, "std::list", n, rng );
+        bench_sort( out, n, rng );
+        bench_radix( out, n, rng );
+        bench_select( out, n, rng );
+        bench_find( out, n );
+        bench_compare( out, n );
+        bench_unrolled( out, n );
+        bench_indexed( out, n, rng );
+        bench_size_policy( out, n );
+        bench_sorted( out, n, rng );
+    }
+    for ( size_t n{ max_n * 10 } ; n <= sort_max_n ; n *= 10 )
+        bench_radix( out, n, rng );
+    bench_cache( out, std::min< size_t >( max_n, 1000000 ), rng );
+    bench_zipf( out, std::min< size_t >( max_n, 1000000 ), rng );
+    bench_concurrent( out, std::min< size_t >( max_n, 1u << 18 ) );
+    out.end();
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+#ifndef _CONCURRENT_LIST_H_
+#define _CONCURRENT_LIST_H_
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <cstddef>   // std::size_t
+#include <memory>    // std::allocator
+#include <mutex>
+#include <utility>   // std::forward, std::move
+
+#include "list.h"
+
+namespace sc {
+    /*!
+     * A doubly linked list shared by several threads, which push and pop at both ends.
+     *
+     * As in the two-lock queue of Michael and Scott, each end has its own sentinel
+     * and its own lock, so producers at the back never wait for consumers at the
+     * front, nor the other way round. The ends only meet when the list is nearly
+     * empty: an operation that could touch a node also touched from the other end
+     * takes both locks instead. An atomic count of the nodes tells the two cases apart.
+     *
+     * The nodes are those of `sc::list<T, Alloc>`: splice_out() detaches a batch of
+     * them from the front under a single lock and hands it over as an `sc::list`,
+     * with no element copied and no node reallocated.
+     *
+     * \note
+     * Nodes are allocated and released outside the locks, by whichever thread pushes
+     * or pops, so the allocator must be safe to use from several threads at once
+     * (std::allocator is). The two ends are aligned to separate cache lines; before
+     * C++17, `new` does not honour that alignment, so keep the list on the stack, in
+     * static storage or as a member.
+     */
+    template < typename T, typename Alloc = std::allocator<T> >
+    class concurrent_list
+    {
+        private:
+        using list_type = sc::list<T, Alloc>;
+        using NodeBase = sc::list_hook;
+        using Node = typename list_type::Node;
+        using node_allocator_type = typename list_type::node_allocator_type;
+        using node_traits = typename list_type::node_traits;
+        using algorithms = typename list_type::algorithms;
+
+        //=== Private members.
+        private:
+            static constexpr std::size_t cache_line = 64;
+
+            // Cada extremidade tem o seu sentinela e o seu lock, em linhas de cache distintas.
+            alignas(cache_line) NodeBase m_head;    // sentinela da frente: next é o primeiro nó.
+            std::mutex m_head_lock;                 // protege a frente.
+            alignas(cache_line) NodeBase m_tail;    // sentinela do fim: prev é o último nó.
+            std::mutex m_tail_lock;                 // protege o fim.
+            alignas(cache_line) std::atomic< std::size_t > m_count; // nós ligados, menos os já reservados para remoção.
+            node_allocator_type m_alloc;    // alocador dos nós (o mesmo de sc::list).
+
+            /// Allocates a data node and constructs its element in place from 'args_'.
+            template < typename... Args >
+            NodeBase * create_node( Args&&... args_ )
+            {
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                try {
+                    node_traits::construct( m_alloc, node, std::forward<Args>( args_ )... );
+                }
+                catch (...) {
+                    node_traits::deallocate( m_alloc, node, 1 );
+                    throw;
+                }
+                return node;
+            }
+
+            /// Destroys and deallocates a data node through the node allocator, as sc::list does.
+            void destroy_node( NodeBase * node_ ) { list_type::release_node( m_alloc, static_cast< Node * >( node_ ) ); }
+
+            /*! Takes 'count_' nodes off the count if at least two are left, so that one end may
+             *  unlink them holding its own lock only: the nodes it touches are then out of reach
+             *  of the other end. Pushes at the other end only add nodes, and the slow paths hold
+             *  both locks.
+             */
+            bool reserve( std::size_t count_ )
+            {
+                std::size_t count = m_count.load();
+                while (count >= 2 and count - 2 >= count_)     // Sem 'count_ + 2', que estoura.
+                    if (m_count.compare_exchange_weak( count, count - count_ )) return true;
+                return false;
+            }
+
+            /// Links 'node_' at the back (or at the front), taking both locks if the list is empty.
+            void push_node( NodeBase * node_, bool back_ )
+            {
+                {
+                    std::lock_guard< std::mutex > guard( back_ ? m_tail_lock : m_head_lock );
+                    // Com ao menos um nó, o outro lado nunca toca os mesmos links.
+                    if (m_count.load() > 0) {
+                        algorithms::link_before( back_ ? &m_tail : m_head.next, node_ );
+                        ++m_count;
+                        return;
+                    }
+                }
+                std::lock_guard< std::mutex > head( m_head_lock );
+                std::lock_guard< std::mutex > tail( m_tail_lock );
+                algorithms::link_before( back_ ? &m_tail : m_head.next, node_ );
+                ++m_count;
+            }
+
+            /// Unlinks the node at the back (or at the front), taking both locks if few are left; returns nullptr if there is none.
+            NodeBase * pop_node( bool back_ )
+            {
+                {
+                    std::lock_guard< std::mutex > guard( back_ ? m_tail_lock : m_head_lock );
+                    if (reserve( 1 )) return unlink( back_ ? m_tail.prev : m_head.next );
+                }
+                std::lock_guard< std::mutex > head( m_head_lock );
+                std::lock_guard< std::mutex > tail( m_tail_lock );
+                if (m_count.load() == 0) return nullptr;
+                --m_count;
+                return unlink( back_ ? m_tail.prev : m_head.next );
+            }
+
+            static NodeBase * unlink( NodeBase * node_ )
+            {
+                algorithms::unlink( node_ );
+                return node_;
+            }
+
+            /// Unlinks the first 'count_' nodes as the chain [first_, last_].
+            void detach_front( std::size_t count_, NodeBase *& first_, NodeBase *& last_ )
+            {
+                first_ = last_ = m_head.next;
+                for (std::size_t i{1}; i < count_; ++i) last_ = last_->next;
+                m_head.next = last_->next;
+                (last_->next)->prev = &m_head;
+            }
+
+            /// Moves the element of 'node_' into 'value_' and releases the node (even if the move throws).
+            void take( NodeBase * node_, T & value_ )
+            {
+                try {
+                    value_ = std::move( static_cast< Node * >( node_ )->data );
+                }
+                catch (...) { destroy_node( node_ ); throw; }
+                destroy_node( node_ );
+            }
+
+        public:
+            using value_type     = T;
+            using allocator_type = Alloc;
+            using size_type      = std::size_t;
+
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty list.
+        concurrent_list() : concurrent_list( Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty list that draws its nodes from 'alloc_'.
+        explicit concurrent_list( const Alloc & alloc_ ) : m_count{ 0 }, m_alloc{ alloc_ }
+        {
+            m_head.next = &m_tail;
+            m_tail.prev = &m_head;
+        }
+
+        ///* (2) A list shared by threads is neither copied nor moved.
+        concurrent_list( const concurrent_list & ) = delete;
+        concurrent_list & operator=( const concurrent_list & ) = delete;
+
+        ///* (3) Destructs the list. No other thread may be using it.
+        ~concurrent_list() { clear(); }
+
+        ///* Returns a copy of the allocator associated with the list.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        //!=== [II] Capacity/Status
+        ///* Number of elements; only a snapshot while other threads are pushing or popping.
+        size_type size( void ) const { return m_count.load(); }
+
+        ///* Check if the list is empty (a snapshot, as size()).
+        bool empty( void ) const { return size() == 0; }
+
+        //!=== [III] Modifiers
+        ///* Removes all elements, holding both locks while they are unlinked.
+        void clear( void )
+        {
+            NodeBase * node;
+            {
+                std::lock_guard< std::mutex > head( m_head_lock );
+                std::lock_guard< std::mutex > tail( m_tail_lock );
+                node = m_head.next;             // A cadeia desligada ainda termina em m_tail.
+                m_head.next = &m_tail;
+                m_tail.prev = &m_head;
+                m_count = 0;
+            }
+            // Os nós são liberados fora dos locks.
+            while (node != &m_tail) {
+                NodeBase * next = node->next;
+                destroy_node( node );
+                node = next;
+            }
+        }
+
+        ///* Constructs an element in place at the end of the list.
+        template < typename... Args >
+        void emplace_back( Args&&... args_ ) { push_node( create_node( std::forward<Args>( args_ )... ), true ); }
+
+        ///* Constructs an element in place at the front of the list.
+        template < typename... Args >
+        void emplace_front( Args&&... args_ ) { push_node( create_node( std::forward<Args>( args_ )... ), false ); }
+
+        ///* Adds 'value_' to the end of the list.
+        void push_back( const T & value_ ) { this->emplace_back( value_ ); }
+        void push_back( T && value_ ) { this->emplace_back( std::move( value_ ) ); }
+
+        ///* Adds 'value_' to the front of the list.
+        void push_front( const T & value_ ) { this->emplace_front( value_ ); }
+        void push_front( T && value_ ) { this->emplace_front( std::move( value_ ) ); }
+
+        /*! Removes the first element, moving it into 'value_'.
+         *  @return false (and 'value_' untouched) if the list was empty.
+         */
+        bool try_pop_front( T & value_ )
+        {
+            NodeBase * node = pop_node( false );
+            if (node == nullptr) return false;
+            take( node, value_ );
+            return true;
+        }
+
+        /*! Removes the last element, moving it into 'value_'.
+         *  @return false (and 'value_' untouched) if the list was empty.
+         */
+        bool try_pop_back( T & value_ )
+        {
+            NodeBase * node = pop_node( true );
+            if (node == nullptr) return false;
+            take( node, value_ );
+            return true;
+        }
+
+        /*! Detaches up to 'count_' elements from the front in a single locked operation and
+         *  returns them, in order, as an sc::list (empty if there were none). The nodes are
+         *  relinked, not copied; walking to the last of them is the only O(count_) work
+         *  done under the lock.
+         */
+        list_type splice_out( size_type count_ )
+        {
+            list_type batch( get_allocator() );
+            if (count_ == 0) return batch;
+            NodeBase * first{ nullptr }, * last{ nullptr };
+            size_type taken{ count_ };
+            {
+                std::lock_guard< std::mutex > guard( m_head_lock );
+                if (reserve( count_ )) detach_front( count_, first, last );
+            }
+            if (first == nullptr) {
+                std::lock_guard< std::mutex > head( m_head_lock );
+                std::lock_guard< std::mutex > tail( m_tail_lock );
+                taken = std::min( count_, m_count.load() );
+                if (taken == 0) return batch;
+                m_count -= taken;
+                detach_front( taken, first, last );
+            }
+            batch.append_chain( first, last, taken );
+            return batch;
+        }
+    };
+}
+#endif
@@ -0,0 +1,168 @@
+#ifndef _EXECUTION_H_
+#define _EXECUTION_H_
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>   // std::size_t
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace sc {
+    namespace detail {
+        /*!
+         * The threads behind sc::execution::parallel_for(), started on first use and kept
+         * until the program ends, so that a parallel call wakes threads instead of creating them.
+         *
+         * One call runs at a time: a call made while the pool is busy (from another thread,
+         * or from inside a running job) runs on the calling thread alone.
+         */
+        class thread_pool
+        {
+            private:
+                std::atomic< bool > m_busy{ false };    // uma chamada está usando o pool.
+                std::mutex m_mutex;                     // protege os campos abaixo.
+                std::condition_variable m_wake;         // há vagas no trabalho atual, ou o pool vai parar.
+                std::condition_variable m_idle;         // uma thread terminou sua parte.
+                std::vector< std::thread > m_threads;
+                std::size_t m_slots = 0;                // threads que ainda podem entrar no trabalho atual.
+                std::size_t m_running = 0;              // threads dentro do trabalho atual.
+                bool m_stop = false;
+                // O trabalho atual.
+                std::atomic< std::size_t > m_next{ 0 };
+                std::size_t m_count = 0;
+                void (*m_call)( void *, std::size_t ) = nullptr;
+                void * m_fn = nullptr;
+
+                void work( void ) noexcept
+                {
+                    for ( std::size_t i = m_next++ ; i < m_count ; i = m_next++ )
+                        m_call( m_fn, i );
+                }
+
+                void loop( void )
+                {
+                    std::unique_lock< std::mutex > lock( m_mutex );
+                    while ( true ) {
+                        m_wake.wait( lock, [this]{ return m_stop or m_slots > 0; } );
+                        if ( m_stop ) return;
+                        --m_slots;
+                        ++m_running;
+                        lock.unlock();
+                        work();
+                        lock.lock();
+                        if ( --m_running == 0 ) m_idle.notify_one();
+                    }
+                }
+
+                /// Starts threads until there are 'n_' of them, or until the system refuses one.
+                void grow( std::size_t n_ )
+                {
+                    try {
+                        while ( m_threads.size() < n_ )
+                            m_threads.emplace_back( &thread_pool::loop, this );
+                    }
+                    catch ( const std::system_error & ) { /* Segue com as threads que já existem. */ }
+                }
+
+                thread_pool() = default;
+
+            public:
+                thread_pool( const thread_pool & ) = delete;
+                thread_pool & operator=( const thread_pool & ) = delete;
+
+                ~thread_pool()
+                {
+                    {
+                        std::lock_guard< std::mutex > lock( m_mutex );
+                        m_stop = true;
+                    }
+                    m_wake.notify_all();
+                    for ( auto & t : m_threads ) t.join();
+                }
+
+                static thread_pool & instance( void )
+                {
+                    static thread_pool pool;
+                    return pool;
+                }
+
+                /// Calls 'call_( fn_, i )' for every 'i' in [0, count_) on up to 'threads_' threads, the caller included.
+                void run( std::size_t count_, std::size_t threads_, void (*call_)( void *, std::size_t ), void * fn_ )
+                {
+                    if ( threads_ <= 1 or m_busy.exchange( true, std::memory_order_acquire ) ) {
+                        for ( std::size_t i{0} ; i < count_ ; ++i ) call_( fn_, i );
+                        return;
+                    }
+                    grow( threads_ - 1 );
+                    std::unique_lock< std::mutex > lock( m_mutex );
+                    m_next = 0;
+                    m_count = count_;
+                    m_call = call_;
+                    m_fn = fn_;
+                    m_slots = std::min( threads_ - 1, m_threads.size() );
+                    lock.unlock();
+                    m_wake.notify_all();
+                    work();
+                    lock.lock();
+                    m_slots = 0;                        // Todos os índices já foram tomados: ninguém mais entra.
+                    m_idle.wait( lock, [this]{ return m_running == 0; } );
+                    m_busy.store( false, std::memory_order_release );
+                }
+        };
+    }
+
+    /*!
+     * Execution policies accepted by the parallel overloads of the containers,
+     * modeled after (but independent of) the C++17 `std::execution` policies.
+     *
+     * \note
+     * As in the standard parallel algorithms, if a user-supplied function
+     * (a comparator, for instance) throws while running under `par`,
+     * `std::terminate()` is called.
+     */
+    namespace execution {
+        /// Requests that the operation runs on the calling thread only.
+        struct sequenced_policy { };
+
+        /// Requests that the operation runs on several threads.
+        struct parallel_policy
+        {
+            unsigned threads; //!< Maximum number of threads; 0 means one per hardware thread.
+
+            /// Returns a policy limited to `n` threads.
+            constexpr parallel_policy with_threads( unsigned n ) const { return parallel_policy{ n }; }
+
+            /// Returns the number of threads the operation may use (at least 1).
+            unsigned concurrency( void ) const
+            {
+                if ( threads != 0 ) return threads;
+                unsigned hw = std::thread::hardware_concurrency();
+                return hw != 0 ? hw : 1;
+            }
+        };
+
+        constexpr sequenced_policy seq{};   //!< Sequential execution.
+        constexpr parallel_policy par{ 0 }; //!< Parallel execution on every hardware thread.
+
+        /*!
+         * Calls `f(i)` for every `i` in [0, count), distributing the indices among
+         * up to `threads` threads; the calling thread is one of them.
+         * Returns when every call has finished.
+         *
+         * The other threads come from a pool kept between calls (see sc::detail::thread_pool).
+         * If the system cannot start as many threads as requested, the calls run on the
+         * threads there are; if the pool is busy, they all run on the calling thread.
+         */
+        template < typename Function >
+        void parallel_for( std::size_t count, unsigned threads, Function f )
+        {
+            std::size_t n_threads = threads < count ? threads : count;
+            auto call = []( void * fn, std::size_t i ) { ( *static_cast< Function * >( fn ) )( i ); };
+            sc::detail::thread_pool::instance().run( count, n_threads, call, &f );
+        }
+    }
+}
+#endif
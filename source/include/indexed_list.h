@@ -0,0 +1,831 @@
+#ifndef _INDEXED_LIST_H_
+#define _INDEXED_LIST_H_
+
+#include <algorithm>  // std::equal
+#include <cstddef>    // std::ptrdiff_t, std::size_t
+#include <cstdint>    // std::uint32_t
+#include <functional> // std::less, std::equal_to
+#include <initializer_list>
+#include <iterator>   // random_access_iterator_tag
+#include <memory>     // std::allocator, std::allocator_traits
+#include <stdexcept>  // std::length_error, std::out_of_range
+#include <utility>    // std::forward, std::move, std::swap
+
+#include "list_hook.h"
+
+namespace sc {
+    /*!
+     * A doubly linked list that also knows the position of each of its elements.
+     *
+     * Besides the links of `sc::list`, every node sits in an order-statistic tree:
+     * a treap ordered by position, where each node counts the nodes of its subtree.
+     * Traversal still follows the links, but at(), index_of(), the distance between
+     * two iterators and long jumps take O(log n) instead of O(n), and so do insert(),
+     * erase() and the splice() of a whole list or of a range. sort(), merge() and
+     * unique() relink the nodes with the algorithms of `sc::list` and then rebuild
+     * the tree in O(n).
+     *
+     * The iterators are random access in interface (each jump or difference is
+     * O(log n)), so std::distance() and std::advance() take the fast path.
+     *
+     * \note
+     * Every node carries three more pointers, a count and a priority: use it only
+     * when positions are needed; `sc::list` is the lighter choice otherwise.
+     */
+    template < typename T, typename Alloc = std::allocator<T> >
+    class indexed_list
+    {
+        private:
+        //=== the links of a node, in the list and in the tree (also used, alone, by the sentinel).
+        struct NodeBase : sc::list_hook
+        {
+            NodeBase * parent;      //!< Parent in the tree; for the sentinel, the root.
+            NodeBase * left;        //!< Subtree of the nodes that come before this one.
+            NodeBase * right;       //!< Subtree of the nodes that come after this one.
+            std::size_t count;      //!< Nodes in the subtree rooted here (0 only for the sentinel).
+            std::uint32_t priority; //!< Heap key of the treap: no child has a higher one.
+
+            NodeBase() : sc::list_hook{}, parent{ nullptr }, left{ nullptr }, right{ nullptr }, count{ 0 }, priority{ 0 }
+            { /* empty */ }
+        };
+
+        //=== the data node.
+        struct Node : NodeBase
+        {
+            T data;
+
+            /// Constructs 'data' in place from 'args', with null links.
+            template < typename... Args >
+            explicit Node( Args&&... args ) : NodeBase{}, data( std::forward<Args>( args )... )
+            { /* empty */ }
+        };
+
+        static NodeBase * base_of( sc::list_hook * hook_ ) { return static_cast< NodeBase * >( hook_ ); }
+
+        /// Accesses the element of a data node (never of the sentinel).
+        static T & data_of( sc::list_hook * node_ ) { return static_cast< Node * >( base_of( node_ ) )->data; }
+
+        /// Maps a node to its element for the relinking algorithms shared with sc::list.
+        struct value_traits
+        {
+            using value_type = T;
+            static T & value_of( sc::list_hook * node_ ) { return data_of( node_ ); }
+        };
+        using algorithms = sc::detail::list_algorithms< value_traits >;
+
+        /// Nodes are drawn from the client allocator, rebound to Node.
+        using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+
+        /// Jumps of up to this many positions follow the links instead of the tree.
+        static constexpr std::ptrdiff_t short_jump = 8;
+
+        //=== Order-statistic tree (the nodes in the order of the list, each counting its subtree).
+        static std::size_t count_of( const NodeBase * node_ ) { return node_ == nullptr ? 0 : node_->count; }
+        static bool is_sentinel( const NodeBase * node_ ) { return node_->count == 0; }
+        static void update( NodeBase * node_ ) { node_->count = count_of( node_->left ) + count_of( node_->right ) + 1; }
+
+        /// Returns the sentinel of the list holding 'node_' and stores in 'rank_' its position (the size, for the sentinel).
+        static NodeBase * locate( NodeBase * node_, std::size_t & rank_ )
+        {
+            if (is_sentinel( node_ )) { rank_ = count_of( node_->parent ); return node_; }
+            rank_ = count_of( node_->left );
+            for ( ; not is_sentinel( node_->parent ); node_ = node_->parent)
+                if (node_ == node_->parent->right) rank_ += count_of( node_->parent->left ) + 1;
+            return node_->parent;
+        }
+
+        /// Position of 'node_' in its list, in O(log n).
+        static std::size_t rank_of( NodeBase * node_ ) { std::size_t rank; locate( node_, rank ); return rank; }
+
+        /// The node at position 'rank_' (the sentinel, for a position past the last node), in O(log n).
+        static NodeBase * select( NodeBase * sentinel_, std::size_t rank_ )
+        {
+            NodeBase * node = sentinel_->parent;
+            if (rank_ >= count_of( node )) return sentinel_;
+            while (true) {
+                std::size_t left = count_of( node->left );
+                if (rank_ < left) node = node->left;
+                else if (rank_ == left) return node;
+                else { rank_ -= left + 1; node = node->right; }
+            }
+        }
+
+        /// The node 'step_' positions away from 'node_'.
+        static NodeBase * jump( NodeBase * node_, std::ptrdiff_t step_ )
+        {
+            if (-short_jump <= step_ and step_ <= short_jump) {
+                for ( ; step_ > 0; --step_) node_ = base_of( node_->next );
+                for ( ; step_ < 0; ++step_) node_ = base_of( node_->prev );
+                return node_;
+            }
+            std::size_t rank;
+            NodeBase * sentinel = locate( node_, rank );
+            return select( sentinel, rank + step_ );
+        }
+
+        /// Makes 'child_' take the place of 'old_' under 'parent_' (as the root, if 'parent_' is the sentinel).
+        static void replace_child( NodeBase * parent_, NodeBase * old_, NodeBase * child_ )
+        {
+            if (is_sentinel( parent_ )) parent_->parent = child_;
+            else if (parent_->left == old_) parent_->left = child_;
+            else parent_->right = child_;
+            if (child_ != nullptr) child_->parent = parent_;
+        }
+
+        /// Rotates 'node_' above its parent, keeping the order of the nodes.
+        static void rotate_up( NodeBase * node_ )
+        {
+            NodeBase * parent = node_->parent;
+            replace_child( parent->parent, parent, node_ );
+            if (node_ == parent->left) {
+                parent->left = node_->right;
+                if (parent->left != nullptr) parent->left->parent = parent;
+                node_->right = parent;
+            }
+            else {
+                parent->right = node_->left;
+                if (parent->right != nullptr) parent->right->parent = parent;
+                node_->left = parent;
+            }
+            parent->parent = node_;
+            update( parent );
+            update( node_ );
+        }
+
+        /// Takes 'node_' out of the tree (its list links are left untouched).
+        static void tree_erase( NodeBase * node_ )
+        {
+            // Desce o nó, pelo filho de maior prioridade, até virar folha.
+            while (node_->left != nullptr or node_->right != nullptr) {
+                NodeBase * child = node_->left == nullptr ? node_->right
+                                 : node_->right == nullptr ? node_->left
+                                 : node_->left->priority > node_->right->priority ? node_->left : node_->right;
+                rotate_up( child );
+            }
+            NodeBase * parent = node_->parent;
+            replace_child( parent, node_, nullptr );
+            for ( ; not is_sentinel( parent ); parent = parent->parent) --parent->count;
+        }
+
+        /// Splits the subtree 'root_' into its first 'rank_' nodes and the others (the parents of both roots are left stale).
+        static void split( NodeBase * root_, std::size_t rank_, NodeBase *& first_, NodeBase *& rest_ )
+        {
+            if (root_ == nullptr) { first_ = rest_ = nullptr; return; }
+            if (rank_ <= count_of( root_->left )) {
+                split( root_->left, rank_, first_, root_->left );
+                if (root_->left != nullptr) root_->left->parent = root_;
+                rest_ = root_;
+            }
+            else {
+                split( root_->right, rank_ - count_of( root_->left ) - 1, root_->right, rest_ );
+                if (root_->right != nullptr) root_->right->parent = root_;
+                first_ = root_;
+            }
+            update( root_ );
+        }
+
+        /// Joins two subtrees, every node of 'first_' coming before every node of 'rest_'.
+        static NodeBase * join( NodeBase * first_, NodeBase * rest_ )
+        {
+            if (first_ == nullptr) return rest_;
+            if (rest_ == nullptr) return first_;
+            if (first_->priority > rest_->priority) {
+                first_->right = join( first_->right, rest_ );
+                first_->right->parent = first_;
+                update( first_ );
+                return first_;
+            }
+            rest_->left = join( first_, rest_->left );
+            rest_->left->parent = rest_;
+            update( rest_ );
+            return rest_;
+        }
+
+        /// Moves the priority of 'node_' down until no child has a higher one (the shape of the tree is kept).
+        static void sift_down( NodeBase * node_ )
+        {
+            while (true) {
+                NodeBase * top = node_;
+                if (node_->left != nullptr and node_->left->priority > top->priority) top = node_->left;
+                if (node_->right != nullptr and node_->right->priority > top->priority) top = node_->right;
+                if (top == node_) return;
+                std::swap( top->priority, node_->priority );
+                node_ = top;
+            }
+        }
+
+        //=== Private members.
+        private:
+            NodeBase m_sentinel;          // sentinela: next/prev ligam a lista; parent é a raiz da árvore.
+            node_allocator_type m_alloc;  // alocador dos nós de dados.
+            std::uint32_t m_seed = 2463534242u; // estado do gerador das prioridades (xorshift).
+
+            NodeBase * sentinel( void ) const { return const_cast< NodeBase * >( &m_sentinel ); }
+
+            void set_root( NodeBase * root_ )
+            {
+                sentinel()->parent = root_;
+                if (root_ != nullptr) root_->parent = sentinel();
+            }
+
+            std::uint32_t next_priority( void )
+            {
+                m_seed ^= m_seed << 13;
+                m_seed ^= m_seed >> 17;
+                m_seed ^= m_seed << 5;
+                return m_seed;
+            }
+
+            /// Puts 'node_', already linked into the list, in the tree at the same position, in O(log n).
+            void tree_insert( NodeBase * node_ )
+            {
+                node_->left = node_->right = nullptr;
+                node_->count = 1;
+                node_->priority = next_priority();
+                NodeBase * pos = base_of( node_->next );
+                if (sentinel()->parent == nullptr) { set_root( node_ ); return; }
+                // O novo nó é o sucessor em ordem do seu antecessor na lista, que não tem filho à direita,
+                // ou então o filho à esquerda do nó seguinte.
+                if (not is_sentinel( pos ) and pos->left == nullptr) { pos->left = node_; node_->parent = pos; }
+                else { NodeBase * prev = base_of( node_->prev ); prev->right = node_; node_->parent = prev; }
+                for (NodeBase * up = node_->parent; not is_sentinel( up ); up = up->parent) ++up->count;
+                while (not is_sentinel( node_->parent ) and node_->parent->priority < node_->priority)
+                    rotate_up( node_ );
+            }
+
+            /// Rebuilds the tree, balanced, from the 'count_' nodes of the list, in O(n).
+            void rebuild( std::size_t count_ )
+            {
+                sc::list_hook * first = sentinel()->next;
+                set_root( build( first, count_ ) );
+            }
+
+            /// Builds a balanced subtree with the 'count_' nodes from 'first_' on; 'first_' is left past them.
+            NodeBase * build( sc::list_hook *& first_, std::size_t count_ )
+            {
+                if (count_ == 0) return nullptr;
+                NodeBase * left = build( first_, count_ / 2 );
+                NodeBase * root = base_of( first_ );
+                first_ = first_->next;
+                NodeBase * right = build( first_, count_ - count_ / 2 - 1 );
+                root->left = left;
+                root->right = right;
+                if (left != nullptr) left->parent = root;
+                if (right != nullptr) right->parent = root;
+                root->count = count_;
+                root->priority = next_priority();
+                sift_down( root );
+                return root;
+            }
+
+            /// Allocates a data node and constructs its element in place from 'args_'.
+            template < typename... Args >
+            NodeBase * create_node( Args&&... args_ )
+            {
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                try {
+                    node_traits::construct( m_alloc, node, std::forward<Args>( args_ )... );
+                }
+                catch (...) {
+                    node_traits::deallocate( m_alloc, node, 1 );
+                    throw;
+                }
+                return node;
+            }
+
+            /// Destroys and deallocates a data node through the node allocator.
+            void destroy_node( sc::list_hook * node_ )
+            {
+                Node * node = static_cast< Node * >( base_of( node_ ) );
+                node_traits::destroy( m_alloc, node );
+                node_traits::deallocate( m_alloc, node, 1 );
+            }
+
+            /// Links the elements of [first_, last_) at the end and rebuilds the tree once (used by the constructors).
+            template < typename InputIt >
+            void append_range( InputIt first_, InputIt last_ )
+            {
+                std::size_t count = size();
+                for ( ; first_ != last_; ++first_, ++count)
+                    algorithms::link_before( sentinel(), create_node( *first_ ) );
+                rebuild( count );
+            }
+
+            /// Exchanges the nodes (and trees) of two lists.
+            void swap_nodes( indexed_list & other_ ) noexcept
+            {
+                algorithms::swap_nodes( sentinel(), other_.sentinel() );
+                NodeBase * root = sentinel()->parent;
+                set_root( other_.sentinel()->parent );
+                other_.set_root( root );
+            }
+
+        public:
+            using value_type      = T;
+            using allocator_type  = Alloc;
+            using size_type       = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference       = T &;
+            using const_reference = const T &;
+
+        //=== The iterator classes.
+        public:
+        class const_iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = const T *;
+                using reference         = const T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::random_access_iterator_tag;
+
+            private:
+                NodeBase * m_ptr; //!< The node of the element (the sentinel for end()).
+
+            public:
+                const_iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                reference operator*() const { return data_of(m_ptr); }
+                pointer operator->() const { return &data_of(m_ptr); }
+                reference operator[]( difference_type n ) const { return data_of( jump( m_ptr, n ) ); }
+
+                const_iterator & operator++() { m_ptr = base_of( m_ptr->next ); return *this; }
+                const_iterator operator++(int) { const_iterator retval{m_ptr}; ++*this; return retval; }
+                const_iterator & operator--() { m_ptr = base_of( m_ptr->prev ); return *this; }
+                const_iterator operator--(int) { const_iterator retval{m_ptr}; --*this; return retval; }
+
+                /// Jumps 'step' positions (back, if negative): short jumps follow the links, long ones take O(log n).
+                const_iterator & operator+=( difference_type step ) { m_ptr = jump( m_ptr, step ); return *this; }
+                const_iterator & operator-=( difference_type step ) { m_ptr = jump( m_ptr, -step ); return *this; }
+                friend const_iterator operator+( const_iterator it, difference_type step ) { return it += step; }
+                friend const_iterator operator+( difference_type step, const_iterator it ) { return it += step; }
+                friend const_iterator operator-( const_iterator it, difference_type step ) { return it -= step; }
+
+                /// it1 - it2, in O(log n), whichever comes first.
+                difference_type operator-( const const_iterator & rhs ) const
+                { return static_cast< difference_type >( rank_of( m_ptr ) ) - static_cast< difference_type >( rank_of( rhs.m_ptr ) ); }
+
+                bool operator==( const const_iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const const_iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+                bool operator<( const const_iterator & rhs ) const { return rank_of( m_ptr ) < rank_of( rhs.m_ptr ); }
+                bool operator>( const const_iterator & rhs ) const { return rhs < *this; }
+                bool operator<=( const const_iterator & rhs ) const { return not (rhs < *this); }
+                bool operator>=( const const_iterator & rhs ) const { return not (*this < rhs); }
+
+                // We need friendship so the list class may access the m_ptr field.
+                friend class indexed_list;
+        };
+
+        class iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = T *;
+                using reference         = T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::random_access_iterator_tag;
+
+            private:
+                NodeBase * m_ptr; //!< The node of the element (the sentinel for end()).
+
+            public:
+                iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                /// Every iterator may be used where a const_iterator is expected.
+                operator const_iterator() const { return const_iterator{ m_ptr }; }
+
+                reference operator*() const { return data_of(m_ptr); }
+                pointer operator->() const { return &data_of(m_ptr); }
+                reference operator[]( difference_type n ) const { return data_of( jump( m_ptr, n ) ); }
+
+                iterator & operator++() { m_ptr = base_of( m_ptr->next ); return *this; }
+                iterator operator++(int) { iterator retval{m_ptr}; ++*this; return retval; }
+                iterator & operator--() { m_ptr = base_of( m_ptr->prev ); return *this; }
+                iterator operator--(int) { iterator retval{m_ptr}; --*this; return retval; }
+
+                /// Jumps 'step' positions (back, if negative): short jumps follow the links, long ones take O(log n).
+                iterator & operator+=( difference_type step ) { m_ptr = jump( m_ptr, step ); return *this; }
+                iterator & operator-=( difference_type step ) { m_ptr = jump( m_ptr, -step ); return *this; }
+                friend iterator operator+( iterator it, difference_type step ) { return it += step; }
+                friend iterator operator+( difference_type step, iterator it ) { return it += step; }
+                friend iterator operator-( iterator it, difference_type step ) { return it -= step; }
+
+                /// it1 - it2, in O(log n), whichever comes first.
+                difference_type operator-( const iterator & rhs ) const
+                { return static_cast< difference_type >( rank_of( m_ptr ) ) - static_cast< difference_type >( rank_of( rhs.m_ptr ) ); }
+
+                bool operator==( const iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+                bool operator<( const iterator & rhs ) const { return rank_of( m_ptr ) < rank_of( rhs.m_ptr ); }
+                bool operator>( const iterator & rhs ) const { return rhs < *this; }
+                bool operator<=( const iterator & rhs ) const { return not (rhs < *this); }
+                bool operator>=( const iterator & rhs ) const { return not (*this < rhs); }
+
+                // We need friendship so the list class may access the m_ptr field.
+                friend class indexed_list;
+        };
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty list.
+        indexed_list() : indexed_list( Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty list that draws its nodes from 'alloc_'.
+        explicit indexed_list( const Alloc & alloc_ ) noexcept : m_alloc{ alloc_ }
+        { algorithms::reset( sentinel() ); }
+
+        ///* (2) Constructs the list with 'count_' copies of 'value_'.
+        indexed_list( size_type count_, const T & value_, const Alloc & alloc_ = Alloc() ) : indexed_list( alloc_ )
+        {
+            try {
+                for (size_type i{0}; i < count_; ++i) algorithms::link_before( sentinel(), create_node( value_ ) );
+            }
+            catch (...) { clear(); throw; }
+            rebuild( count_ );
+        }
+
+        ///* (3) Constructs the list with the contents of the range [first, last).
+        template < typename InputIt >
+        indexed_list( InputIt first, InputIt last, const Alloc & alloc_ = Alloc() ) : indexed_list( alloc_ )
+        {
+            try {
+                append_range( first, last );
+            }
+            catch (...) { clear(); throw; }
+        }
+
+        ///* (4) Copy constructor.
+        indexed_list( const indexed_list & clone_ )
+            : indexed_list( clone_.cbegin(), clone_.cend(), node_traits::select_on_container_copy_construction( clone_.m_alloc ) )
+        { /* empty */ }
+
+        ///* (5) Constructs the list with the contents of the initializer list 'ilist_'.
+        indexed_list( std::initializer_list<T> ilist_, const Alloc & alloc_ = Alloc() )
+            : indexed_list( ilist_.begin(), ilist_.end(), alloc_ )
+        { /* empty */ }
+
+        ///* (4a) Move constructor. Takes over the nodes of 'other' in O(1); 'other' is left empty.
+        indexed_list( indexed_list && other ) noexcept : indexed_list( Alloc( other.m_alloc ) )
+        { this->swap_nodes( other ); }
+
+        ///* (6) Destructs the list.
+        ~indexed_list() { clear(); }
+
+        ///* (7) Copy assignment operator. The existing nodes are overwritten in place (see assign()).
+        indexed_list & operator=( const indexed_list & rhs )
+        {
+            if (this != &rhs) {
+                // Some allocators must follow the contents: nodes from the old one cannot be kept.
+                if (node_traits::propagate_on_container_copy_assignment::value) {
+                    if (m_alloc != rhs.m_alloc) this->clear();
+                    m_alloc = rhs.m_alloc;
+                }
+                this->assign( rhs.cbegin(), rhs.cend() );
+            }
+            return *this;
+        }
+
+        ///* (7a) Move assignment operator. Takes over the nodes of 'rhs', which is left empty.
+        ///* If the allocators differ and do not propagate, the elements are moved one by one.
+        indexed_list & operator=( indexed_list && rhs ) noexcept( node_traits::propagate_on_container_move_assignment::value )
+        {
+            if (this != &rhs) {
+                this->clear();
+                if (node_traits::propagate_on_container_move_assignment::value or m_alloc == rhs.m_alloc) {
+                    if (node_traits::propagate_on_container_move_assignment::value)
+                        m_alloc = std::move(rhs.m_alloc);
+                    this->swap_nodes( rhs );            // Troca em O(1): this está vazia.
+                }
+                else {
+                    this->assign( std::make_move_iterator( rhs.begin() ), std::make_move_iterator( rhs.end() ) );
+                    rhs.clear();
+                }
+            }
+            return *this;
+        }
+
+        ///* (8) Replaces the contents with those identified by initializer list 'ilist_'.
+        indexed_list & operator=( std::initializer_list<T> ilist_ )
+        {
+            this->assign( ilist_.begin(), ilist_.end() );
+            return *this;
+        }
+
+        ///* Returns a copy of the allocator associated with the list.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        //!=== [II] ITERATORS
+        iterator begin() { return iterator{ base_of( sentinel()->next ) }; }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return const_iterator{ base_of( sentinel()->next ) }; }
+        iterator end() { return iterator{ sentinel() }; }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator{ sentinel() }; }
+
+        //!=== [III] Capacity/Status and element access
+        ///* Check if the list is empty, that is, there are no elements.
+        bool empty( void ) const { return sentinel()->parent == nullptr; }
+
+        ///* Check the size of the list (kept by the root of the tree).
+        size_type size( void ) const { return count_of( sentinel()->parent ); }
+
+        ///* Returns the element at position 'pos_', in O(log n); throws std::out_of_range if there is none.
+        T & at( size_type pos_ )
+        {
+            if (pos_ >= size())
+                throw std::out_of_range("[indexed_list::at()]: position out of range.");
+            return data_of( select( sentinel(), pos_ ) );
+        }
+        const T & at( size_type pos_ ) const { return const_cast< indexed_list * >( this )->at( pos_ ); }
+
+        ///* Returns the element at position 'pos_', in O(log n), without checking it.
+        T & operator[]( size_type pos_ ) { return data_of( select( sentinel(), pos_ ) ); }
+        const T & operator[]( size_type pos_ ) const { return data_of( select( sentinel(), pos_ ) ); }
+
+        ///* Returns the position of the element at 'pos_' (the size, for end()), in O(log n).
+        size_type index_of( const_iterator pos_ ) const { return rank_of( pos_.m_ptr ); }
+
+        ///* Returns the object at the beginning of the list.
+        T & front( void )
+        {
+            if (empty())
+                throw std::length_error("[indexed_list::front()]: empty list.");
+            return data_of( sentinel()->next );
+        }
+        const T & front( void ) const { return const_cast< indexed_list * >( this )->front(); }
+
+        ///* Returns the object at the end of the list.
+        T & back( void )
+        {
+            if (empty())
+                throw std::length_error("[indexed_list::back()]: empty list.");
+            return data_of( sentinel()->prev );
+        }
+        const T & back( void ) const { return const_cast< indexed_list * >( this )->back(); }
+
+        //!=== [IV] Modifiers
+        ///* Remove (either logically or physically) all elements from the container.
+        void clear()
+        {
+            sc::list_hook * node = sentinel()->next;
+            while (node != sentinel()) {
+                sc::list_hook * next = node->next;
+                destroy_node( node );
+                node = next;
+            }
+            algorithms::reset( sentinel() );
+            sentinel()->parent = nullptr;
+        }
+
+        ///* Adds 'value_' to the front of the list, in O(log n).
+        void push_front( const T & value_ ) { this->emplace( this->cbegin(), value_ ); }
+        void push_front( T && value_ ) { this->emplace( this->cbegin(), std::move( value_ ) ); }
+
+        ///* Adds 'value_' to the end of the list, in O(log n).
+        void push_back( const T & value_ ) { this->emplace( this->cend(), value_ ); }
+        void push_back( T && value_ ) { this->emplace( this->cend(), std::move( value_ ) ); }
+
+        ///* Removes the object at the front of the list.
+        void pop_front( void ) { this->erase( this->cbegin() ); }
+
+        ///* Removes the object at the end of the list.
+        void pop_back( void ) { this->erase( const_iterator{ base_of( sentinel()->prev ) } ); }
+
+        ///* Exchanges the contents of the list with those of 'other' in O(1).
+        void swap( indexed_list & other ) noexcept
+        {
+            if (node_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap( m_alloc, other.m_alloc );
+            }
+            this->swap_nodes( other );
+        }
+
+        //!=== [IV-a] MODIFIERS W/ ITERATORS
+        ///* Replaces the contents of the list with copies of the elements in the range [first; last).
+        ///* The existing elements are overwritten in order, then the surplus is erased or the rest is inserted.
+        template < class InItr >
+        void assign( InItr first_, InItr last_ )
+        {
+            sc::list_hook * node = sentinel()->next;
+            for ( ; node != sentinel() and first_ != last_; node = node->next, ++first_)
+                data_of(node) = *first_;
+            if (node != sentinel()) this->erase( const_iterator{ base_of( node ) }, this->cend() );
+            else this->insert( this->cend(), first_, last_ );
+        }
+
+        /*!
+         *  Constructs an element in place, from 'args_', before 'pos_', in O(log n).
+         *  \return An iterator to the new element.
+         */
+        template < typename... Args >
+        iterator emplace( const_iterator pos_, Args&&... args_ )
+        {
+            NodeBase * node = base_of( create_node( std::forward<Args>( args_ )... ) );
+            algorithms::link_before( pos_.m_ptr, node );
+            tree_insert( node );
+            return iterator{ node };
+        }
+
+        ///* Inserts 'value_' before 'pos_', in O(log n); returns an iterator to it.
+        iterator insert( const_iterator pos_, const T & value_ ) { return this->emplace( pos_, value_ ); }
+        iterator insert( const_iterator pos_, T && value_ ) { return this->emplace( pos_, std::move( value_ ) ); }
+
+        /*!
+         *  Inserts the elements of [first_, last_) before 'pos_', in O(k + log n) for k elements.
+         *  If an element cannot be copied, the list is left untouched.
+         *  \return An iterator to the first element inserted (or 'pos_', if none).
+         */
+        template < typename InputIt >
+        iterator insert( const_iterator pos_, InputIt first_, InputIt last_ )
+        {
+            indexed_list extra( first_, last_, get_allocator() );
+            iterator first{ base_of( extra.sentinel()->next ) };
+            if (extra.empty()) first = iterator{ pos_.m_ptr };
+            this->splice( pos_, extra );
+            return first;
+        }
+
+        ///* Inserts the elements of 'ilist_' before 'pos_'.
+        iterator insert( const_iterator pos_, std::initializer_list<T> ilist_ )
+        { return this->insert( pos_, ilist_.begin(), ilist_.end() ); }
+
+        /*!
+         *  Erases the element at 'pos_', in O(log n).
+         *  \return An iterator to the element that followed it.
+         */
+        iterator erase( const_iterator pos_ )
+        {
+            NodeBase * node = pos_.m_ptr;
+            NodeBase * next = base_of( node->next );
+            tree_erase( node );
+            algorithms::unlink( node );
+            destroy_node( node );
+            return iterator{ next };
+        }
+
+        /*!
+         *  Erases the elements in [first_, last_), in O(k + log n) for k elements: the range
+         *  leaves the tree in a single split.
+         *  \return An iterator to 'last_'.
+         */
+        iterator erase( const_iterator first_, const_iterator last_ )
+        {
+            if (first_ == last_) return iterator{ last_.m_ptr };
+            std::size_t from = rank_of( first_.m_ptr ), to = rank_of( last_.m_ptr );
+            NodeBase * before, * range, * after;
+            split( sentinel()->parent, from, before, after );
+            split( after, to - from, range, after );
+            set_root( join( before, after ) );
+            // Desliga o trecho da lista de uma vez e libera seus nós.
+            sc::list_hook * node = first_.m_ptr;
+            (node->prev)->next = last_.m_ptr;
+            last_.m_ptr->prev = node->prev;
+            while (node != last_.m_ptr) {
+                sc::list_hook * next = node->next;
+                destroy_node( node );
+                node = next;
+            }
+            return iterator{ last_.m_ptr };
+        }
+
+        //!=== [V] UTILITY METHODS
+
+        /*! Transfers all elements from 'other' into *this, before 'pos', in O(log n).
+         *  The behavior is undefined if other refers to the same object as *this,
+         *  or if the allocators differ.
+         */
+        void splice( const_iterator pos, indexed_list & other )
+        {
+            if (other.empty() or this == &other) return;
+            NodeBase * before, * after;
+            split( sentinel()->parent, rank_of( pos.m_ptr ), before, after );
+            set_root( join( join( before, other.sentinel()->parent ), after ) );
+            algorithms::transfer( pos.m_ptr, other.sentinel()->next, other.sentinel()->prev );
+            algorithms::reset( other.sentinel() );
+            other.sentinel()->parent = nullptr;
+        }
+
+        /// Transfers the element at 'it' from the list that holds it into *this, before 'pos', in O(log n).
+        void splice( const_iterator pos, indexed_list & /* other */, const_iterator it )
+        {
+            if (pos == it or pos.m_ptr->prev == it.m_ptr) return;
+            tree_erase( it.m_ptr );
+            algorithms::unlink( it.m_ptr );
+            algorithms::link_before( pos.m_ptr, it.m_ptr );
+            this->tree_insert( it.m_ptr );
+        }
+
+        /*! Transfers the elements in [first, last) from 'other' into *this, before 'pos', in O(log n).
+         *  'other' may be *this, as long as 'pos' is not in the range.
+         */
+        void splice( const_iterator pos, indexed_list & other, const_iterator first, const_iterator last )
+        {
+            if (first == last) return;
+            std::size_t from = rank_of( first.m_ptr ), to = rank_of( last.m_ptr );
+            NodeBase * before, * range, * after;
+            split( other.sentinel()->parent, from, before, after );
+            split( after, to - from, range, after );
+            other.set_root( join( before, after ) );
+            // Com o trecho fora da árvore, a posição de 'pos' já desconta seus nós (se for a mesma lista).
+            split( sentinel()->parent, rank_of( pos.m_ptr ), before, after );
+            set_root( join( join( before, range ), after ) );
+            sc::list_hook * tail = last.m_ptr->prev;
+            (first.m_ptr->prev)->next = last.m_ptr;
+            last.m_ptr->prev = first.m_ptr->prev;
+            algorithms::transfer( pos.m_ptr, first.m_ptr, tail );
+        }
+
+        /*! Merges 'other' into *this. Both lists should be sorted in ascending order.
+         *  The container other becomes empty after the operation.
+         */
+        void merge( indexed_list & other ) { this->merge( other, std::less<T>() ); }
+
+        /*! Merges 'other' into *this, using 'comp' to compare the elements, with the stable
+         *  merge of sc::list; the tree is then rebuilt in O(n). If 'comp' throws, every
+         *  element is kept in *this, in unspecified order.
+         */
+        template < typename Compare >
+        void merge( indexed_list & other, Compare comp )
+        {
+            if (other.empty() or this == &other) return;
+            std::size_t count = size() + other.size();
+            other.sentinel()->parent = nullptr;
+            try {
+                algorithms::merge( sentinel(), other.sentinel(), comp );
+            }
+            catch (...) { rebuild( count ); throw; }
+            rebuild( count );
+        }
+
+        /// Reverses the order of the elements; the tree is mirrored in O(n).
+        void reverse( void )
+        {
+            algorithms::reverse( sentinel() );
+            for (sc::list_hook * node = sentinel()->next; node != sentinel(); node = node->next)
+                std::swap( base_of( node )->left, base_of( node )->right );
+        }
+
+        /// Removes all consecutive duplicate elements.
+        void unique( void ) { this->unique( std::equal_to<T>() ); }
+
+        /// Removes every element for which 'pred', applied to the element kept before it and to itself, returns true.
+        template < typename BinaryPredicate >
+        void unique( BinaryPredicate pred )
+        {
+            std::size_t count = size();
+            try {
+                algorithms::unique( sentinel(), pred, [&]( sc::list_hook * node ){ destroy_node( node ); --count; } );
+            }
+            catch (...) { rebuild( count ); throw; }
+            rebuild( count );
+        }
+
+        /// Sorts the elements in ascending order. The sort is stable and never allocates.
+        void sort( void ) { this->sort( std::less<T>() ); }
+
+        /*! Sorts the elements using 'comp' to compare them, with the bottom-up merge sort of sc::list;
+         *  the tree is then rebuilt in O(n). If 'comp' throws, every element is kept in the list,
+         *  in unspecified order.
+         */
+        template < typename Compare >
+        void sort( Compare comp )
+        {
+            std::size_t count = size();
+            if (count <= 1) return;
+            try {
+                algorithms::sort( sentinel(), comp );
+            }
+            catch (...) { rebuild( count ); throw; }
+            rebuild( count );
+        }
+    };
+
+    //!=== [VI] OPERATORS
+
+    ///* Checks if the contents of 'l1_' and 'l2_' are equal.
+    template < typename T, typename Alloc >
+    inline bool operator==( const sc::indexed_list<T, Alloc> & l1_, const sc::indexed_list<T, Alloc> & l2_ )
+    {
+        return l1_.size() == l2_.size() and std::equal( l1_.cbegin(), l1_.cend(), l2_.cbegin() );
+    }
+
+    ///* Checks if the contents of 'l1_' and 'l2_' are different.
+    template < typename T, typename Alloc >
+    inline bool operator!=( const sc::indexed_list<T, Alloc> & l1_, const sc::indexed_list<T, Alloc> & l2_ )
+    {
+        return not ( l1_ == l2_ );
+    }
+
+    ///* Exchanges the contents of 'l1_' and 'l2_' in O(1).
+    template < typename T, typename Alloc >
+    inline void swap( sc::indexed_list<T, Alloc> & l1_, sc::indexed_list<T, Alloc> & l2_ )
+    {
+        l1_.swap( l2_ );
+    }
+}
+#endif
@@ -0,0 +1,366 @@
+#ifndef _INTRUSIVE_LIST_H_
+#define _INTRUSIVE_LIST_H_
+
+#include <cstddef>    // std::ptrdiff_t, std::size_t
+#include <functional> // std::less, std::equal_to
+#include <iterator>   // bidirectional_iterator_tag
+#include <stdexcept>  // std::length_error
+#include <type_traits>
+#include <utility>    // std::swap
+
+#include "list_hook.h"
+
+namespace sc {
+    /*!
+     * A doubly linked list of objects that carry their own links.
+     *
+     * The element type embeds an `sc::list_hook` member, named by `Hook`:
+     *
+     *     struct Task { int id; sc::list_hook hook; };
+     *     sc::intrusive_list< Task, &Task::hook > queue;
+     *
+     * The list does not own its elements: it never allocates, copies or destroys
+     * them, it only links and unlinks them. Every operation except sort(), merge()
+     * and unique() is O(1) per element, and unlinking an element given by reference
+     * (see iterator_to()) needs no search. The relinking algorithms are the same
+     * ones used by `sc::list`.
+     *
+     * \note
+     * An object must be on at most one list per hook, and must be erased from
+     * the list before it is destroyed. Erased elements have their hook reset.
+     */
+    template < typename T, sc::list_hook T::* Hook >
+    class intrusive_list
+    {
+        private:
+        using NodeBase = sc::list_hook;
+
+        /// Offset of the hook inside T, measured on (never constructed) suitably aligned storage.
+        static std::ptrdiff_t hook_offset( void )
+        {
+            typename std::aligned_storage< sizeof(T), alignof(T) >::type probe;
+            const T * object = reinterpret_cast< const T * >( &probe );
+            return reinterpret_cast< const char * >( &(object->*Hook) ) - reinterpret_cast< const char * >( object );
+        }
+
+        /// Accesses the element that embeds 'node_' (never the sentinel).
+        static T & data_of( NodeBase * node_ )
+        { return *reinterpret_cast< T * >( reinterpret_cast< char * >( node_ ) - hook_offset() ); }
+
+        /// Maps a hook to its element for the relinking algorithms shared with sc::list.
+        struct value_traits
+        {
+            using value_type = T;
+            static T & value_of( NodeBase * node_ ) { return data_of( node_ ); }
+        };
+        using algorithms = sc::detail::list_algorithms< value_traits >;
+
+        public:
+            using value_type      = T;
+            using size_type       = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference       = T &;
+            using const_reference = const T &;
+
+        //=== The iterator classes.
+        public:
+        class const_iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = const T *;
+                using reference         = const T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_ptr; //!< The hook of the element (the sentinel for end()).
+
+            public:
+                const_iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                reference operator*() const { return data_of(m_ptr); }
+                pointer operator->() const { return &data_of(m_ptr); }
+
+                const_iterator & operator++() { m_ptr = m_ptr->next; return *this; }
+                const_iterator operator++(int) { const_iterator retval{m_ptr}; m_ptr = m_ptr->next; return retval; }
+                const_iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
+                const_iterator operator--(int) { const_iterator retval{m_ptr}; m_ptr = m_ptr->prev; return retval; }
+
+                bool operator==( const const_iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const const_iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+
+                // We need friendship so the list class may access the m_ptr field.
+                friend class intrusive_list;
+        };
+
+        class iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = T *;
+                using reference         = T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_ptr; //!< The hook of the element (the sentinel for end()).
+
+            public:
+                iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                /// Every iterator may be used where a const_iterator is expected.
+                operator const_iterator() const { return const_iterator{ m_ptr }; }
+
+                reference operator*() const { return data_of(m_ptr); }
+                pointer operator->() const { return &data_of(m_ptr); }
+
+                iterator & operator++() { m_ptr = m_ptr->next; return *this; }
+                iterator operator++(int) { iterator retval{m_ptr}; m_ptr = m_ptr->next; return retval; }
+                iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
+                iterator operator--(int) { iterator retval{m_ptr}; m_ptr = m_ptr->prev; return retval; }
+
+                bool operator==( const iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+
+                // We need friendship so the list class may access the m_ptr field.
+                friend class intrusive_list;
+        };
+
+        //=== Private members.
+        private:
+            size_t m_len;        // comprimento da lista.
+            NodeBase m_sentinel; // sentinela (sem valor): next é o primeiro nó e prev, o último.
+
+            NodeBase * sentinel( void ) const { return const_cast< NodeBase * >( &m_sentinel ); }
+
+            /// Unlinks 'node_' and marks its hook as unlinked.
+            void unlink( NodeBase * node_ )
+            {
+                algorithms::unlink( node_ );
+                node_->next = node_->prev = nullptr;
+                m_len--;
+            }
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty list.
+        intrusive_list() noexcept : m_len{ 0 }
+        { algorithms::reset( sentinel() ); }
+
+        ///* (2) The elements belong to the client, so a list cannot be copied.
+        intrusive_list( const intrusive_list & ) = delete;
+        intrusive_list & operator=( const intrusive_list & ) = delete;
+
+        ///* (3) Move constructor. Takes over the elements of 'other' in O(1); 'other' is left empty.
+        intrusive_list( intrusive_list && other ) noexcept : intrusive_list()
+        { this->swap( other ); }
+
+        ///* (4) Move assignment. The current elements are unlinked; those of 'rhs' are taken over.
+        intrusive_list & operator=( intrusive_list && rhs ) noexcept
+        {
+            if (this != &rhs) {
+                this->clear();
+                this->swap( rhs );
+            }
+            return *this;
+        }
+
+        ///* (5) Destructs the list, unlinking (but not destroying) every element.
+        ~intrusive_list() { clear(); }
+
+        //!=== [II] ITERATORS
+        iterator begin() { return iterator{ sentinel()->next }; }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return const_iterator{ sentinel()->next }; }
+        iterator end() { return iterator{ sentinel() }; }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator{ sentinel() }; }
+
+        /// Returns an iterator to 'value_', which must be on this list, in O(1).
+        iterator iterator_to( T & value_ ) { return iterator{ &(value_.*Hook) }; }
+        const_iterator iterator_to( const T & value_ ) const
+        { return const_iterator{ const_cast< NodeBase * >( &(value_.*Hook) ) }; }
+
+        //!=== [III] Capacity/Status
+        ///* Check if the list is empty, that is, there are no elements.
+        bool empty( void ) const { return m_len == 0; }
+
+        ///* Check the size of the list.
+        size_type size( void ) const { return m_len; }
+
+        //!=== [IV] Modifiers
+        ///* Unlinks all elements from the container.
+        void clear()
+        {
+            NodeBase * node = sentinel()->next;
+            while (node != sentinel()) {
+                NodeBase * next = node->next;
+                node->next = node->prev = nullptr;
+                node = next;
+            }
+            m_len = 0;
+            algorithms::reset( sentinel() );
+        }
+
+        ///* Returns the object at the beginning of the list.
+        T & front( void )
+        {
+            if (empty())
+                throw std::length_error("[intrusive_list::front()]: empty list.");
+            return data_of( sentinel()->next );
+        }
+        const T & front( void ) const
+        {
+            if (empty())
+                throw std::length_error("[intrusive_list::front()]: empty list.");
+            return data_of( sentinel()->next );
+        }
+
+        ///* Returns the object at the end of the list.
+        T & back( void )
+        {
+            if (empty())
+                throw std::length_error("[intrusive_list::back()]: empty list.");
+            return data_of( sentinel()->prev );
+        }
+        const T & back( void ) const
+        {
+            if (empty())
+                throw std::length_error("[intrusive_list::back()]: empty list.");
+            return data_of( sentinel()->prev );
+        }
+
+        ///* Links 'value_' at the front of the list.
+        void push_front( T & value_ ) { this->insert( this->begin(), value_ ); }
+
+        ///* Links 'value_' at the end of the list.
+        void push_back( T & value_ ) { this->insert( this->end(), value_ ); }
+
+        ///* Unlinks the object at the front of the list.
+        void pop_front( void ) { this->unlink( sentinel()->next ); }
+
+        ///* Unlinks the object at the end of the list.
+        void pop_back( void ) { this->unlink( sentinel()->prev ); }
+
+        ///* Exchanges the contents of the list with those of 'other' in O(1).
+        void swap( intrusive_list & other ) noexcept
+        {
+            algorithms::swap_nodes( sentinel(), other.sentinel() );
+            std::swap( m_len, other.m_len );
+        }
+
+        //!=== [IV-a] MODIFIERS W/ ITERATORS
+        /*!
+         *  Links 'value_' before 'pos_'. 'value_' must not be on any list (through this hook).
+         *  \return An iterator to 'value_'.
+         */
+        iterator insert( const_iterator pos_, T & value_ )
+        {
+            NodeBase * node = &(value_.*Hook);
+            algorithms::link_before( pos_.m_ptr, node );
+            m_len++;
+            return iterator{ node };
+        }
+
+        /*!
+         *  Unlinks the element at 'pos_', in O(1). The element itself is left untouched.
+         *  \return An iterator to the element that followed it.
+         */
+        iterator erase( const_iterator pos_ )
+        {
+            NodeBase * next = pos_.m_ptr->next;
+            this->unlink( pos_.m_ptr );
+            return iterator{ next };
+        }
+
+        /// Unlinks the elements in [first_, last_); returns 'last_'.
+        iterator erase( const_iterator first_, const_iterator last_ )
+        {
+            while (first_ != last_) first_ = this->erase( first_ );
+            return iterator{ last_.m_ptr };
+        }
+
+        /// Unlinks 'value_', which must be on this list, in O(1).
+        void remove( T & value_ ) { this->erase( this->iterator_to( value_ ) ); }
+
+        //!=== [V] UTILITY METHODS
+
+        /*! Merges 'other' into *this. Both lists should be sorted in ascending order.
+         *  The container other becomes empty after the operation.
+         */
+        void merge( intrusive_list & other ) { this->merge( other, std::less<T>() ); }
+
+        /*! Merges 'other' into *this, using 'comp' to compare the elements.
+         *  Both lists should be sorted with respect to 'comp'. The merge is stable: for
+         *  equivalent elements, those from *this precede those from other.
+         *  If 'comp' throws, every element is kept in *this, in unspecified order.
+         */
+        template < typename Compare >
+        void merge( intrusive_list & other, Compare comp )
+        {
+            if (other.empty() or this == &other) return;
+            m_len += other.m_len;
+            other.m_len = 0;
+            algorithms::merge( sentinel(), other.sentinel(), comp );
+        }
+
+        /*! Transfers all elements from 'other' into *this, before 'pos', in O(1).
+         *  The behavior is undefined if other refers to the same object as *this.
+         */
+        void splice( const_iterator pos, intrusive_list & other )
+        {
+            if (other.empty()) return;
+            algorithms::transfer( pos.m_ptr, other.sentinel()->next, other.sentinel()->prev );
+            m_len += other.m_len;
+            other.m_len = 0;
+            algorithms::reset( other.sentinel() );
+        }
+
+        /// Transfers the element at 'it' from 'other' into *this, before 'pos', in O(1).
+        void splice( const_iterator pos, intrusive_list & other, const_iterator it )
+        {
+            if (pos == it or pos.m_ptr->prev == it.m_ptr) return;
+            algorithms::unlink( it.m_ptr );
+            other.m_len--;
+            algorithms::link_before( pos.m_ptr, it.m_ptr );
+            m_len++;
+        }
+
+        /// Reverses the order of the elements.
+        void reverse( void ) { algorithms::reverse( sentinel() ); }
+
+        /// Unlinks all consecutive duplicate elements.
+        void unique( void ) { this->unique( std::equal_to<T>() ); }
+
+        /// Unlinks every element for which 'pred', applied to the element kept before it and to itself, returns true.
+        template < typename BinaryPredicate >
+        void unique( BinaryPredicate pred )
+        {
+            algorithms::unique( sentinel(), pred, [this]( NodeBase * node ){ node->next = node->prev = nullptr; m_len--; } );
+        }
+
+        /// Sorts the elements in ascending order. The sort is stable and never allocates.
+        void sort( void ) { this->sort( std::less<T>() ); }
+
+        /*! Sorts the elements using 'comp' to compare them, with the bottom-up merge sort of sc::list.
+         *  If 'comp' throws, every element is kept in the list, in unspecified order.
+         */
+        template < typename Compare >
+        void sort( Compare comp )
+        {
+            if (m_len <= 1) return;
+            algorithms::sort( sentinel(), comp );
+        }
+    };
+
+    ///* Exchanges the contents of 'l1_' and 'l2_' in O(1).
+    template < typename T, sc::list_hook T::* Hook >
+    inline void swap( sc::intrusive_list<T, Hook> & l1_, sc::intrusive_list<T, Hook> & l2_ )
+    {
+        l1_.swap( l2_ );
+    }
+}
+#endif
@@ -0,0 +1,699 @@
+#ifndef _LINKED_HASH_MAP_H_
+#define _LINKED_HASH_MAP_H_
+
+#include <algorithm>  // std::fill
+#include <cstddef>    // std::size_t, std::ptrdiff_t
+#include <cstdint>    // std::uint64_t
+#include <functional> // std::hash, std::equal_to
+#include <iterator>   // bidirectional_iterator_tag
+#include <memory>     // std::allocator, std::allocator_traits
+#include <stdexcept>  // std::out_of_range
+#include <tuple>      // std::forward_as_tuple
+#include <utility>    // std::pair, std::forward, std::move, std::swap
+#include <vector>
+
+#include "list_hook.h"
+
+namespace sc {
+    namespace detail {
+        /// The relinking algorithms applied to bare hooks, for the eviction policies.
+        struct hook_traits
+        {
+            using value_type = sc::list_hook;
+            static sc::list_hook & value_of( sc::list_hook * node_ ) { return *node_; }
+        };
+        using hook_algorithms = list_algorithms< hook_traits >;
+    }
+
+    /*!
+     * Eviction policies for sc::linked_hash_map.
+     *
+     * A policy keeps the entries of a map on one circular list, around the sentinel
+     * 'order_', in the order it wants: the map iterates in that order and asks the
+     * policy which entry to evict. Each node carries a `Policy::entry` for the
+     * policy's own bookkeeping. A policy provides:
+     *
+     *     struct entry;                                              // per-node data
+     *     void inserted( list_hook * order_, list_hook * node_, entry & );  // links a new node
+     *     void accessed( list_hook * order_, list_hook * node_, entry & );  // on a hit
+     *     void erased( list_hook * order_, list_hook * node_, entry & );    // unlinks a node
+     *     template < typename EntryOf >
+     *     list_hook * victim( list_hook * order_, EntryOf entry_of_ );      // next node to evict
+     */
+
+    /// Least recently used: a hit relinks the entry at the back; the front is evicted.
+    struct lru_policy
+    {
+        struct entry { };
+
+        void inserted( list_hook * order_, list_hook * node_, entry & )
+        { detail::hook_algorithms::link_before( order_, node_ ); }
+
+        void accessed( list_hook * order_, list_hook * node_, entry & )
+        {
+            if (node_->next == order_) return;  // Já é o mais recente.
+            detail::hook_algorithms::unlink( node_ );
+            detail::hook_algorithms::link_before( order_, node_ );
+        }
+
+        void erased( list_hook *, list_hook * node_, entry & ) { detail::hook_algorithms::unlink( node_ ); }
+
+        template < typename EntryOf >
+        list_hook * victim( list_hook * order_, EntryOf ) { return order_->next; }
+    };
+
+    /*!
+     * Least frequently used, ties broken by recency, in O(1) per operation.
+     *
+     * The list is kept sorted by hit count. Entries with the same count form a
+     * contiguous group, described by a small record (count, size and last node);
+     * a hit moves the entry to the end of the group with the next count, creating
+     * that group if needed. The front entry, the oldest with the lowest count, is
+     * evicted. Group records are recycled, so allocation only happens when a new
+     * count is reached for the first time; they come from 'Alloc', rebound, which
+     * sc::linked_hash_map replaces by its own allocator.
+     */
+    template < typename Alloc = std::allocator< void > >
+    class basic_lfu_policy
+    {
+        public:
+            struct group
+            {
+                std::size_t count;      //!< Hits of every entry in the group.
+                std::size_t size;       //!< Number of entries in the group.
+                list_hook * last;       //!< Last entry of the group in the list.
+                group * prev;           //!< Group with the next lower count.
+                group * next;           //!< Group with the next higher count.
+            };
+            struct entry { group * owner = nullptr; };
+            using allocator_type = Alloc;
+
+        private:
+            using group_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<group>;
+            using group_traits = std::allocator_traits<group_allocator_type>;
+
+            group * m_first = nullptr;  // grupo de menor contagem.
+            group * m_spare = nullptr;  // registros livres, ligados por 'next'.
+            group_allocator_type m_alloc;
+
+            group * make_group( std::size_t count_, group * prev_, group * next_, list_hook * last_ )
+            {
+                group * g = m_spare;
+                if (g != nullptr) m_spare = g->next;
+                else {
+                    g = group_traits::allocate( m_alloc, 1 );
+                    group_traits::construct( m_alloc, g );
+                }
+                *g = group{ count_, 1, last_, prev_, next_ };
+                if (prev_ != nullptr) prev_->next = g; else m_first = g;
+                if (next_ != nullptr) next_->prev = g;
+                return g;
+            }
+
+            void drop_group( group * g_ )
+            {
+                if (g_->prev != nullptr) g_->prev->next = g_->next; else m_first = g_->next;
+                if (g_->next != nullptr) g_->next->prev = g_->prev;
+                g_->next = m_spare;
+                m_spare = g_;
+            }
+
+            void release( group * g_ )
+            {
+                while (g_ != nullptr) {
+                    group * next = g_->next;
+                    group_traits::destroy( m_alloc, g_ );
+                    group_traits::deallocate( m_alloc, g_, 1 );
+                    g_ = next;
+                }
+            }
+
+            static void link_after( list_hook * pos_, list_hook * node_ )
+            { detail::hook_algorithms::link_before( pos_->next, node_ ); }
+
+        public:
+            explicit basic_lfu_policy( const Alloc & alloc_ = Alloc() ) : m_alloc{ alloc_ } { /* empty */ }
+            basic_lfu_policy( basic_lfu_policy && other_ ) noexcept
+                : m_first{ other_.m_first }, m_spare{ other_.m_spare }, m_alloc{ other_.m_alloc }
+            { other_.m_first = other_.m_spare = nullptr; }
+            basic_lfu_policy & operator=( basic_lfu_policy && other_ ) noexcept
+            {
+                std::swap( m_first, other_.m_first );
+                std::swap( m_spare, other_.m_spare );
+                std::swap( m_alloc, other_.m_alloc );
+                return *this;
+            }
+            basic_lfu_policy( const basic_lfu_policy & ) = delete;
+            basic_lfu_policy & operator=( const basic_lfu_policy & ) = delete;
+            ~basic_lfu_policy() { release( m_first ); release( m_spare ); }
+
+            void inserted( list_hook * order_, list_hook * node_, entry & e_ )
+            {
+                if (m_first != nullptr and m_first->count == 1) {
+                    link_after( m_first->last, node_ );
+                    m_first->last = node_;
+                    ++m_first->size;
+                    e_.owner = m_first;
+                }
+                else {
+                    link_after( order_, node_ );
+                    e_.owner = make_group( 1, nullptr, m_first, node_ );
+                }
+            }
+
+            void accessed( list_hook *, list_hook * node_, entry & e_ )
+            {
+                group * g = e_.owner;
+                group * up = g->next;
+                const std::size_t count = g->count + 1;
+                bool up_fits = up != nullptr and up->count == count;
+                // Sozinha no grupo e sem grupo seguinte: basta incrementar a contagem.
+                if (g->size == 1 and not up_fits) { ++g->count; return; }
+                if (g->last == node_) g->last = node_->prev;
+                --g->size;
+                if (up_fits) {
+                    detail::hook_algorithms::unlink( node_ );
+                    link_after( up->last, node_ );
+                    up->last = node_;
+                    ++up->size;
+                    e_.owner = up;
+                }
+                else {
+                    list_hook * anchor = g->last;   // A entrada passa para o fim do seu grupo...
+                    if (anchor->next != node_) {
+                        detail::hook_algorithms::unlink( node_ );
+                        link_after( anchor, node_ );
+                    }
+                    e_.owner = make_group( count, g, up, node_ ); // ... num grupo novo, logo depois.
+                }
+                if (g->size == 0) drop_group( g );
+            }
+
+            void erased( list_hook *, list_hook * node_, entry & e_ )
+            {
+                group * g = e_.owner;
+                if (g->last == node_) g->last = node_->prev;
+                if (--g->size == 0) drop_group( g );
+                detail::hook_algorithms::unlink( node_ );
+            }
+
+            template < typename EntryOf >
+            list_hook * victim( list_hook * order_, EntryOf ) { return order_->next; }
+    };
+
+    /// LFU with the default allocator, for which sc::linked_hash_map substitutes its own.
+    using lfu_policy = basic_lfu_policy<>;
+
+    /*!
+     * CLOCK (second chance): a hit only sets the entry's reference bit, with no relink.
+     * To evict, a hand sweeps the list clearing the bits it finds set and stops at the
+     * first entry whose bit is clear. New entries go right behind the hand.
+     */
+    class clock_policy
+    {
+        public:
+            struct entry { bool referenced = false; };
+
+        private:
+            list_hook * m_hand = nullptr;   // próxima candidata (nullptr: a primeira da lista).
+
+        public:
+            clock_policy() = default;
+            clock_policy( clock_policy && other_ ) noexcept : m_hand{ other_.m_hand } { other_.m_hand = nullptr; }
+            clock_policy & operator=( clock_policy && other_ ) noexcept
+            {
+                std::swap( m_hand, other_.m_hand );
+                return *this;
+            }
+
+            void inserted( list_hook * order_, list_hook * node_, entry & e_ )
+            {
+                e_.referenced = false;
+                detail::hook_algorithms::link_before( m_hand != nullptr ? m_hand : order_, node_ );
+            }
+
+            void accessed( list_hook *, list_hook *, entry & e_ ) { e_.referenced = true; }
+
+            void erased( list_hook * order_, list_hook * node_, entry & )
+            {
+                if (m_hand == node_) m_hand = node_->next == order_ ? nullptr : node_->next;
+                detail::hook_algorithms::unlink( node_ );
+            }
+
+            template < typename EntryOf >
+            list_hook * victim( list_hook * order_, EntryOf entry_of_ )
+            {
+                if (order_->next == order_) return order_;
+                list_hook * node = m_hand != nullptr ? m_hand : order_->next;
+                while (true) {
+                    if (node == order_) { node = node->next; continue; }   // O sentinela não tem bit.
+                    entry & e = entry_of_( node );
+                    if (not e.referenced) { m_hand = node; return node; }
+                    e.referenced = false;           // Segunda chance.
+                    node = node->next;
+                }
+            }
+    };
+
+    namespace detail {
+        /// The policy a map with allocator 'Alloc' keeps: one that allocates is rebound to 'Alloc'.
+        template < typename Policy, typename Alloc >
+        struct policy_for
+        {
+            using type = Policy;
+            static type make( const Alloc & ) { return type{}; }
+        };
+
+        template < typename A, typename Alloc >
+        struct policy_for< basic_lfu_policy<A>, Alloc >
+        {
+            using type = basic_lfu_policy<Alloc>;
+            static type make( const Alloc & alloc_ ) { return type{ alloc_ }; }
+        };
+    }
+
+    /*!
+     * A hash map whose entries are also linked in the order kept by an eviction
+     * policy (LRU by default), for use as a bounded cache.
+     *
+     * Each entry is a single node holding the key, the value, the hash-chain link and
+     * the list links, so an insertion makes one allocation and a hit is one hash
+     * lookup plus, for LRU, one O(1) relink, as splice() does in sc::list. When a
+     * capacity is set, inserting into a full map evicts the entry chosen by the policy.
+     * Iteration follows the policy order: for LRU, from the least to the most recently
+     * used entry.
+     *
+     * find() looks an entry up without touching it; get(), operator[], put() and
+     * touch() count as accesses.
+     */
+    template < typename Key, typename T, typename Policy = sc::lru_policy,
+               typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+               typename Alloc = std::allocator< std::pair< const Key, T > > >
+    class linked_hash_map
+    {
+        public:
+            using key_type        = Key;
+            using mapped_type     = T;
+            using value_type      = std::pair< const Key, T >;
+            using size_type       = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using hasher          = Hash;
+            using key_equal       = KeyEqual;
+            using allocator_type  = Alloc;
+            using policy_type     = Policy;
+
+        private:
+        using NodeBase = sc::list_hook;
+        using policy_traits = detail::policy_for< Policy, Alloc >;
+        using policy_impl = typename policy_traits::type;
+
+        //=== the node: policy links, hash chain and element together.
+        struct Node : NodeBase
+        {
+            Node * bucket_next;                 //!< Next node in the same bucket.
+            std::size_t hash;                   //!< Hash of the key, kept for rehashing and quick rejection.
+            typename policy_impl::entry entry;       //!< The policy's bookkeeping.
+            value_type value;
+
+            template < typename... Args >
+            explicit Node( std::size_t hash_, Args&&... args_ )
+                : NodeBase{ nullptr, nullptr }, bucket_next{ nullptr }, hash{ hash_ }, entry{}, value( std::forward<Args>( args_ )... )
+            { /* empty */ }
+        };
+
+        static Node * node_of( NodeBase * node_ ) { return static_cast< Node * >( node_ ); }
+
+        using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+        using bucket_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node *>;
+
+        public:
+        //=== The iterator classes (over the policy order).
+        class const_iterator
+        {
+            public:
+                using value_type        = typename linked_hash_map::value_type;
+                using pointer           = const value_type *;
+                using reference         = const value_type &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_ptr;
+
+            public:
+                const_iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                reference operator*() const { return node_of(m_ptr)->value; }
+                pointer operator->() const { return &node_of(m_ptr)->value; }
+
+                const_iterator & operator++() { m_ptr = m_ptr->next; return *this; }
+                const_iterator operator++(int) { const_iterator retval{m_ptr}; m_ptr = m_ptr->next; return retval; }
+                const_iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
+                const_iterator operator--(int) { const_iterator retval{m_ptr}; m_ptr = m_ptr->prev; return retval; }
+
+                bool operator==( const const_iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const const_iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+
+                friend class linked_hash_map;
+        };
+
+        class iterator
+        {
+            public:
+                using value_type        = typename linked_hash_map::value_type;
+                using pointer           = value_type *;
+                using reference         = value_type &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_ptr;
+
+            public:
+                iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                operator const_iterator() const { return const_iterator{ m_ptr }; }
+
+                reference operator*() const { return node_of(m_ptr)->value; }
+                pointer operator->() const { return &node_of(m_ptr)->value; }
+
+                iterator & operator++() { m_ptr = m_ptr->next; return *this; }
+                iterator operator++(int) { iterator retval{m_ptr}; m_ptr = m_ptr->next; return retval; }
+                iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
+                iterator operator--(int) { iterator retval{m_ptr}; m_ptr = m_ptr->prev; return retval; }
+
+                bool operator==( const iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+
+                friend class linked_hash_map;
+        };
+
+        //=== Private members.
+        private:
+            size_type m_len;                                    // número de entradas.
+            size_type m_capacity;                               // máximo de entradas (0: sem limite).
+            NodeBase m_order;                                   // sentinela da ordem mantida pela política.
+            std::vector< Node *, bucket_allocator_type > m_buckets; // cadeias de colisão (potência de 2).
+            unsigned m_shift;                                   // 64 - log2( número de buckets ).
+            policy_impl m_policy;
+            Hash m_hash;
+            KeyEqual m_equal;
+            node_allocator_type m_alloc;
+
+            NodeBase * order( void ) const { return const_cast< NodeBase * >( &m_order ); }
+
+            /// Bucket of a hash: the top bits of a Fibonacci product, so that poor hashes (e.g. identity) still spread.
+            size_type bucket_of( std::size_t hash_ ) const
+            { return static_cast< size_type >( ( static_cast< std::uint64_t >( hash_ ) * 0x9E3779B97F4A7C15ull ) >> m_shift ); }
+
+            /// The link that points to the node with 'key_' in its chain, or to the null end of the chain.
+            Node ** locate( const Key & key_, std::size_t hash_ ) const
+            {
+                static Node * none = nullptr;   // a cadeia vazia de um mapa sem buckets (movido).
+                if (m_buckets.empty()) return &none;
+                Node ** link = const_cast< Node ** >( &m_buckets[ bucket_of( hash_ ) ] );
+                while (*link != nullptr and not ( (*link)->hash == hash_ and m_equal( (*link)->value.first, key_ ) ))
+                    link = &(*link)->bucket_next;
+                return link;
+            }
+
+            /// Redistributes the chains over 'count_' buckets (a power of two).
+            void rehash_to( size_type count_ )
+            {
+                std::vector< Node *, bucket_allocator_type > buckets( count_, nullptr, m_buckets.get_allocator() );
+                unsigned shift = 64;
+                for (size_type c = count_; c > 1; c >>= 1) --shift;
+                m_buckets.swap( buckets );
+                m_shift = shift;
+                for (Node * chain : buckets)
+                    while (chain != nullptr) {
+                        Node * next = chain->bucket_next;
+                        Node *& head = m_buckets[ bucket_of( chain->hash ) ];
+                        chain->bucket_next = head;
+                        head = chain;
+                        chain = next;
+                    }
+            }
+
+            /// Smallest power of two not below 'n_' (at least 8).
+            static size_type bucket_count_for( size_type n_ )
+            {
+                size_type count = 8;
+                while (count < n_) count <<= 1;
+                return count;
+            }
+
+            /// Removes 'node_' from its chain and from the policy order, and releases it.
+            void destroy( Node * node_ )
+            {
+                Node ** link = &m_buckets[ bucket_of( node_->hash ) ];
+                while (*link != node_) link = &(*link)->bucket_next;
+                *link = node_->bucket_next;
+                m_policy.erased( order(), node_, node_->entry );
+                node_traits::destroy( m_alloc, node_ );
+                node_traits::deallocate( m_alloc, node_, 1 );
+                --m_len;
+            }
+
+            /// Removes the entry chosen by the policy.
+            void evict( void )
+            {
+                NodeBase * victim = m_policy.victim( order(), []( NodeBase * node ) -> typename policy_impl::entry & { return node_of( node )->entry; } );
+                if (victim != order()) destroy( node_of( victim ) );
+            }
+
+            /*! Inserts a new node built from 'args_' (the key is known to be absent), evicting first if
+             *  the map is full. Everything that may throw (building the node, growing the buckets)
+             *  happens before the eviction: if it throws, nothing changes.
+             */
+            template < typename... Args >
+            Node * insert_node( std::size_t hash_, Args&&... args_ )
+            {
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                try {
+                    node_traits::construct( m_alloc, node, hash_, std::forward<Args>( args_ )... );
+                }
+                catch (...) {
+                    node_traits::deallocate( m_alloc, node, 1 );
+                    throw;
+                }
+                const bool full = m_capacity != 0 and m_len >= m_capacity;
+                if (not full and m_len + 1 > m_buckets.size()) {  // Cheia, a remoção abre espaço: não cresce.
+                    try {
+                        rehash_to( bucket_count_for( m_buckets.size() * 2 ) );
+                    }
+                    catch (...) {
+                        node_traits::destroy( m_alloc, node );
+                        node_traits::deallocate( m_alloc, node, 1 );
+                        throw;
+                    }
+                }
+                if (full) evict();
+                Node *& head = m_buckets[ bucket_of( hash_ ) ];
+                node->bucket_next = head;
+                head = node;
+                m_policy.inserted( order(), node, node->entry );
+                ++m_len;
+                return node;
+            }
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Constructs an empty map that holds at most 'capacity_' entries (0: no limit).
+        explicit linked_hash_map( size_type capacity_ = 0, const Hash & hash_ = Hash(), const KeyEqual & equal_ = KeyEqual(),
+                                  const Alloc & alloc_ = Alloc() )
+            : m_len{ 0 }, m_capacity{ capacity_ }, m_buckets( bucket_allocator_type( alloc_ ) ), m_shift{ 64 },
+              m_policy( policy_traits::make( alloc_ ) ), m_hash{ hash_ }, m_equal{ equal_ }, m_alloc{ alloc_ }
+        {
+            detail::hook_algorithms::reset( order() );
+            rehash_to( bucket_count_for( capacity_ ) );
+        }
+
+        ///* (2) The entries are not copied.
+        linked_hash_map( const linked_hash_map & ) = delete;
+        linked_hash_map & operator=( const linked_hash_map & ) = delete;
+
+        ///* (3) Move constructor. Takes over the entries of 'other' in O(1); 'other' is left empty, with no buckets until it is used again.
+        linked_hash_map( linked_hash_map && other ) noexcept
+            : m_len{ 0 }, m_capacity{ other.m_capacity }, m_buckets( other.m_buckets.get_allocator() ), m_shift{ 64 },
+              m_policy( policy_traits::make( other.get_allocator() ) ), m_hash{ other.m_hash }, m_equal{ other.m_equal },
+              m_alloc{ other.m_alloc }
+        {
+            detail::hook_algorithms::reset( order() );
+            this->swap( other );
+        }
+
+        ///* (4) Move assignment: the current entries are destroyed and those of 'rhs' taken over.
+        linked_hash_map & operator=( linked_hash_map && rhs )
+        {
+            if (this != &rhs) {
+                this->clear();
+                this->swap( rhs );
+            }
+            return *this;
+        }
+
+        ///* (5) Destructs the map.
+        ~linked_hash_map() { clear(); }
+
+        ///* Exchanges the contents of two maps in O(1) (the allocators must be equal).
+        void swap( linked_hash_map & other ) noexcept
+        {
+            detail::hook_algorithms::swap_nodes( order(), other.order() );
+            std::swap( m_len, other.m_len );
+            std::swap( m_capacity, other.m_capacity );
+            m_buckets.swap( other.m_buckets );
+            std::swap( m_shift, other.m_shift );
+            std::swap( m_policy, other.m_policy );
+            std::swap( m_hash, other.m_hash );
+            std::swap( m_equal, other.m_equal );
+        }
+
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        //!=== [II] Iterators (policy order: for LRU, least recently used first)
+        iterator begin() { return iterator{ order()->next }; }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return const_iterator{ order()->next }; }
+        iterator end() { return iterator{ order() }; }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator{ order() }; }
+
+        //!=== [III] Capacity
+        bool empty( void ) const { return m_len == 0; }
+        size_type size( void ) const { return m_len; }
+        ///* Maximum number of entries before the policy evicts one (0: no limit).
+        size_type capacity( void ) const { return m_capacity; }
+        size_type bucket_count( void ) const { return m_buckets.size(); }
+
+        //!=== [IV] Lookup
+        ///* Finds the entry with 'key_' without counting it as an access; returns end() if there is none.
+        iterator find( const Key & key_ )
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            return node == nullptr ? end() : iterator{ node };
+        }
+        const_iterator find( const Key & key_ ) const
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            return node == nullptr ? cend() : const_iterator{ node };
+        }
+
+        bool contains( const Key & key_ ) const { return *locate( key_, m_hash( key_ ) ) != nullptr; }
+        size_type count( const Key & key_ ) const { return contains( key_ ) ? 1 : 0; }
+
+        /*! The hit path of a cache: finds the value of 'key_' and counts the access
+         *  (for LRU, one relink). @return A pointer to the value, or nullptr on a miss.
+         */
+        T * get( const Key & key_ )
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            if (node == nullptr) return nullptr;
+            m_policy.accessed( order(), node, node->entry );
+            return &node->value.second;
+        }
+
+        ///* Counts an access to the entry at 'pos_' (for LRU, makes it the most recently used).
+        void touch( const_iterator pos_ )
+        {
+            Node * node = node_of( pos_.m_ptr );
+            m_policy.accessed( order(), node, node->entry );
+        }
+
+        ///* The value of 'key_', which must be there (otherwise std::out_of_range is thrown); not an access.
+        T & at( const Key & key_ )
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            if (node == nullptr) throw std::out_of_range( "[linked_hash_map::at()]: key not found." );
+            return node->value.second;
+        }
+        const T & at( const Key & key_ ) const
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            if (node == nullptr) throw std::out_of_range( "[linked_hash_map::at()]: key not found." );
+            return node->value.second;
+        }
+
+        //!=== [V] Modifiers
+        /*! Inserts an entry for 'key_', with the value constructed from 'args_', if there is none
+         *  (then a full map evicts one entry first). An existing entry is left as is, and not touched.
+         *  @return The entry for 'key_' and whether it was inserted.
+         */
+        template < typename... Args >
+        std::pair< iterator, bool > try_emplace( const Key & key_, Args&&... args_ )
+        {
+            std::size_t hash = m_hash( key_ );
+            Node * node = *locate( key_, hash );
+            if (node != nullptr) return { iterator{ node }, false };
+            node = insert_node( hash, std::piecewise_construct, std::forward_as_tuple( key_ ),
+                                std::forward_as_tuple( std::forward<Args>( args_ )... ) );
+            return { iterator{ node }, true };
+        }
+
+        ///* Same as try_emplace( value_.first, value_.second ).
+        std::pair< iterator, bool > insert( const value_type & value_ ) { return try_emplace( value_.first, value_.second ); }
+
+        /*! The write path of a cache: assigns 'value_' to the entry for 'key_', or inserts it, and
+         *  counts the access. @return The entry for 'key_' and whether it was inserted.
+         */
+        template < typename M >
+        std::pair< iterator, bool > put( const Key & key_, M && value_ )
+        {
+            std::size_t hash = m_hash( key_ );
+            Node * node = *locate( key_, hash );
+            if (node == nullptr) {
+                node = insert_node( hash, key_, std::forward<M>( value_ ) );
+                return { iterator{ node }, true };
+            }
+            node->value.second = std::forward<M>( value_ );
+            m_policy.accessed( order(), node, node->entry );
+            return { iterator{ node }, false };
+        }
+
+        ///* The value of 'key_', default-inserted if there is none; counts as an access.
+        T & operator[]( const Key & key_ )
+        {
+            auto result = try_emplace( key_ );
+            if (not result.second) touch( result.first );
+            return result.first->second;
+        }
+
+        ///* Removes the entry at 'pos_'; returns an iterator to the next one in policy order.
+        iterator erase( const_iterator pos_ )
+        {
+            NodeBase * next = pos_.m_ptr->next;
+            destroy( node_of( pos_.m_ptr ) );
+            return iterator{ next };
+        }
+
+        ///* Removes the entry for 'key_', if any; returns how many were removed (0 or 1).
+        size_type erase( const Key & key_ )
+        {
+            Node * node = *locate( key_, m_hash( key_ ) );
+            if (node == nullptr) return 0;
+            destroy( node );
+            return 1;
+        }
+
+        ///* Removes every entry.
+        void clear( void )
+        {
+            while (order()->next != order()) {
+                Node * node = node_of( order()->next );
+                m_policy.erased( order(), node, node->entry );
+                node_traits::destroy( m_alloc, node );
+                node_traits::deallocate( m_alloc, node, 1 );
+            }
+            std::fill( m_buckets.begin(), m_buckets.end(), nullptr );
+            m_len = 0;
+        }
+    };
+
+    ///* Exchanges the contents of 'a_' and 'b_' in O(1).
+    template < typename K, typename T, typename P, typename H, typename E, typename A >
+    inline void swap( linked_hash_map<K, T, P, H, E, A> & a_, linked_hash_map<K, T, P, H, E, A> & b_ ) { a_.swap( b_ ); }
+}
+#endif
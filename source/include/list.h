@@ -9,10 +9,37 @@ using std::endl;
 #include <cassert>   // assert()
 #include <algorithm> // copy
 using std::copy;
+#include <atomic>    // live nodes of a chunk
 #include <cstddef>   // std::ptrdiff_t
+#include <cstdint>   // std::uint32_t
+#include <functional> // std::less, std::equal_to
+#include <memory>    // std::allocator, std::allocator_traits
+#include <new>       // placement new
 #include <type_traits>
+#include <utility>   // std::forward, std::move, std::swap
+#include <vector>    // parallel sort bookkeeping
+
+#include "execution.h"
+#include "list_hook.h"
 
 namespace sc { // linear sequence. Better name: sequence container (same as STL).
+    template < typename T, typename Alloc > class concurrent_list;
+
+    /*!
+     * Size policies for sc::list: how the length is kept when a range of nodes moves
+     * between two lists.
+     *
+     * - eager_size (default): size() is always O(1). A range spliced from another list
+     *   is walked once to count its nodes, so that splice is O(k).
+     * - lazy_size: a range splice between lists is O(1) and leaves the length of both
+     *   lists unknown. The next call to size() counts the nodes (O(n)) and caches the
+     *   result. merge(), splice(), unique() and erase() keep the length unknown rather
+     *   than resolve it. empty() is always O(1). Since size() may then write the cached
+     *   count, two threads must not call it at once on the same list, even if it is const.
+     */
+    struct eager_size { };
+    struct lazy_size { };
+
     /*!
      * A class representing a biderectional iterator defined over a linked list.
      *
@@ -25,39 +52,113 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
      * \author Selan R. dos Santos
      */
 
-    template < typename T >
+    template < typename T, typename Alloc = std::allocator<T>, typename SizePolicy = sc::eager_size >
     class list
     {
         private:
+        //=== the links of a node (also used, alone, by the sentinel).
+        using NodeBase = sc::list_hook;
+
         //=== the data node.
-        struct Node
+        struct Node : NodeBase
         {
             T data; // Tipo de informação a ser armazenada no container.
-            Node * next;
-            Node * prev;
+            std::uint32_t slot; // posição no bloco (NodeChunk) de onde veio; 0: alocado sozinho.
 
-            Node( const T &d=T{} , Node * n=nullptr, Node * p=nullptr )
-                : data {d}, next{n}, prev{p}
+            /// Constructs 'data' in place from 'args', with null links, as a node allocated on its own.
+            template < typename... Args >
+            explicit Node( Args&&... args )
+                : NodeBase{ nullptr, nullptr }, data( std::forward<Args>( args )... ), slot{ 0 }
             { /* empty */ }
         };
 
+        /*! Header of a chunk of nodes requested at once by the bulk constructors. It takes the
+         *  first slot of the chunk and the nodes the others, so a node finds it from its own
+         *  'slot' in O(1). The chunk goes back to the allocator with its last live node, in
+         *  whatever list that node ended up.
+         */
+        struct NodeChunk
+        {
+            std::atomic< size_t > live;     //!< Nodes of the chunk not released yet (maybe in several lists).
+            size_t slots;                   //!< Slots requested from the allocator, the header's included.
+        };
+
+        /// Accesses the element of a data node (never of a sentinel).
+        static T & data_of( NodeBase * node_ ) { return static_cast< Node * >( node_ )->data; }
+        static const T & data_of( const NodeBase * node_ ) { return static_cast< const Node * >( node_ )->data; }
+
+        /// Maps a node to its element for the relinking algorithms shared with sc::intrusive_list.
+        struct value_traits
+        {
+            using value_type = T;
+            static T & value_of( NodeBase * node_ ) { return data_of( node_ ); }
+        };
+        using algorithms = sc::detail::list_algorithms< value_traits >;
+
+        //=== Allocator aliases.
+        public:
+            using allocator_type = Alloc; //!< The allocator supplied by the client.
+
+            /// Minimum number of nodes per thread for the parallel sort to split the work.
+            static constexpr size_t parallel_sort_grain = 1u << 14;
+
+            /// Minimum number of elements for sort() to pick the radix sort over the merge sort (see sort_by_radix()).
+            static constexpr size_t radix_sort_threshold = 256;
+
+            /// Minimum number of elements for the radix sort to use 11-bit digits (fewer passes) instead of bytes.
+            static constexpr size_t radix_wide_threshold = 1u << 16;
+
+            /// Whether a range splice between lists may leave the length to be counted later (see sc::lazy_size).
+            static constexpr bool lazy_length = std::is_same< SizePolicy, sc::lazy_size >::value;
+
+        private:
+            /// Nodes are drawn from the client allocator, rebound to Node.
+            using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+            using node_traits = std::allocator_traits<node_allocator_type>;
+
+            /// Largest chunk the bulk constructors request at once, in bytes (one node per slot).
+            static constexpr size_t chunk_bytes = 64 * 1024;
+
+            /// Destroys a data node and gives its storage back: on its own, or with the last live node of its chunk.
+            static void release_node( node_allocator_type & alloc_, Node * node_ )
+            {
+                std::uint32_t slot = node_->slot;
+                node_traits::destroy( alloc_, node_ );
+                if (slot == 0) {
+                    node_traits::deallocate( alloc_, node_, 1 );
+                    return;
+                }
+                Node * first = node_ - slot;
+                NodeChunk * chunk = reinterpret_cast< NodeChunk * >( first );
+                if (chunk->live.fetch_sub( 1, std::memory_order_acq_rel ) == 1) {
+                    size_t slots = chunk->slots;
+                    chunk->~NodeChunk();
+                    node_traits::deallocate( alloc_, first, slots );
+                }
+            }
 
         //=== The iterator classes.
         public:
 
-        class const_iterator : public std::bidirectional_iterator_tag 
+        /*!
+         *  Iterators are a single node pointer, trivially copyable, with the member types
+         *  std::iterator_traits looks for; every operation is one load or one comparison,
+         *  so std algorithms over a list compile to the same pointer-chasing loop as a
+         *  hand-written one. An iterator converts implicitly to a const_iterator.
+         */
+        class const_iterator
         {
             //=== Some aliases to help writing a clearer code.
             public:
                 using value_type        = T;         //!< The type of the value stored in the list.
-                using pointer           = T *;       //!< Pointer to the value.
-                using reference         = T &;       //!< reference to the value.
+                using pointer           = const T *; //!< Pointer to the value.
+                using reference         = const T &; //!< reference to the value.
                 using const_reference   = const T &; //!< const reference to the value.
                 using difference_type   = std::ptrdiff_t;
                 using iterator_category = std::bidirectional_iterator_tag;
 
             private:
-                Node * m_ptr; //!< The raw pointer.
+                NodeBase * m_ptr; //!< The raw pointer.
 
             public:
 
@@ -65,7 +166,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Constrói iterador constante para o tipo Node.
                  *  @param ptr Ponteiro para tipo Node.
                  */
-                const_iterator(Node * ptr = nullptr ) : m_ptr{ ptr }
+                constexpr const_iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr }
                 {/*empty*/}
 
                 // Destrutor
@@ -86,16 +187,14 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 const_iterator& operator=( const const_iterator & ) = default;
 
 
-                reference  operator*() { /* TODO */ return m_ptr->data; }
-
-                const_reference  operator*() const { /* TODO */ return m_ptr->data; }
+                reference  operator*() const { return data_of(m_ptr); }
 
 
                 /// Operador de incremento
                 /*! Avança o iterador constante para a próxima localização na lista encadeada. Corresponde ao pré-incremento.
                  *  @return Iterador constante apontando para a próxima localização da lista encadeada.
                  */
-                const_iterator operator++() { m_ptr = m_ptr->next; return const_iterator{m_ptr}; }
+                const_iterator & operator++() { m_ptr = m_ptr->next; return *this; }
 
                 /// Operador de incremento
                 /*! Avança o iterador constante para a próxima localização na lista encadeada. Corresponde ao pós-incremento.
@@ -107,7 +206,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Retrocede o iterador constante para a localização anterior na lista encadeada. Corresponde ao pré-decremento.
                  *  @return Iterador constante apontando para a localização anterior da lista encadeada.
                  */
-                const_iterator operator--() { m_ptr = m_ptr->prev; return const_iterator{m_ptr}; }
+                const_iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
 
                 /// Operador de decremento
                 /*! Retrocede o iterador constante para a localização anterior na lista encadeada. Corresponde ao pós-decremento.
@@ -119,80 +218,67 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Verifica se ambos iteradores apontam para a mesma localização.
                  *  @return Verdadeiro se ambos iteradores apontarem para a mesma localização na lista encadeada; e falso caso contrário.
                  */
-                bool operator==( const const_iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                /// (Also compares an iterator with a const_iterator, through the conversion.)
+                constexpr friend bool operator==( const const_iterator & lhs, const const_iterator & rhs ) { return lhs.m_ptr == rhs.m_ptr; }
 
                 /// Operador de diferença
                 /*! Verifica se os iteradores apontam para localizações distintas.
                  *  @return Verdadeiro se cada iterador apontar para uma localização diferente na lista encadeada; e falso caso contrário.
                  */
-                bool operator!=( const const_iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+                constexpr friend bool operator!=( const const_iterator & lhs, const const_iterator & rhs ) { return lhs.m_ptr != rhs.m_ptr; }
 
                 //=== Other methods that you might want to implement.
 
-                /// it += 3; // Go back  3 positions within the container. 
-                const_iterator operator+=( difference_type step) {
-                     for(auto i{0}; i < step; i++) m_ptr = m_ptr->next; 
-                     return const_iterator{m_ptr}; 
+                /// it += 3; // Advances 3 positions (goes back if the step is negative), one node at a time.
+                const_iterator & operator+=( difference_type step ) {
+                    for( ; step > 0; --step) m_ptr = m_ptr->next;
+                    for( ; step < 0; ++step) m_ptr = m_ptr->prev;
+                    return *this;
                 }
 
-                /// it -= 3; // Go back  3 positions within the container. 
-                const_iterator operator-=(  difference_type step ) {
-                     for(auto i{0}; i < step; i++) m_ptr = m_ptr->prev; 
-                     return const_iterator{m_ptr}; 
-                }
+                /// it -= 3; // Go back  3 positions within the container (advances if the step is negative).
+                const_iterator & operator-=( difference_type step ) { return *this += -step; }
 
-                
                 /// Operador de salto para trás
                 /*! Retorna um iterador apontando para o n-ésimo antecessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo antecessor de it na lista encadeada.
                 */
-                friend const_iterator operator-( const_iterator it, difference_type valor) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it--;
-                    }
-                    return it; 
-                }
+                friend const_iterator operator-( const_iterator it, difference_type valor ) { return it -= valor; }
 
                 /// Operador de salto para frente
                 /*! Retorna um iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 */
-                friend const_iterator operator+( const_iterator it, difference_type valor ) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it++;
-                    }
-                    return it; 
-                }
-                
+                friend const_iterator operator+( const_iterator it, difference_type valor ) { return it += valor; }
+
                 /// Operador de salto para frente
                 /*! Retorna um iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 */
-                friend const_iterator operator+( difference_type valor, const_iterator it ) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it++;
-                    }
-                    return it;
-                }
-
+                friend const_iterator operator+( difference_type valor, const_iterator it ) { return it += valor; }
 
                 /// it->method()
-                pointer operator->( void ) const { /* TODO */ return nullptr; }
-                /// it1 - it2
-                difference_type operator-( const const_iterator & rhs ) const { /* TODO */ return 0; }
+                pointer operator->( void ) const { return &data_of(m_ptr); }
+                /// it1 - it2: the number of steps from 'rhs' forward to *this, which must be reachable
+                /// from 'rhs' (as for std::distance()). Takes O(n): see sc::indexed_list for O(log n).
+                difference_type operator-( const const_iterator & rhs ) const {
+                    difference_type n{0};
+                    for (const NodeBase * node = rhs.m_ptr; node != m_ptr; node = node->next) ++n;
+                    return n;
+                }
 
                 // We need friendship so the list<T> class may access the m_ptr field.
-                friend class list<T>;
+                friend class list;
 
                 friend std::ostream & operator<< ( std::ostream & os_, const const_iterator & s_ )
                 {
-                    os_ << "[@"<< s_.m_ptr << ", val = " << s_.m_ptr->data << "]";
+                    os_ << "[@"<< s_.m_ptr << ", val = " << data_of(s_.m_ptr) << "]";
                     return os_;
                 }
         };
 
 
-        class iterator : public std::bidirectional_iterator_tag 
+        class iterator
         {
             //=== Some aliases to help writing a clearer code.
             public:
@@ -204,7 +290,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 using iterator_category = std::bidirectional_iterator_tag;
 
             private:
-                Node * m_ptr; //!< The raw pointer.
+                NodeBase * m_ptr; //!< The raw pointer.
 
             public:
 
@@ -212,9 +298,12 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Constrói iterador para o tipo Node.
                  *  @param ptr Ponteiro para tipo Node.
                  */
-                iterator( Node * ptr = nullptr ) : m_ptr{ ptr }
+                constexpr iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr }
                 { /*empty*/ }
 
+                /// Every iterator may be used where a const_iterator is expected.
+                constexpr operator const_iterator() const { return const_iterator{ m_ptr }; }
+
                 // Destrutor
                 /*! Destrói o iterador.
                  */
@@ -233,16 +322,13 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 iterator& operator=( const iterator & ) = default;
 
                 
-                reference  operator*() { /* TODO */ return m_ptr->data; }
-
-                // const_reference  operator*() const { /* TODO */ return nullptr; }
-                const_reference  operator*() const { return m_ptr->data; }
+                reference  operator*() const { return data_of(m_ptr); }
 
                 /// Operador de incremento
                 /*! Avança o iterador para a próxima localização na lista encadeada. Corresponde ao pré-incremento.
                  *  @return Iterador apontando para a próxima localização da lista encadeada.
                  */
-                iterator operator++() { m_ptr = m_ptr->next; return iterator{m_ptr}; }
+                iterator & operator++() { m_ptr = m_ptr->next; return *this; }
 
                 /// Operador de incremento
                 /*! Avança o iterador para a próxima localização na lista encadeada. Corresponde ao pós-incremento.
@@ -254,7 +340,7 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Retrocede o iterador para a localização anterior na lista encadeada. Corresponde ao pré-decremento.
                  *  @return Iterador apontando para a localização anterior da lista encadeada.
                  */
-                iterator operator--() { m_ptr = m_ptr->prev; return iterator{m_ptr}; }
+                iterator & operator--() { m_ptr = m_ptr->prev; return *this; }
 
                 /// Operador de decremento
                 /*! Retrocede o iterador para a localização anterior na lista encadeada. Corresponde ao pós-decremento.
@@ -266,372 +352,544 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
                 /*! Verifica se ambos iteradores apontam para a mesma localização.
                  *  @return Verdadeiro se ambos iteradores apontarem para a mesma localização na lista encadeada; e falso caso contrário.
                  */
-                bool operator==( const iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                constexpr bool operator==( const iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
 
                 /// Operador de diferença
                 /*! Verifica se os iteradores apontam para localizações distintas.
                  *  @return Verdadeiro se cada iterador apontar para uma localização diferente na lista encadeada; e falso caso contrário.
                  */
-                bool operator!=( const iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+                constexpr bool operator!=( const iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
 
 
                 //=== Other methods that you might want to implement.
 
-                /// it += 3; // Go back  3 positions within the container. 
-                iterator operator+=( difference_type step) {
-                    for(auto i{0}; i < step; i++) m_ptr = m_ptr->next;
-                    return iterator{m_ptr}; 
+                /// it += 3; // Advances 3 positions (goes back if the step is negative), one node at a time.
+                iterator & operator+=( difference_type step ) {
+                    for( ; step > 0; --step) m_ptr = m_ptr->next;
+                    for( ; step < 0; ++step) m_ptr = m_ptr->prev;
+                    return *this;
                 }
 
-                /// it -= 3; // Go back  3 positions within the container. 
-                iterator operator-=(  difference_type step ) { 
-                    for(auto i{0}; i < step; i++) m_ptr = m_ptr->prev;
-                    return iterator{m_ptr};
-                }
+                /// it -= 3; // Go back  3 positions within the container (advances if the step is negative).
+                iterator & operator-=( difference_type step ) { return *this += -step; }
 
                 /// Operador de salto para trás
                 /*! Retorna um iterador apontando para o n-ésimo antecessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo antecessor de it na lista encadeada.
                 */
-                friend iterator operator-( iterator it, difference_type valor) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it--;
-                    }
-                    return it; 
-                }
+                friend iterator operator-( iterator it, difference_type valor ) { return it -= valor; }
 
                 /// Operador de salto para frente
                 /*! Retorna um iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 */
-                friend iterator operator+( iterator it, difference_type valor ) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it++;
-                    }
-                    return it; 
-                }
-                
+                friend iterator operator+( iterator it, difference_type valor ) { return it += valor; }
+
                 /// Operador de salto para frente
                 /*! Retorna um iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 *  @return Iterador apontando para o n-ésimo sucessor de it na lista encadeada.
                 */
-                friend iterator operator+( difference_type valor, iterator it ) { 
-                    for(difference_type i = 0 ; i < valor ; i++){
-                        it++;
-                    }
-                    return it;
-                }
-
+                friend iterator operator+( difference_type valor, iterator it ) { return it += valor; }
 
                 /// it->method()
-                pointer operator->( void ) const { /* TODO */ return nullptr; }
-                /// it1 - it2
-                difference_type operator-( const iterator & rhs ) const { /* TODO */ return 0; }
+                pointer operator->( void ) const { return &data_of(m_ptr); }
+                /// it1 - it2: the number of steps from 'rhs' forward to *this, which must be reachable
+                /// from 'rhs' (as for std::distance()). Takes O(n): see sc::indexed_list for O(log n).
+                difference_type operator-( const iterator & rhs ) const {
+                    difference_type n{0};
+                    for (const NodeBase * node = rhs.m_ptr; node != m_ptr; node = node->next) ++n;
+                    return n;
+                }
 
                 // We need friendship so the list<T> class may access the m_ptr field.
-                friend class list<T>;
+                friend class list;
 
                 friend std::ostream & operator<< ( std::ostream & os_, const iterator & s_ )
                 {
-                    os_ << "[@"<< s_.m_ptr << ", val = " << s_.m_ptr->data << "]";
+                    os_ << "[@"<< s_.m_ptr << ", val = " << data_of(s_.m_ptr) << "]";
                     return os_;
                 }
         };
 
 
+        /*!
+         *  An owning handle to a node extracted from a list (see extract()). It keeps the
+         *  element alive, with no copy, until it is inserted into a list with an equal
+         *  allocator; a handle destroyed while holding a node releases it.
+         */
+        class node_type
+        {
+            private:
+                Node * m_node;                  //!< The extracted node, or nullptr.
+                union {
+                    node_allocator_type m_alloc; //!< Releases the node if it is never inserted; alive only while there is a node.
+                };
+
+                node_type( NodeBase * node_, const node_allocator_type & alloc_ ) noexcept
+                    : m_node{ static_cast< Node * >( node_ ) }
+                { ::new ( static_cast< void * >( &m_alloc ) ) node_allocator_type( alloc_ ); }
+
+                /// Gives up the node, leaving the handle empty.
+                Node * release( void ) noexcept
+                {
+                    Node * node = m_node;
+                    if (node != nullptr) m_alloc.~node_allocator_type();
+                    m_node = nullptr;
+                    return node;
+                }
+
+                /// Takes the node of 'other_', if any, leaving it empty (this handle must be empty).
+                void take( node_type & other_ ) noexcept
+                {
+                    if (other_.m_node == nullptr) return;
+                    ::new ( static_cast< void * >( &m_alloc ) ) node_allocator_type( std::move( other_.m_alloc ) );
+                    m_node = other_.release();
+                }
+
+                /// Destroys and releases the node, if any.
+                void reset( void )
+                {
+                    if (m_node == nullptr) return;
+                    release_node( m_alloc, m_node );
+                    release();
+                }
+
+                friend class list;
+
+            public:
+                using value_type = T;
+                using allocator_type = Alloc;
+
+                /// An empty handle; it holds no allocator either, so none is constructed.
+                node_type() noexcept : m_node{ nullptr } { /* empty */ }
+                node_type( node_type && other_ ) noexcept : m_node{ nullptr } { take( other_ ); }
+                node_type & operator=( node_type && other_ )
+                {
+                    if (this == &other_) return *this;
+                    reset();
+                    take( other_ );
+                    return *this;
+                }
+                node_type( const node_type & ) = delete;
+                node_type & operator=( const node_type & ) = delete;
+                ~node_type() { reset(); }
+
+                /// Whether the handle holds no node.
+                bool empty( void ) const noexcept { return m_node == nullptr; }
+                explicit operator bool( void ) const noexcept { return m_node != nullptr; }
+
+                /// The element held (the handle must not be empty).
+                T & value( void ) const { return m_node->data; }
+
+                /// The allocator of the list the node came from (the handle must not be empty).
+                allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+                void swap( node_type & other_ ) noexcept
+                {
+                    node_type held;
+                    held.take( other_ );
+                    other_.take( *this );
+                    take( held );
+                }
+        };
+
         //=== Private members.
         private:
-            size_t m_len;  // comprimento da lista.
-            Node * m_head; // nó cabeça.
-            Node * m_tail; // nó calda.
+            mutable size_t m_len;  // comprimento da lista (só vale se m_len_stale for falso).
+            mutable bool m_len_stale = false; // com lazy_size: m_len precisa ser recontado.
+            NodeBase m_sentinel; // sentinela (sem valor): next é o primeiro nó e prev, o último.
+            node_allocator_type m_alloc; // alocador dos nós de dados.
+
+            /// Allocates a data node and constructs its element in place from 'args_'.
+            template < typename... Args >
+            NodeBase * create_node( Args&&... args_ )
+            {
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                try {
+                    node_traits::construct( m_alloc, node, std::forward<Args>( args_ )... );
+                }
+                catch (...) {
+                    node_traits::deallocate( m_alloc, node, 1 );
+                    throw;
+                }
+                return node;
+            }
+
+            /// Destroys and deallocates a data node through the node allocator, in O(1).
+            void destroy_node( NodeBase * node_ ) { release_node( m_alloc, static_cast< Node * >( node_ ) ); }
+
+            /// Single-pass assign(): the range cannot be measured, so it is read as it goes.
+            template < typename InputIt >
+            void assign_range( InputIt first_, InputIt last_, std::input_iterator_tag )
+            {
+                NodeBase * node = sentinel()->next;
+                for ( ; node != sentinel() and first_ != last_; node = node->next, ++first_)
+                    data_of(node) = *first_;
+                if (node != sentinel()) this->erase( iterator{node}, this->end() );
+                else append_range( first_, last_ );
+            }
+
+            /// assign() for ranges that can be measured: the surplus is built aside first, in chunks (see append_nodes()).
+            template < typename ForwardIt >
+            void assign_range( ForwardIt first_, ForwardIt last_, std::forward_iterator_tag )
+            {
+                assign_n( first_, std::distance( first_, last_ ) );
+            }
+
+            /// Replaces the contents with the 'count' elements starting at 'first_'.
+            template < typename ForwardIt >
+            void assign_n( ForwardIt first_, size_t count )
+            {
+                list extra( get_allocator() );
+                const size_t len = size();
+                if (count > len) {
+                    ForwardIt mid = first_;
+                    std::advance( mid, len );
+                    extra.append_nodes( count - len, [&]( Node * node ){ // Se lançar exceção, nada foi alterado.
+                        node_traits::construct( extra.m_alloc, node, *mid );
+                        ++mid;
+                    } );
+                }
+                NodeBase * node = sentinel()->next;
+                for ( ; node != sentinel() and count > 0; node = node->next, ++first_, --count)
+                    data_of(node) = *first_;
+                if (node != sentinel()) this->erase( iterator{node}, this->end() );
+                else this->splice( this->cend(), extra );
+            }
+
+            /*! Appends 'count_' elements to the list; 'construct_( node )' must construct the node
+             *  (and its element) in place. The nodes come in chunks of up to 'chunk_bytes' (a
+             *  single node is allocated on its own); each one can still be erased, extracted or
+             *  spliced into another list on its own, and its chunk is released with the last of
+             *  them. If 'construct_' throws, the nodes built so far remain in the list.
+             */
+            template < typename Construct >
+            void append_nodes( size_t count_, Construct construct_ )
+            {
+                static_assert( sizeof(NodeChunk) <= sizeof(Node) and alignof(NodeChunk) <= alignof(Node),
+                               "the chunk header must fit in one node slot" );
+                constexpr size_t chunk_slots = chunk_bytes / sizeof(Node) > 2 ? chunk_bytes / sizeof(Node) : 2;
+                while (count_ > 0) {
+                    if (count_ == 1) {
+                        Node * node = node_traits::allocate( m_alloc, 1 );
+                        try {
+                            construct_( node );
+                        }
+                        catch (...) {
+                            node_traits::deallocate( m_alloc, node, 1 );
+                            throw;
+                        }
+                        link_before( sentinel(), node );
+                        return;
+                    }
+                    size_t slots = std::min( count_ + 1, chunk_slots );
+                    Node * first = node_traits::allocate( m_alloc, slots );
+                    NodeChunk * chunk = ::new ( static_cast< void * >( first ) ) NodeChunk;
+                    chunk->slots = slots;
+                    size_t i{1};
+                    try {
+                        for ( ; i < slots; ++i) {
+                            Node * node = first + i;
+                            construct_( node );
+                            node->slot = static_cast< std::uint32_t >( i );
+                            link_before( sentinel(), node );
+                        }
+                    }
+                    catch (...) {
+                        // Os nós já construídos ficam na lista e seguram o bloco; sem nenhum, ele volta já.
+                        chunk->live.store( i - 1, std::memory_order_relaxed );
+                        if (i == 1) {
+                            chunk->~NodeChunk();
+                            node_traits::deallocate( m_alloc, first, slots );
+                        }
+                        throw;
+                    }
+                    chunk->live.store( slots - 1, std::memory_order_relaxed );
+                    count_ -= slots - 1;
+                }
+            }
+
+            /*! Appends the elements of [first_, last_) in a single pass, each one constructed
+             *  directly in its node from the range.
+             */
+            template < typename InputIt >
+            void append_range( InputIt first_, InputIt last_ )
+            {
+                append_range( first_, last_, typename std::iterator_traits< InputIt >::iterator_category() );
+            }
+
+            template < typename InputIt >
+            void append_range( InputIt first_, InputIt last_, std::input_iterator_tag )
+            {
+                for ( ; first_ != last_; ++first_)
+                    append_nodes( 1, [&]( Node * node ){ node_traits::construct( m_alloc, node, *first_ ); } );
+            }
+
+            template < typename ForwardIt >
+            void append_range( ForwardIt first_, ForwardIt last_, std::forward_iterator_tag )
+            {
+                append_nodes( std::distance( first_, last_ ), [&]( Node * node ){
+                    node_traits::construct( m_alloc, node, *first_ ); // Constructs the value/data of node in place.
+                    ++first_;
+                } );
+            }
+
+            /// Links 'node_' right before 'pos_' and updates the size.
+            NodeBase * link_before( NodeBase * pos_, NodeBase * node_ )
+            {
+                algorithms::link_before( pos_, node_ );
+                m_len++;
+                return node_;
+            }
+
+            /// The sentinel plays the role of both head and tail nodes of a circular list.
+            NodeBase * sentinel( void ) const { return const_cast< NodeBase * >( &m_sentinel ); }
+
+            // sc::concurrent_list allocates the same nodes and hands batches of them over to a list.
+            template < typename, typename > friend class concurrent_list;
+
+            /// Links the chain [first_, last_] of 'count_' nodes, allocated one by one through an equal allocator, at the end.
+            void append_chain( NodeBase * first_, NodeBase * last_, size_t count_ ) noexcept
+            {
+                algorithms::transfer( sentinel(), first_, last_ );
+                m_len += count_;
+            }
+
+            /// Exchanges the nodes and sizes of two lists, fixing the links to both sentinels.
+            void swap_nodes( list & other_ ) noexcept
+            {
+                algorithms::swap_nodes( sentinel(), other_.sentinel() );
+                std::swap( m_len, other_.m_len );
+                std::swap( m_len_stale, other_.m_len_stale );
+            }
+
+            /// Links the sentinel to itself: the list becomes empty (no node is released).
+            void reset_sentinel( void ) noexcept
+            {
+                m_len = 0;
+                m_len_stale = false;
+                algorithms::reset( sentinel() );
+            }
 
         public:
         //=== Public interface
 
         //!=== [I] Special members
-        ///* (1) Default constructor that creates an empty list. 
-        list()
+        ///* (1) Default constructor that creates an empty list. No memory is allocated.
+        list() noexcept( std::is_nothrow_default_constructible<Alloc>::value ) : list( Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty list that draws its nodes from 'alloc_'.
+        explicit list( const Alloc & alloc_ ) noexcept : m_alloc{ alloc_ }
         { 
-            /*  Head & tail nodes.
-             *     +---+    +---+
-             *     |   |--->|   |--+
-             *     | H |    | T |  |
-             *  +--|   |<---|   |  |
-             *  |  +---+    +---+  |
-             *  |                  |
-             * ===                ===
-             *  =                  =
+            /*  The sentinel, embedded in the list object, is both head and tail.
+             *        +---+
+             *    +-->|   |--+  next
+             *    |   | S |  |
+             *    +---|   |<-+  prev
+             *        +---+
              */
-            m_len = 0;
-            m_head = new Node();
-            m_tail = new Node();
-            m_head->prev = nullptr;
-            m_tail->next = nullptr;
-            m_head->next = m_tail;
-            m_tail->prev = m_head;
+            reset_sentinel();
         }
 
         ///* (2) Constructs the list with 'count' default-inserted instances of T.
-        explicit list( size_t count ) 
-        {
-            m_head = new Node();
-            m_tail = new Node();
-            m_head->prev = nullptr;
-            m_tail->next = nullptr;
-            m_len = count; // Set size of list.
-            // If the list don't will be empty.
-            if (count > 0) {
-                Node * prev_node = m_head;
-                for (size_t i{0}; i < count; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == count - 1) {
-                        temp->next = m_tail;
-                        m_tail->prev = temp;
-                    }
-                    temp->prev = prev_node;
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
+        explicit list( size_t count, const Alloc & alloc_ = Alloc() ) : m_alloc{ alloc_ }
+        {
+            reset_sentinel();
+            try {
+                append_nodes( count, [this]( Node * node ){ node_traits::construct( m_alloc, node ); } );
             }
+            catch (...) { clear(); throw; }
         }
 
         ///* (3) Constructs the list with the contents of the range [first, last).
         template< typename InputIt >
-        list( InputIt first, InputIt last )
-        {
-            m_head = new Node();
-            m_tail = new Node();
-            m_head->prev = nullptr;
-            m_tail->next = nullptr;
-            size_t sz = std::distance(first, last);
-            m_len = sz; // Set size of list.
-            // std::cout << m_len << std::endl;
-            // std::cout << sz << std::endl;
-            // The range is not empty.
-            if (sz > 0) {
-                Node * prev_node = m_head;
-                for (auto i{0}; i < sz; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == sz - 1) {
-                        temp->next = m_tail;
-                        m_tail->prev = temp;
-                    }
-                    temp->prev = prev_node;
-                    temp->data = *(first+i); // Set the value/data of node.
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
+        list( InputIt first, InputIt last, const Alloc & alloc_ = Alloc() ) : m_alloc{ alloc_ }
+        {
+            reset_sentinel();
+            try {
+                append_range( first, last );
             }
+            catch (...) { clear(); throw; }
         }
 
         ///* (4) Copy constructor. Constructs a new list with the content of the 'clone_'.
         list( const list & clone_ )
+            : m_alloc{ node_traits::select_on_container_copy_construction( clone_.m_alloc ) }
         {
-            m_head = new Node();
-            m_tail = new Node();
-            m_head->prev = nullptr;
-            m_tail->next = nullptr;
-            m_len = clone_.size(); // Set size of list.
-            // The list passed is not empty.
-            if (m_len > 0) {
-                Node * prev_node = m_head;
-                Node * clone_node = (clone_.m_head)->next;
-                for (size_t i{0}; i < m_len; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == m_len - 1) {
-                        temp->next = m_tail;
-                        m_tail->prev = temp;
-                    }
-                    temp->prev = prev_node;
-                    temp->data = clone_node->data; // Set the value/data of node.
+            reset_sentinel();
+            NodeBase * clone_node = (clone_.sentinel())->next;
+            try {
+                append_nodes( clone_.size(), [&]( Node * node ){
+                    node_traits::construct( m_alloc, node, data_of(clone_node) );
                     clone_node = clone_node->next; // Get the next data of clone.
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
+                } );
             }
+            catch (...) { clear(); throw; }
         }
 
         ///* (5) Constructs the list with the contents of the initializer list 'ilist_'.
-        list( std::initializer_list<T> ilist_ )
-        {
-            m_head = new Node();
-            m_tail = new Node();
-            m_head->prev = nullptr;
-            m_tail->next = nullptr;
-            size_t sz = ilist_.size();
-            m_len = sz; // Set size of list.
-            // The initializer list is not empty.
-            if (sz > 0) {
-                Node * prev_node = m_head;
-                for (size_t i{0}; i < sz; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == sz - 1) {
-                        temp->next = m_tail;
-                        m_tail->prev = temp;
-                    }
-                    temp->prev = prev_node;
-                    temp->data = *(ilist_.begin()+i); // Set the value/data of node.
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
-            }
+        list( std::initializer_list<T> ilist_, const Alloc & alloc_ = Alloc() ) : list( ilist_.begin(), ilist_.end(), alloc_ )
+        { /* empty */ }
+
+        ///* (4a) Move constructor. Takes over the nodes of 'other' in O(1); 'other' is left empty.
+        list( list && other ) noexcept
+            : m_alloc{ std::move( other.m_alloc ) }
+        {
+            reset_sentinel();
+            this->swap_nodes( other );
         }
 
         ///* (6) Destructs the list.
         ~list()
         {
             clear();
-            delete m_head;
-            delete m_tail;
         }
 
         ///* (7) Copy assignment operator. Replaces the contents with a copy of the contents of 'rhs'.
+        ///* The existing nodes are overwritten in place; only the size difference is allocated or released
+        ///* (see assign()).
         list & operator=( const list & rhs )
         {
             if (this != &rhs) {
-                this->clear();
-                // this->m_len = rhs.size();
-                auto first = rhs.cbegin();
-                auto last = rhs.cend();
-                auto last_this = this->end();
-                // std::cout << "*first = " << *first << "\n";
-                // std::cout << "*last = " << *last << "\n";
-                // getchar();
-                while(first != last){
-                    // std::cout << "*first = " << *first << "\n";
-                    // getchar();
-                    this->insert(last_this, *first);      // Insere nó antes de last.
-                    first++;                        // Vai para próximo elemento a ser inserido, se houver.
+                // Some allocators must follow the contents: nodes from the old one cannot be kept.
+                if (node_traits::propagate_on_container_copy_assignment::value) {
+                    if (m_alloc != rhs.m_alloc) this->clear();
+                    m_alloc = rhs.m_alloc;
                 }
+                this->assign_n( rhs.cbegin(), rhs.size() );
             }
             return *this;
         }
 
-        ///* (8) Replaces the contents with those identified by initializer list 'ilist_'.
-        list & operator=( std::initializer_list<T> ilist_ )
+        ///* (7a) Move assignment operator. Takes over the nodes of 'rhs', which is left empty.
+        ///* If the allocators differ and do not propagate, the elements are moved one by one.
+        list & operator=( list && rhs ) noexcept( node_traits::propagate_on_container_move_assignment::value )
         {
+            if (this != &rhs) {
                 this->clear();
-                // this->m_len = ilist_.size();
-                auto first = ilist_.begin();
-                auto last = ilist_.end();
-                auto last_this = this->end();
-                while(first != last){
-                    this->insert(last_this, *first);      // Insere nó antes de last.
-                    first++;                        // Vai para próximo elemento a ser inserido, se houver.
+                if (node_traits::propagate_on_container_move_assignment::value or m_alloc == rhs.m_alloc) {
+                    if (node_traits::propagate_on_container_move_assignment::value)
+                        m_alloc = std::move(rhs.m_alloc);
+                    this->swap_nodes( rhs );            // Troca em O(1): this está vazia.
+                }
+                else {
+                    // Os nós de rhs não podem ser liberados pelo alocador de this.
+                    for (auto & e : rhs) this->push_back( std::move(e) );
+                    rhs.clear();
                 }
+            }
+            return *this;
+        }
+
+        ///* (8) Replaces the contents with those identified by initializer list 'ilist_' (see assign()).
+        list & operator=( std::initializer_list<T> ilist_ )
+        {
+            this->assign( ilist_ );
             return *this;
         }
 
+        ///* Returns a copy of the allocator associated with the list.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
         //!=== [II] ITERATORS
 
         /// Iterador para o início da lista encadeada.
         /*! Retorna iterador apontando para o primeiro nó válido da lista encadeada.
          *  @return Iterador apontando para o primeiro nó válido da lista encadeada.
          */
-        iterator begin() { return iterator{m_head->next}; }
+        iterator begin() { return iterator{sentinel()->next}; }
+        const_iterator begin() const { return cbegin(); }
 
         /// Iterador constante para o início da lista encadeada.
         /*! Retorna iterador constante apontando para o primeiro nó válido da lista encadeada.
          *  @return Iterador constante apontando para o primeiro nó válido da lista encadeada.
          */
-        const_iterator cbegin() const  { return const_iterator{m_head->next}; }
+        const_iterator cbegin() const  { return const_iterator{sentinel()->next}; }
 
         /// Iterador para o final da lista encadeada.
         /*! Retorna iterador apontando para o nó calda da lista encadeada.
          *  @return Iterador apontando para o nó calda da lista encadeada.
          */
-        iterator end() { return iterator{ m_tail }; }
+        iterator end() { return iterator{ sentinel() }; }
+        const_iterator end() const { return cend(); }
 
         /// Iterador constante para o final da lista encadeada.
         /*! Retorna iterador constante apontando para o nó calda da lista encadeada.
          *  @return Iterador constante apontando para o nó calda da lista encadeada.
          */
-        const_iterator cend() const  { return const_iterator{ m_tail }; }
+        const_iterator cend() const  { return const_iterator{ sentinel() }; }
 
         //!=== [III] Capacity/Status
         ///* Check if the vector is empty, that is, there are no elements.
-        bool empty( void ) const { return m_len == 0; }
+        bool empty( void ) const { return sentinel()->next == sentinel(); }
         
-        ///* Check the size of the list.
-        size_t size( void ) const { return m_len; }
+        ///* Check the size of the list: O(1), unless a range splice left it to be counted (see sc::lazy_size).
+        size_t size( void ) const
+        {
+            if (lazy_length and m_len_stale) {
+                m_len = 0;
+                for (const NodeBase * node = sentinel()->next; node != sentinel(); node = node->next) ++m_len;
+                m_len_stale = false;
+            }
+            return m_len;
+        }
         
         //!=== [IV] Modifiers
         ///* Remove all elements from the container.
         void clear()
         {
             // In an empty list we don't need to clear nothing.
-            if (m_len > 0) {
-                Node * temp1 = m_head->next;
+            if (not empty()) {
+                NodeBase * temp1 = sentinel()->next;
                 // Clean all nodes until it reaches the tail node.
-                while (temp1 != m_tail) {
-                    Node * temp2 = temp1->next;
-                    delete temp1;
+                while (temp1 != sentinel()) {
+                    NodeBase * temp2 = temp1->next;
+                    destroy_node( temp1 );
                     temp1 = temp2;
                 }
-                m_len = 0;
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
+                this->reset_sentinel();
             }
         }
         
         ///* Returns the object at the beginning of the list.
-        T front( void )
+        T & front( void )
         {
             // I can not return an element of an empty list.
             if (empty())
                 throw std::length_error("[list::front()]: empty list.");
             // There is at least one element in the list.
-            Node * temp = m_head->next;
-            return temp->data;
+            NodeBase * temp = sentinel()->next;
+            return data_of(temp);
         }
-        T front( void ) const 
+        const T & front( void ) const 
         {
             // I can not return an element of an empty list.
             if (empty())
                 throw std::length_error("[list::front()]: empty list.");
             // There is at least one element in the list.
-            Node * temp = m_head->next;
-            return temp->data;
+            NodeBase * temp = sentinel()->next;
+            return data_of(temp);
         }
 
         ///* Returns the object at the end of the list.
-        T back( void )
+        T & back( void )
         { 
             // I can not return an element of an empty list.
             if (empty())
                 throw std::length_error("[list::back()]: empty list.");
             // There is at least one element in the list.
-            Node * temp = m_tail->prev;
-            return temp->data;
+            NodeBase * temp = sentinel()->prev;
+            return data_of(temp);
         }
-        T back( void ) const 
+        const T & back( void ) const 
         { 
             // I can not return an element of an empty list.
             if (empty())
                 throw std::length_error("[list::back()]: empty list.");
             // There is at least one element in the list.
-            Node * temp = m_tail->prev;
-            return temp->data;
+            NodeBase * temp = sentinel()->prev;
+            return data_of(temp);
         }
 
         ///* Adds 'value' to the front of the list.
@@ -639,122 +897,91 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
         {
             this->insert(this->begin(), value_);
         }
+        ///* Moves 'value' to the front of the list.
+        void push_front( T && value_ )
+        {
+            this->insert(this->begin(), std::move(value_));
+        }
         
         ///* Adds 'value' to the end of the list.
         void push_back( const T & value_ )
         {
             this->insert(this->end(), value_);
         }
+        ///* Moves 'value' to the end of the list.
+        void push_back( T && value_ )
+        {
+            this->insert(this->end(), std::move(value_));
+        }
+
+        ///* Constructs an element in place, from 'args_', at the front of the list.
+        template < typename... Args >
+        T & emplace_front( Args&&... args_ )
+        {
+            return *this->emplace(this->begin(), std::forward<Args>(args_)...);
+        }
+
+        ///* Constructs an element in place, from 'args_', at the end of the list.
+        template < typename... Args >
+        T & emplace_back( Args&&... args_ )
+        {
+            return *this->emplace(this->end(), std::forward<Args>(args_)...);
+        }
 
         ///* Removes the object at the front of the list.
         void pop_front( void )
         {
-            Node * rem_node = m_head->next; //< Store the element that will be removed.
-            Node * new_front = rem_node->next; //< Store the element that will be the new front.
+            NodeBase * rem_node = sentinel()->next; //< Store the element that will be removed.
+            NodeBase * new_front = rem_node->next; //< Store the element that will be the new front.
             // Relink the nodes.
-            m_head->next = new_front;
-            new_front->prev = m_head;
+            sentinel()->next = new_front;
+            new_front->prev = sentinel();
             // Release memory.
-            delete rem_node;
+            destroy_node( rem_node );
             m_len--;
         }
 
         ///* Removes the object at the end of the list.
         void pop_back( void )
         {
-            Node * rem_node = m_tail->prev; //< Store the element that will be removed.
-            Node * new_back = rem_node->prev; //< Store the element that will be the new back.
+            NodeBase * rem_node = sentinel()->prev; //< Store the element that will be removed.
+            NodeBase * new_back = rem_node->prev; //< Store the element that will be the new back.
             // Relink the nodes.
-            m_tail->prev = new_back;
-            new_back->next = m_tail;
+            sentinel()->prev = new_back;
+            new_back->next = sentinel();
             // Release memory.
-            delete rem_node;
+            destroy_node( rem_node );
             m_len--;
         }
 
+        ///* Exchanges the contents of the list with those of 'other' in O(1).
+        ///* Iterators remain valid, but refer to elements of the other list.
+        void swap( list & other ) noexcept
+        {
+            if (node_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap( m_alloc, other.m_alloc );
+            }
+            this->swap_nodes( other );
+        }
+
         //!=== [IV-a] MODIFIERS W/ ITERATORS
         ///* Replaces the contents of the list 
         ///* with copies of the elements in the range [first; last).
+        ///* The existing elements are overwritten in order, then the surplus is erased or the rest
+        ///* is appended, so only the size difference is allocated or released. Any input iterator
+        ///* will do. For forward iterators the new nodes are built before anything is overwritten:
+        ///* if T's copy assignment does not throw, the list is left untouched on exception.
         template < class InItr >
         void assign( InItr first_, InItr last_ )
         {
-            size_t sz = last_ - first_;
-            // Se a lista (this) for maior, precisar remover os nós excedentes.
-            if (m_len > sz) {
-                // Removes surplus nodes
-                for (size_t i{sz}; i < m_len; i++) {
-                    this->pop_back();
-                }
-            }
-            // The range is not empty.
-            if (sz > 0) {
-                Node * prev_node = m_head;
-                for (size_t i{0}; i < m_len; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == m_len - 1) {
-                        temp->next = m_tail;
-                    }
-                    temp->prev = prev_node;
-                    temp->data = *(first_+i); // Set the value/data of node.
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-                // Se a lista (this) for menor, precisa acrescentar mais nós.
-                if (m_len < sz) {
-                    // Add the values that did not fit the list size.
-                    // While having elements missing to add, give a 'push_back' with the value of the position element.
-                    for (size_t i{m_len}; i < sz; i++) {
-                        this->push_back( *(first_+i) );
-                    }
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
-            }
-            m_len = sz; // Set size of list.
+            this->assign_range( first_, last_, typename std::iterator_traits< InItr >::iterator_category() );
         }
         ///* Replaces the contents of the list
         ///* with copies of the elements in the initializer_list 'ilist_'.
         void assign( std::initializer_list<T> ilist_ )
         {
-            size_t sz = ilist_.size();
-            // Se a lista (this) for maior, precisar remover os nós excedentes.
-            if (m_len > sz) {
-                // Removes surplus nodes
-                for (size_t i{sz}; i < m_len; i++) {
-                    this->pop_back();
-                }
-            }
-            // The range is not empty.
-            if (sz > 0) {
-                Node * prev_node = m_head;
-                for (size_t i{0}; i < m_len; i++) {
-                    Node * temp = new Node();
-                    // The last node in the list before the tail.
-                    if (i == m_len - 1) {
-                        temp->next = m_tail;
-                    }
-                    temp->prev = prev_node;
-                    temp->data = *(ilist_.begin()+i); // Set the value/data of node.
-                    prev_node->next = temp;
-                    prev_node = prev_node->next;
-                }
-                // Se a lista (this) for menor, precisa acrescentar mais nós.
-                if (m_len < sz) {
-                    // Add the values that did not fit the list size.
-                    // While having elements missing to add, give a 'push_back' with the value of the position element.
-                    for (size_t i{m_len}; i < sz; i++) {
-                        this->push_back( *(ilist_.begin()+i) );
-                    }
-                }
-            }
-            else {
-                m_head->next = m_tail;
-                m_tail->prev = m_head;
-            }
-            m_len = sz; // Set size of list.
+            this->assign( ilist_.begin(), ilist_.end() );
         }
 
         /*!
@@ -765,12 +992,34 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  \param value_ The value we want to insert in the list.
          *  \return An iterator to the new element in the list.
          */
-        iterator insert( iterator pos_, const T & value_ ){
-            Node * new_node = new Node(value_, pos_.m_ptr, pos_.m_ptr->prev); // Inicializa novo nó com o valor passado e com os links para o próximo nó e para o nó anterior.
-            (pos_.m_ptr->prev)->next = new_node;    // Faz o next do anterior apontar para o novo nó.
-            pos_.m_ptr->prev = new_node;            // Faz o prev do seguinte apontar para o novo nó.
-            this->m_len++;
-            return iterator{new_node};              // Retorna iterador apontando para o novo nó.
+        iterator insert( const_iterator pos_, const T & value_ ){
+            return this->emplace(pos_, value_);
+        }
+
+        /*!
+         *  Inserts a new value in the list before the iterator 'it', moving it
+         *  into the new node, and returns an iterator to the new node.
+         *
+         *  \param pos_ An iterator to the position before which we want to insert the new data.
+         *  \param value_ The value we want to move into the list.
+         *  \return An iterator to the new element in the list.
+         */
+        iterator insert( const_iterator pos_, T && value_ ){
+            return this->emplace(pos_, std::move(value_));
+        }
+
+        /*!
+         *  Constructs a new element in place, from 'args_', before the iterator 'pos_'.
+         *  No temporary T is created, copied or moved.
+         *
+         *  \param pos_ An iterator to the position before which we want to insert the new data.
+         *  \param args_ Arguments forwarded to the constructor of T.
+         *  \return An iterator to the new element in the list.
+         */
+        template < typename... Args >
+        iterator emplace( const_iterator pos_, Args&&... args_ ){
+            NodeBase * new_node = create_node(std::forward<Args>(args_)...); // Constrói o valor diretamente no novo nó.
+            return iterator{ link_before(pos_.m_ptr, new_node) };           // Retorna iterador apontando para o novo nó.
         }
 
         /*! Insere elementos do range [first_, last_) na lista antes da posição apontada pelo iterador pos_.
@@ -780,13 +1029,8 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  @return Iterador apontando para a posição do primeiro elemento inserido do range.
          */
         template < typename InItr >
-        iterator insert( iterator pos_, InItr first_, InItr last_ ) {
-            Node * prev_node = pos_.m_ptr->prev; // Armazena o endereço do nó anterior ao pos_ antes das inserções de novos nós.
-            while(first_ != last_){
-                this->insert(pos_, *first_);      // Insere nó antes de pos_.
-                first_++;                        // Vai para próximo elemento a ser inserido, se houver.
-            }
-            return iterator{prev_node->next};    // Retorna iterador para o primeiro nó inserido.
+        iterator insert( const_iterator pos_, InItr first_, InItr last_ ) {
+            return this->insert_range( pos_, first_, last_ );
         }
         
         /*! Insere elementos da lista de inicialização ilist_ antes da posição apontada pelo iterador pos_.
@@ -794,15 +1038,30 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  @param ilist_ Lista de inicialização a ser inserida.
          *  @return Iterador apontando para a posição do primeiro elemento inserido da lista de inicialização.
          */
-        iterator insert( iterator cpos_, std::initializer_list<T> ilist_ ){
-            Node * prev_node = cpos_.m_ptr->prev; // Armazena o endereço do nó anterior ao cpos_ antes das inserções de novos nós.
-            auto first_ = ilist_.begin();
-            auto last_ = ilist_.end();
-            while(first_ != last_){
-                this->insert(cpos_, *first_);      // Insere nó antes de cpos_.
-                first_++;                        // Vai para próximo elemento a ser inserido, se houver.
-            }
-            return iterator{prev_node->next};    // Retorna iterador para o primeiro nó inserido.
+        iterator insert( const_iterator cpos_, std::initializer_list<T> ilist_ ){
+            return this->insert_range( cpos_, ilist_.begin(), ilist_.end() );
+        }
+
+        /*! Inserts copies of the elements of [first_, last_) before 'pos_'.
+         *  The new nodes, each allocated on its own and constructed in place from the range, are
+         *  chained off-list and linked in with one splice, so the size is updated once and, if
+         *  copying an element throws, the list is left untouched.
+         *  @return Iterator to the first element inserted, or to 'pos_' if the range is empty.
+         */
+        template < typename InItr >
+        iterator insert_range( const_iterator pos_, InItr first_, InItr last_ ){
+            list segment( get_allocator() );
+            for ( ; first_ != last_; ++first_)             // Se lançar, segment libera os nós já criados.
+                segment.link_before( segment.sentinel(), segment.create_node( *first_ ) );
+            NodeBase * first = segment.empty() ? pos_.m_ptr : segment.sentinel()->next;
+            this->splice( pos_, segment );
+            return iterator{ first };
+        }
+
+        ///* Appends copies of the elements of [first_, last_) to the end of the list (see insert_range()).
+        template < typename InItr >
+        void push_back_range( InItr first_, InItr last_ ){
+            this->insert_range( this->cend(), first_, last_ );
         }
 
         /*!
@@ -812,19 +1071,19 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  \param it_ The node we wish to delete.
          *  \return An iterator to the node following the deleted node.
          */
-        iterator erase( iterator it_ )
+        iterator erase( const_iterator it_ )
         {
-            Node * rem_node = it_.m_ptr;
+            NodeBase * rem_node = it_.m_ptr;
             // auto ite2 = 
             // auto ret_node{it_++};
-            Node * prev_node = rem_node->prev;
-            Node * next_node = rem_node->next;
+            NodeBase * prev_node = rem_node->prev;
+            NodeBase * next_node = rem_node->next;
             // Relink the nodes.
             prev_node->next = next_node;
             next_node->prev = prev_node;
             // iterator ite = next_node;
             // Release memory.
-            delete rem_node;
+            destroy_node( rem_node );
             m_len--;
             return iterator{next_node};
         }
@@ -834,23 +1093,84 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  @param end Iterador apontando para a posição logo após o último elemento do range.
          *  @return Iterador apontando para a nova posição do elemento seguinte ao último elemento apagado.
          */
-        iterator erase( iterator start, iterator end )
+        iterator erase( const_iterator start, const_iterator end )
         {
-            iterator it_rem{start};
-            iterator it_ret;
-            while (start != end) {
-                start++;
-                it_ret = erase(it_rem);
-                it_rem = start;
+            if (start == end) return iterator{end.m_ptr};
+            NodeBase * node = start.m_ptr;
+            (node->prev)->next = end.m_ptr;     // Desliga o range inteiro de uma só vez...
+            end.m_ptr->prev = node->prev;
+            while (node != end.m_ptr) {         // ... e só então libera os nós.
+                NodeBase * next = node->next;
+                destroy_node( node );
+                m_len--;
+                node = next;
             }
-            return iterator{it_ret};
+            return iterator{end.m_ptr};
+        }
+
+        /*! Unlinks the element at 'pos_' and returns it in a node handle, with no copy and no allocation.
+         *  @param pos_ Iterator to the element to extract.
+         *  @return A handle that owns the element.
+         */
+        node_type extract( const_iterator pos_ ) noexcept
+        {
+            NodeBase * node = pos_.m_ptr;
+            algorithms::unlink( node );
+            m_len--;
+            return node_type{ node, m_alloc };
+        }
+
+        /*! Links the node held by 'node_' before 'pos_', with no copy; 'node_' is left empty.
+         *  The handle must come from a list with an equal allocator.
+         *  @return Iterator to the inserted element, or 'pos_' if the handle was empty.
+         */
+        iterator insert( const_iterator pos_, node_type && node_ ) noexcept
+        {
+            if (node_.empty()) return iterator{ pos_.m_ptr };
+            return iterator{ link_before( pos_.m_ptr, node_.release() ) };
         }
 
+        //!=== [IV-b] LOOKUP
+        /*! Searches the list for the first element equal to 'value_'.
+         *  For arithmetic types the list is scanned from both ends at once (see find_node()).
+         *  @param value_ The value to search for.
+         *  @return Iterator to the first element equal to 'value_', or cend() if there is none.
+         */
         const_iterator find( const T & value_ ) const
-        { /* TODO */ return const_iterator{}; }
+        { return const_iterator{ find_node( value_, std::is_arithmetic<T>{} ) }; }
 
+        /// Same as find( value_ ) const, returning a mutable iterator.
         iterator find( const T & value_ )
-        { /* TODO */ return iterator{}; }
+        { return iterator{ find_node( value_, std::is_arithmetic<T>{} ) }; }
+
+        /*! Searches the list for the first element for which 'pred_' returns true.
+         *  @param pred_ Unary predicate.
+         *  @return Iterator to the first element that satisfies 'pred_', or cend() if there is none.
+         */
+        template < typename UnaryPredicate >
+        const_iterator find_if( UnaryPredicate pred_ ) const
+        {
+            NodeBase * node = sentinel()->next;
+            while (node != sentinel() and not pred_( data_of(node) )) node = node->next;
+            return const_iterator{ node };
+        }
+
+        /// Same as find_if( pred_ ) const, returning a mutable iterator.
+        template < typename UnaryPredicate >
+        iterator find_if( UnaryPredicate pred_ )
+        {
+            NodeBase * node = sentinel()->next;
+            while (node != sentinel() and not pred_( data_of(node) )) node = node->next;
+            return iterator{ node };
+        }
+
+        ///* Checks whether there is an element equal to 'value_' in the list.
+        bool contains( const T & value_ ) const
+        { return find_node( value_, std::is_arithmetic<T>{} ) != sentinel(); }
+
+        ///* Returns the number of elements equal to 'value_'.
+        size_t count( const T & value_ ) const
+        { return count_nodes( value_, std::is_arithmetic<T>{} ); }
 
         //!=== [V] UTILITY METHODS
         
@@ -859,117 +1179,643 @@ namespace sc { // linear sequence. Better name: sequence container (same as STL)
          *  The container other becomes empty after the operation.
          *  @param other Another container to transfer the content from.
          */
-        void merge( list & other ){
-            if(other.empty()) return;
-            auto current = this->begin();                   // Primeiro nó válido de this.
-            auto last = this->end();                        // Nó calda de this.
-            auto other_current = other.begin();             // Primeiro nó válido de other.
-            auto other_last = other.end();                  // Nó calda de other.
-            auto other_next{other_current+1};               // Iterador auxiliar apontando para o nó seguinte de other.
-            while(other_current != other_last && current != last){
-                if(*other_current < *current){
-                    (current.m_ptr->prev)->next = other_current.m_ptr;      // Faz o next do nó anterior ao atual apontar para o nó de other.
-                    other_current.m_ptr->prev = current.m_ptr->prev;        // Faz o prev do nó de other apontar para o nó anterior ao atual.
-                    other_current.m_ptr->next = current.m_ptr;              // Faz o next do nó de other apontar para o nó atual.
-                    current.m_ptr->prev = other_current.m_ptr;              // Faz o prev do nó atual apontar para o nó de other.
-                    other_current = other_next;                             // O nó atual de other passa a ser o próximo.
-                    other_next++;
-                }
-                else current++;                                             // Vai para o próximo nó de this.
-            }
+        void merge( list & other ){ this->merge( other, std::less<T>() ); }
 
-            // Versão alternativa do if acima.
-            if(other_current != other_last){
-                (m_tail->prev)->next = other_current.m_ptr;             // Faz o next do último nó válido de this apontar para o nó atual de other.
-                other_current.m_ptr->prev = m_tail->prev;               // Faz o prev do nó atual de other apontar para o último nó válido de this.
-                (other.m_tail->prev)->next = m_tail;                    // Faz o next do último nó válido de other apontar para o nó calda de this.
-                m_tail->prev = other.m_tail->prev;                      // Faz o prev do nó calda de this apontar para o último nó válido de other.
-            }
-
-            this->m_len += other.size();                // Atualiza o tamanho da lista.
-            other.m_head->next = other.m_tail;          // Faz o next do head de other apontar para o tail de other.  
-            other.m_tail->prev = other.m_head;          // Faz o prev do tail de other apontar para o head de other.
+        /*! This method merges the two lists into one, using 'comp' to compare the elements.
+         *  Both lists should be sorted with respect to 'comp'. The merge is stable: for
+         *  equivalent elements, those from *this precede those from other.
+         *  No element is copied; the nodes of other are relinked into *this, so the allocators
+         *  must compare equal (e.g. two default-constructed sc::pool_allocator do not).
+         *  @param other Another container to transfer the content from.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         */
+        template < typename Compare >
+        void merge( list & other, Compare comp ){
+            if(other.empty() or this == &other) return;
+            assert( m_alloc == other.m_alloc );         // Os nós de other serão liberados pelo alocador de *this.
+            this->m_len += other.m_len;                 // Atualiza o tamanho da lista...
+            this->m_len_stale |= other.m_len_stale;     // ... que continua desconhecido se o de other era.
             other.m_len = 0;                            // Atualiza o tamanho de other.
+            other.m_len_stale = false;
+            algorithms::merge( sentinel(), other.sentinel(), comp );
         }
 
         /*! This method transfers all elements from other into *this.
          *  The elements are inserted before the element pointed to by pos.
          *  The container other becomes empty after the operation.
-         *  The behavior is undefined if other refers to the same object as *this.
+         *  The behavior is undefined if other refers to the same object as *this, or if the
+         *  allocators do not compare equal.
          *  @param pos Iterator pointing to the element before which the content will be inserted.
          *  @param other Another container to transfer the content from.
          */
         void splice( const_iterator pos, list & other ){
             if(other.empty()) return;
-            auto first = other.begin();                 // Primeiro nó válido de other.
-            auto other_last = other.end()-1;            // Último nó válido de other.
-            (pos.m_ptr->prev)->next = first.m_ptr;      // Faz o next do nó anterior ao pos apontar para o primeiro nó de other.
-            first.m_ptr->prev = pos.m_ptr->prev;        // Faz o prev do primeiro nó de other apontar para o nó anterior ao pos.
-            other_last.m_ptr->next = pos.m_ptr;         // Faz o next do último nó de other apontar para pos.
-            pos.m_ptr->prev = other_last.m_ptr;         // Faz o prev de pos apontar para o último nó de other.
-            this->m_len += other.size();                // Atualiza o tamanho da lista.
-            other.m_head->next = other.m_tail;          // Faz o next do head de other apontar para o tail de other.  
-            other.m_tail->prev = other.m_head;          // Faz o prev do tail de other apontar para o head de other.
-            other.m_len = 0;                            // Atualiza o tamanho de other.
+            assert( this != &other and m_alloc == other.m_alloc );
+            algorithms::transfer( pos.m_ptr, other.sentinel()->next, other.sentinel()->prev );
+            this->m_len += other.m_len;                 // Atualiza o tamanho da lista.
+            this->m_len_stale |= other.m_len_stale;
+            other.reset_sentinel();                     // Other fica vazia (sentinela ligada a si mesma).
+        }
+
+        /*! This method transfers the element pointed to by 'it' from other into *this, before
+         *  pos. other may be *this; otherwise the allocators must compare equal. No element is
+         *  copied and nothing is allocated.
+         *  @param pos Iterator pointing to the element before which the element will be inserted.
+         *  @param other The list that holds the element.
+         *  @param it Iterator pointing to the element to transfer.
+         */
+        void splice( const_iterator pos, list & other, const_iterator it ) noexcept {
+            NodeBase * node = it.m_ptr;
+            if(this == &other){
+                if(node == pos.m_ptr or node->next == pos.m_ptr) return;   // Já está no lugar.
+                algorithms::unlink( node );
+                algorithms::link_before( pos.m_ptr, node );
+                return;
+            }
+            assert( m_alloc == other.m_alloc );
+            algorithms::unlink( node );
+            other.m_len--;
+            link_before( pos.m_ptr, node );
+        }
+
+        /*! This method transfers the elements in [first, last) from other into *this, before
+         *  pos. other may be *this, as long as pos is not in [first, last); then the nodes are
+         *  relinked in O(1). Between two lists the range is walked once, to count its nodes,
+         *  unless the list uses sc::lazy_size: then it is O(1) too and both sizes are counted later.
+         *  Between two lists, the allocators must compare equal.
+         *  @param pos Iterator pointing to the element before which the elements will be inserted.
+         *  @param other The list that holds the elements.
+         *  @param first Iterator pointing to the first element to transfer.
+         *  @param last Iterator pointing just past the last element to transfer.
+         */
+        void splice( const_iterator pos, list & other, const_iterator first, const_iterator last ) noexcept {
+            if(first == last or pos == last) return;
+            NodeBase * head = first.m_ptr;
+            NodeBase * tail = last.m_ptr->prev;
+            if(this != &other){
+                assert( m_alloc == other.m_alloc );
+                if(lazy_length) m_len_stale = other.m_len_stale = true;   // O(1): o tamanho será contado depois.
+                else {
+                    size_t count{1};
+                    for(NodeBase * node = head; node != tail; node = node->next) ++count;
+                    other.m_len -= count;
+                    this->m_len += count;
+                }
+            }
+            (head->prev)->next = last.m_ptr;            // Desliga o range de other...
+            last.m_ptr->prev = head->prev;
+            algorithms::transfer( pos.m_ptr, head, tail ); // ... e o liga antes de pos.
         }
 
         /*! This method reverses the order of the elements in the container.
          */
         void reverse( void ){
-            if(m_len <= 1) return;                      // Se a lista tiver um ou menos nós válidos retorne.
-            auto first_node = this->begin();            // Primeiro nó válido da lista.
-            auto last_node = this->end()-1;             // Último nó válido da lista.
-            auto current_node{first_node};              // Iterador para o nó atual.
-            Node * new_next{m_tail};                    // Variável auxiliar para armazenar o endereço do nó que será agora o seguinte.
-            while(current_node != last_node){
-                current_node.m_ptr->prev = current_node.m_ptr->next;    // Faz o prev do nó atual apontar para o antigo nó seguinte, que agora será o nó anterior.
-                current_node.m_ptr->next = new_next;                    // Faz o next do nó atual apontar para o novo nó seguinte.
-                new_next = current_node.m_ptr;                          // O nó atual será o novo nó seguinte do novo nó anterior.
-                current_node--;
-            }
-            last_node.m_ptr->prev = m_head;             // Faz o prev do antigo último nó, novo primeiro nó, apontar para o head.
-            last_node.m_ptr->next = new_next;           // Faz o next do antigo último nó, novo primeiro nó, apontar para o novo nó seguinte.
-            m_head->next = last_node.m_ptr;             // Faz o next do head apontar para o novo primeiro nó.
-            m_tail->prev = first_node.m_ptr;            // Faz o prev do tail apontar para o novo último nó.
+            if(sentinel()->next == sentinel()->prev) return;                      // Se a lista tiver um ou menos nós válidos retorne.
+            algorithms::reverse( sentinel() );          // Troca next e prev de cada nó (e do sentinela).
+        }
+
+        /*! This method removes all elements equal to 'value_' (see remove_if()).
+         *  'value_' may be an element of the list: its node is released last.
+         *  @return The number of elements removed.
+         */
+        size_t remove( const T & value_ ){
+            NodeBase * aliased{nullptr};
+            auto matches = [&]( NodeBase * node ){
+                if (&data_of(node) == &value_) { aliased = node; return false; }
+                return data_of(node) == value_;
+            };
+            size_t removed = algorithms::remove_nodes( sentinel(), matches, [this]( NodeBase * node ){ destroy_node( node ); m_len--; } );
+            if (aliased == nullptr) return removed;
+            algorithms::unlink( aliased );
+            destroy_node( aliased );
+            m_len--;
+            return removed + 1;
+        }
+
+        /*! This method removes all elements for which 'pred' returns true, in a single pass:
+         *  each run of consecutive matches is unlinked with one relink and then released.
+         *  If 'pred' throws, the elements already removed stay removed.
+         *  @param pred Unary predicate that returns true for the elements to be removed.
+         *  @return The number of elements removed.
+         */
+        template < typename UnaryPredicate >
+        size_t remove_if( UnaryPredicate pred ){
+            return algorithms::remove_if( sentinel(), pred, [this]( NodeBase * node ){ destroy_node( node ); m_len--; } );
         }
 
         //! This method removes all consecutive duplicate elements from the container.
-        void unique( void ){
-            auto first = this->begin();
-            auto last = this->end();
-            auto next{first};
-            while(first != last){
-                next = first+1;
-                if(first.m_ptr->data == next.m_ptr->data) next = this->erase(next);
-                else first++;
+        void unique( void ){ this->unique( std::equal_to<T>() ); }
+
+        /*! This method removes all consecutive elements for which 'pred' returns true
+         *  when applied to the element kept before it and to the element itself.
+         *  @param pred Binary predicate that returns true if the elements are equivalent.
+         */
+        template < typename BinaryPredicate >
+        void unique( BinaryPredicate pred ){
+            algorithms::unique( sentinel(), pred, [this]( NodeBase * node ){ destroy_node( node ); m_len--; } );
+        }
+
+        /*! This method sorts the elements in ascending order.
+         *  The sort is stable and only relinks the nodes, so iterators remain valid.
+         */
+        void sort( void ){ this->sort( std::less<T>() ); }
+
+        /*! This method sorts the elements using 'comp' to compare them.
+         *
+         *  Bottom-up merge sort: single nodes are pushed into an array of bins, where
+         *  bin i holds a sorted run of 2^i nodes, like a binary counter. Each carry merges
+         *  two runs with the same relinking routine used by merge(). It runs in O(n log n),
+         *  it is stable, and it neither copies nor allocates any element.
+         *  If 'comp' throws, every element is kept in the list, in unspecified order.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         */
+        template < typename Compare >
+        void sort( Compare comp ){
+            if(sentinel()->next == sentinel()->prev) return;
+            sort_nodes( comp, radix_order< Compare >() );
+        }
+
+        /*! This method sorts the elements in ascending order of 'key_fn( element )', which
+         *  must be an integral or floating point number (NaN excluded).
+         *
+         *  LSD radix sort over the bytes of the key (11-bit digits on long lists): each pass
+         *  distributes the nodes into buckets by relinking them, so it runs in O(n) per digit
+         *  in which the keys differ, never compares two elements and neither copies nor allocates any. Like
+         *  sort(), it is stable and iterators remain valid. sort() and sort( std::less<T>() )
+         *  (or std::greater<T>) already use it when T is arithmetic and the list is long enough.
+         *  If 'key_fn' throws, every element is kept in the list, in unspecified order.
+         *  @param key_fn Function that returns the key of an element.
+         */
+        template < typename KeyFn >
+        void sort_by_radix( KeyFn key_fn ){
+            using key_type = typename std::decay< decltype( key_fn( std::declval< const T & >() ) ) >::type;
+            static_assert( sc::detail::is_radix_key< key_type >::value, "sort_by_radix: the key must be an integral or floating point number" );
+            auto key_of = [&]( const T & value ){ return sc::detail::radix_key< key_type >::of( key_fn( value ) ); };
+            radix_sort_nodes( key_of );
+        }
+
+        /// Same as sort(), run on the calling thread.
+        void sort( const sc::execution::sequenced_policy & ){ this->sort( std::less<T>() ); }
+
+        /// Same as sort( comp ), run on the calling thread.
+        template < typename Compare >
+        void sort( const sc::execution::sequenced_policy &, Compare comp ){ this->sort( comp ); }
+
+        /// Same as sort( policy, std::less<T>() ).
+        void sort( const sc::execution::parallel_policy & policy ){ this->sort( policy, std::less<T>() ); }
+
+        /*! This method sorts the elements using 'comp' on several threads.
+         *
+         *  The list is cut into one run per thread, the runs are sorted concurrently with
+         *  the sequential algorithm (the radix sort, where sort( comp ) uses it) and then merged pairwise, level by level. Each pairwise
+         *  merge is itself split into independent slices: splitter nodes taken from one run
+         *  are located in the other one (by binary search over a few marked nodes), so all
+         *  threads keep working up to the last level. Like sort(), it is stable, it only
+         *  relinks nodes and it does not copy any element.
+         *
+         *  Lists shorter than 'parallel_sort_grain' nodes per thread are sorted sequentially.
+         *  'comp' is copied into every thread; if it throws, std::terminate() is called.
+         *  @param policy The maximum number of threads to use.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         */
+        template < typename Compare >
+        void sort( const sc::execution::parallel_policy & policy, Compare comp ){
+            const size_t len = size();
+            size_t n_threads = std::min< size_t >( policy.concurrency(), len / parallel_sort_grain );
+            if(n_threads <= 1) { this->sort( comp ); return; }
+            const size_t step = std::max< size_t >( 1, len / ( n_threads * 64 ) ); // Distância entre as marcas.
+
+            // [1] Corta a lista em n_threads sequências de tamanhos (quase) iguais.
+            std::vector< Run > runs( n_threads );
+            NodeBase * current = algorithms::detach_chain( sentinel() );
+            for(size_t i{0}; i < n_threads; ++i){
+                size_t run_len = len / n_threads + (i < len % n_threads ? 1 : 0);
+                NodeBase * last{current};
+                for(size_t j{1}; j < run_len; ++j) last = last->next;
+                runs[i].first = current;
+                runs[i].len = run_len;
+                current = last->next;
+                last->next = nullptr;
+            }
+
+            // [2] Ordena cada sequência numa thread, como sort( comp ) faria, marcando um nó a cada 'step'.
+            sc::execution::parallel_for( runs.size(), n_threads, [&]( size_t i ){
+                Compare c( comp );
+                sort_run( runs[i].first, runs[i].len, c, radix_order< Compare >() );
+                mark_run( runs[i], step );
+            } );
+
+            // [3] Funde as sequências duas a duas, cada fusão dividida em fatias independentes.
+            while(runs.size() > 1){
+                size_t pairs = runs.size() / 2;
+                size_t n_slices = std::max< size_t >( 1, ( 2 * n_threads + pairs - 1 ) / pairs );
+                std::vector< Slice > slices;
+                for(size_t p{0}; p < pairs; ++p)
+                    plan_slices( runs[2*p], runs[2*p+1], p, n_slices, slices );
+
+                // Localiza, em paralelo, o início de cada fatia na sequência que não forneceu o separador.
+                sc::execution::parallel_for( slices.size(), n_threads, [&]( size_t i ){
+                    Compare c( comp );
+                    locate_slice( slices[i], c );
+                } );
+                cut_slices( slices );
+                // Funde as fatias em paralelo; os links prev são refeitos durante a fusão.
+                sc::execution::parallel_for( slices.size(), n_threads, [&]( size_t i ){
+                    Compare c( comp );
+                    merge_slice( slices[i], c, step );
+                } );
+
+                // Costura as fatias de cada par numa nova sequência.
+                std::vector< Run > merged( pairs + runs.size() % 2 );
+                for(size_t p{0}; p < pairs; ++p)
+                    merged[p].len = runs[2*p].len + runs[2*p+1].len;
+                NodeBase * last{nullptr};
+                for(auto & sl : slices){
+                    Run & r = merged[sl.pair];
+                    if(r.first == nullptr) r.first = sl.first;
+                    else { last->next = sl.first; sl.first->prev = last; }
+                    last = sl.last;
+                    r.marks.insert( r.marks.end(), sl.marks.begin(), sl.marks.end() );
+                }
+                if(runs.size() % 2 == 1) merged.back() = std::move( runs.back() );
+                runs = std::move( merged );
+            }
+
+            // [4] Religa a sequência final entre head e tail (os links prev já foram refeitos).
+            NodeBase * first{runs[0].first};
+            NodeBase * last{runs[0].marks.back()};
+            sentinel()->next = first;
+            first->prev = sentinel();
+            last->next = sentinel();
+            sentinel()->prev = last;
+        }
+
+        /// Same as partial_sort( k, std::less<T>() ).
+        void partial_sort( size_t k ){ this->partial_sort( k, std::less<T>() ); }
+
+        /*! This method moves the 'k' smallest elements, by 'comp', to the front of the list,
+         *  in sorted order; the other elements follow, in unspecified order.
+         *
+         *  Each element is compared with the largest of the k kept so far, and only the
+         *  smaller ones are sorted, in batches of k, and merged into them: O(n log k), and
+         *  about one comparison per element on random input. Like sort(), it is stable, it
+         *  only relinks nodes and iterators remain valid.
+         *  If 'comp' throws, every element is kept in the list, in unspecified order.
+         *  @param k Number of elements to sort; if k >= size(), the whole list is sorted.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         */
+        template < typename Compare >
+        void partial_sort( size_t k, Compare comp ){
+            if(k >= size()) { this->sort( comp ); return; }
+            algorithms::partial_sort( sentinel(), k, comp );
+        }
+
+        /// Same as nth_element( n, std::less<T>() ).
+        iterator nth_element( size_t n ){ return this->nth_element( n, std::less<T>() ); }
+
+        /*! This method puts in position 'n' the element that would be there if the list were
+         *  sorted by 'comp'; no element before it is greater, and no element after it is smaller.
+         *
+         *  Selection by relinking, after Floyd and Rivest: two pivots taken from a sorted
+         *  sample split the nodes into three chains (below, between and above them), and
+         *  only the one that holds position 'n' is split again; short chains fall back to a
+         *  single random pivot. O(n) expected, with about two passes over the list; no
+         *  element is copied and iterators remain valid.
+         *  If 'comp' throws, every element is kept in the list, in unspecified order.
+         *  @param n Position of the element to select.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         *  @return An iterator to the element now in position 'n', or end() if n >= size().
+         */
+        template < typename Compare >
+        iterator nth_element( size_t n, Compare comp ){
+            return iterator{ algorithms::nth_element( sentinel(), size(), n, comp ) };
+        }
+
+    private:
+        //!=== Sort helpers.
+
+        /*! Which radix sort replaces the merge sort for 'Compare': +1 for std::less<T>,
+         *  -1 for std::greater<T> (every key is inverted), 0 for any other comparison.
+         */
+        template < typename Compare >
+        using radix_order = std::integral_constant< int, not sc::detail::is_radix_key<T>::value ? 0
+                                                       : std::is_same< Compare, std::less<T> >::value ? 1
+                                                       : std::is_same< Compare, std::greater<T> >::value ? -1 : 0 >;
+
+        template < typename Compare >
+        void sort_nodes( Compare & comp, std::integral_constant< int, 0 > ){ algorithms::sort( sentinel(), comp ); }
+
+        template < typename Compare, int Order >
+        void sort_nodes( Compare & comp, std::integral_constant< int, Order > order ){
+            const size_t len = size();
+            NodeBase * chain = algorithms::detach_chain( sentinel() );
+            sort_run( chain, len, comp, order );        // std::less e std::greater não lançam sobre aritméticos.
+            algorithms::attach_chain( sentinel(), chain );
+        }
+
+        /*! Sorts a null-terminated chain of 'len' nodes as sort( comp ) sorts the list, so
+         *  sort( par ) sorts each of its runs the same way; only the 'next' links are rewritten.
+         *  If 'comp' throws, 'chain' still holds every node.
+         */
+        template < typename Compare >
+        static void sort_run( NodeBase *& chain, size_t, Compare & comp, std::integral_constant< int, 0 > ){
+            algorithms::sort_chain( chain, comp );
+        }
+
+        template < typename Compare, int Order >
+        static void sort_run( NodeBase *& chain, size_t len, Compare & comp, std::integral_constant< int, Order > ){
+            if(len < radix_sort_threshold) { algorithms::sort_chain( chain, comp ); return; }
+            using key_type = typename sc::detail::radix_key< T >::type;
+            auto key_of = []( const T & value ){
+                key_type key = sc::detail::radix_key< T >::of( value );
+                return Order > 0 ? key : key_type( ~key );
+            };
+            if(len < radix_wide_threshold) algorithms::template radix_sort_chain< 8 >( chain, key_of );
+            else algorithms::template radix_sort_chain< 11 >( chain, key_of );
+        }
+
+        /// Radix sort on bytes, or on 11-bit digits for long lists: 2048 buckets, but a third fewer passes.
+        template < typename KeyOf >
+        void radix_sort_nodes( KeyOf & key_of ){
+            if(size() < radix_wide_threshold) algorithms::template radix_sort< 8 >( sentinel(), key_of );
+            else algorithms::template radix_sort< 11 >( sentinel(), key_of );
+        }
+
+        //!=== Lookup helpers.
+
+        /// Generic linear search: one node (and one branch) per step.
+        NodeBase * find_node( const T & value_, std::false_type ) const
+        {
+            NodeBase * node = sentinel()->next;
+            while (node != sentinel() and not (data_of(node) == value_)) node = node->next;
+            return node;
+        }
+
+        /*! Linear search for arithmetic types.
+         *  A single walk is bound by the latency of loading each 'next' link, which depends on
+         *  the previous one. Here two independent walks run interleaved, one from each end,
+         *  so two loads are in flight per step. The forward walk covers the first half and
+         *  stops at its first hit; the backward walk covers the second half and remembers
+         *  the leftmost hit it has seen, which is the answer if the first half has none.
+         */
+        NodeBase * find_node( const T & value_, std::true_type ) const
+        {
+            const T value{value_};
+            NodeBase * front = sentinel()->next;
+            NodeBase * back = sentinel()->prev;
+            NodeBase * back_hit = sentinel();
+            // As caminhadas param quando se encontram: size() não é usado (com lazy_size, contaria os nós).
+            while (front != back) {
+                if (data_of(front) == value) return front;
+                if (data_of(back) == value) back_hit = back;
+                if (front->next == back) return back_hit;
+                front = front->next;
+                back = back->prev;
+            }
+            // Com tamanho ímpar, o nó do meio ainda não foi visitado (na lista vazia, é o sentinela).
+            if (front != sentinel() and data_of(front) == value) return front;
+            return back_hit;
+        }
+
+        /// Generic count: one node per step.
+        size_t count_nodes( const T & value_, std::false_type ) const
+        {
+            size_t total{0};
+            for (NodeBase * node = sentinel()->next; node != sentinel(); node = node->next)
+                if (data_of(node) == value_) ++total;
+            return total;
+        }
+
+        /// Count for arithmetic types: two interleaved walks, one from each end (see find_node()).
+        size_t count_nodes( const T & value_, std::true_type ) const
+        {
+            const T value{value_};
+            NodeBase * front = sentinel()->next;
+            NodeBase * back = sentinel()->prev;
+            size_t total{0};
+            while (front != back) {
+                total += size_t(data_of(front) == value) + size_t(data_of(back) == value);
+                if (front->next == back) return total;
+                front = front->next;
+                back = back->prev;
+            }
+            if (front != sentinel()) total += size_t(data_of(front) == value);
+            return total;
+        }
+
+        //!=== Parallel sort helpers.
+
+        /// A sorted run: a null-terminated chain plus some marked nodes.
+        struct Run
+        {
+            NodeBase * first{nullptr};      //!< First node of the chain.
+            size_t len{0};              //!< Number of nodes.
+            std::vector< NodeBase * > marks; //!< Last node of each block, in order; the last mark is the last node of the run.
+        };
+
+        /// One independent piece of the merge of runs 'a' and 'b'.
+        struct Slice
+        {
+            size_t pair;                //!< Index of the merged run this slice belongs to.
+            Run * a;                    //!< Earlier run (its nodes go first on ties).
+            Run * b;                    //!< Later run.
+            bool split_a;               //!< Whether the splitter nodes come from 'a' (otherwise, from 'b').
+            NodeBase * split_pred;          //!< Node before the slice in the splitter run (nullptr for the first slice).
+            NodeBase * other_pred;          //!< Node before the slice in the other run (nullptr if the slice starts there).
+            NodeBase * a_part;              //!< Portion of 'a' to be merged (null-terminated after cut_slices()).
+            NodeBase * b_part;              //!< Portion of 'b' to be merged (null-terminated after cut_slices()).
+            NodeBase * first;               //!< First node of the merged slice.
+            NodeBase * last;                //!< Last node of the merged slice.
+            std::vector< NodeBase * > marks; //!< Marked nodes of the merged slice.
+        };
+
+        /// Marks the last node of every block of 'step_' nodes, and the last node of the run.
+        static void mark_run( Run & run_, size_t step_ ){
+            run_.marks.clear();
+            size_t count{0};
+            for(NodeBase * node{run_.first}; node != nullptr; node = node->next)
+                if(++count % step_ == 0 or node->next == nullptr) run_.marks.push_back( node );
+        }
+
+        /// Appends to 'slices_' up to 'n_slices_' slices of the merge of 'a_' and 'b_', split by marks of the longer run.
+        static void plan_slices( Run & a_, Run & b_, size_t pair_, size_t n_slices_, std::vector< Slice > & slices_ ){
+            bool split_a = a_.len >= b_.len;
+            Run & splitter = split_a ? a_ : b_;
+            size_t n_marks = splitter.marks.size();
+            size_t n = std::min( n_slices_, n_marks );
+            for(size_t j{0}; j < n; ++j){
+                Slice sl;
+                sl.pair = pair_;
+                sl.a = &a_;
+                sl.b = &b_;
+                sl.split_a = split_a;
+                // Uma fatia começa logo após uma marca (a última marca nunca é usada: é o fim da sequência).
+                sl.split_pred = j == 0 ? nullptr : splitter.marks[ j * n_marks / n - 1 ];
+                sl.other_pred = nullptr;
+                sl.a_part = sl.b_part = sl.first = sl.last = nullptr;
+                slices_.push_back( std::move( sl ) );
             }
         }
 
-        void sort( void ){ return; }
+        /*! Finds 'other_pred' for a slice: the nodes of the other run before it are those that
+         *  must precede the splitter node in a stable merge.
+         */
+        template < typename Compare >
+        static void locate_slice( Slice & sl_, Compare & comp_ ){
+            if(sl_.split_pred == nullptr) return;
+            const Run & other = sl_.split_a ? *sl_.b : *sl_.a;
+            const T & x = data_of(sl_.split_pred->next);
+            // Nós de b equivalentes ao separador vêm depois dele; nós de a equivalentes, antes.
+            auto goes_before = [&]( const NodeBase * node ){
+                return sl_.split_a ? comp_( data_of(node), x ) : not comp_( x, data_of(node) );
+            };
+            // Busca binária pelo primeiro bloco cuja marca não vem antes do separador...
+            size_t lo{0}, hi{other.marks.size()};
+            while(lo < hi){
+                size_t mid = lo + (hi - lo) / 2;
+                if(goes_before( other.marks[mid] )) lo = mid + 1;
+                else hi = mid;
+            }
+            if(lo == other.marks.size()) { sl_.other_pred = other.marks.back(); return; }
+            // ... e busca linear dentro do bloco.
+            NodeBase * prev = lo == 0 ? nullptr : other.marks[lo-1];
+            NodeBase * node = lo == 0 ? other.first : prev->next;
+            while(goes_before( node )) { prev = node; node = node->next; }
+            sl_.other_pred = prev;
+        }
+
+        /// Computes the parts of every slice and cuts the runs into null-terminated pieces.
+        static void cut_slices( std::vector< Slice > & slices_ ){
+            // Primeiro calcula todos os inícios, antes de cortar qualquer cadeia.
+            std::vector< NodeBase * > split_start( slices_.size() ), other_start( slices_.size() );
+            for(size_t i{0}; i < slices_.size(); ++i){
+                const Slice & sl = slices_[i];
+                const Run & splitter = sl.split_a ? *sl.a : *sl.b;
+                const Run & other = sl.split_a ? *sl.b : *sl.a;
+                split_start[i] = sl.split_pred == nullptr ? splitter.first : sl.split_pred->next;
+                other_start[i] = sl.other_pred == nullptr ? other.first : sl.other_pred->next;
+            }
+            for(size_t i{0}; i < slices_.size(); ++i){
+                Slice & sl = slices_[i];
+                bool last_of_pair = i + 1 == slices_.size() or slices_[i+1].pair != sl.pair;
+                NodeBase * other_end = last_of_pair ? nullptr : other_start[i+1];
+                NodeBase * other_part = other_start[i] == other_end ? nullptr : other_start[i];
+                ( sl.split_a ? sl.a_part : sl.b_part ) = split_start[i];
+                ( sl.split_a ? sl.b_part : sl.a_part ) = other_part;
+            }
+            for(auto & sl : slices_){
+                if(sl.split_pred != nullptr) sl.split_pred->next = nullptr;
+                if(sl.other_pred != nullptr) sl.other_pred->next = nullptr;
+            }
+        }
+
+        /// Merges the two parts of a slice, rebuilding the prev links and marking a node every 'step_'.
+        template < typename Compare >
+        static void merge_slice( Slice & sl_, Compare & comp_, size_t step_ ){
+            NodeBase * a{sl_.a_part};
+            NodeBase * b{sl_.b_part};
+            NodeBase * prev{nullptr};
+            size_t count{0};
+            auto emit = [&]( NodeBase * node ){
+                if(prev == nullptr) sl_.first = node;
+                else prev->next = node;
+                node->prev = prev;
+                prev = node;
+                if(++count % step_ == 0) sl_.marks.push_back( node );
+            };
+            while(a != nullptr and b != nullptr){
+                if(comp_( data_of(b), data_of(a) )) { NodeBase * node{b}; b = b->next; emit( node ); }
+                else { NodeBase * node{a}; a = a->next; emit( node ); }
+            }
+            for( ; a != nullptr; ) { NodeBase * node{a}; a = a->next; emit( node ); }
+            for( ; b != nullptr; ) { NodeBase * node{b}; b = b->next; emit( node ); }
+            prev->next = nullptr;
+            if(sl_.marks.empty() or sl_.marks.back() != prev) sl_.marks.push_back( prev );
+            sl_.last = prev;
+        }
     };
 
     //!=== [VI] OPERATORS
     ///* Checks if the contents of 'l1_' and 'l2_' are equal, that is,
     ///* whether l1_.size() == l2_.size() and each element in 'l1_'
     ///* compares equal with the element in 'l2_' at the same position.
-    template < typename T >
-    inline bool operator==( const sc::list<T> & l1_, const sc::list<T> & l2_ )
+    ///* Both lists are walked once, in lockstep: O(n).
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator==( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
     {
         if (l1_.size() != l2_.size())
-			return false;
-		for (size_t i{0}; i < l1_.size(); i++)
-			if ( *(l1_.cbegin()+i) != *(l2_.cbegin()+i) )
-				return false;
-		return true;
+            return false;
+        auto it1 = l1_.cbegin();
+        auto it2 = l2_.cbegin();
+        for ( ; it1 != l1_.cend(); ++it1, ++it2)
+            if (not (*it1 == *it2))
+                return false;
+        return true;
     }
 
     ///* Similar to the previous operator, but the opposite result.
-    template < typename T >
-    inline bool operator!=( const sc::list<T> & l1_, const sc::list<T> & l2_ )
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator!=( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
     {
         if (not (l1_ == l2_))
 			return true;
 		return false;
     }
+
+    ///* Compares 'l1_' and 'l2_' lexicographically, in a single lockstep pass.
+    ///* The first pair of elements that differ decides; otherwise the shorter list is the lesser.
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator<( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
+    {
+        auto it1 = l1_.cbegin();
+        auto it2 = l2_.cbegin();
+        for ( ; it1 != l1_.cend() and it2 != l2_.cend(); ++it1, ++it2) {
+            if (*it1 < *it2) return true;
+            if (*it2 < *it1) return false;
+        }
+        return it1 == l1_.cend() and it2 != l2_.cend();
+    }
+
+    ///* Checks whether 'l1_' comes after 'l2_' in lexicographical order.
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator>( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
+    {
+        return l2_ < l1_;
+    }
+
+    ///* Checks whether 'l1_' does not come after 'l2_' in lexicographical order.
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator<=( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
+    {
+        return not (l2_ < l1_);
+    }
+
+    ///* Checks whether 'l1_' does not come before 'l2_' in lexicographical order.
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline bool operator>=( const sc::list<T, Alloc, SizePolicy> & l1_, const sc::list<T, Alloc, SizePolicy> & l2_ )
+    {
+        return not (l1_ < l2_);
+    }
+
+    ///* Exchanges the contents of 'l1_' and 'l2_' in O(1).
+    template < typename T, typename Alloc, typename SizePolicy >
+    inline void swap( sc::list<T, Alloc, SizePolicy> & l1_, sc::list<T, Alloc, SizePolicy> & l2_ )
+    {
+        l1_.swap( l2_ );
+    }
+
+    ///* Erases every element of 'l_' equal to 'value_' and returns how many were erased.
+    template < typename T, typename Alloc, typename SizePolicy, typename U >
+    inline size_t erase( sc::list<T, Alloc, SizePolicy> & l_, const U & value_ )
+    {
+        return l_.remove_if( [&]( const T & e ){ return e == value_; } );
+    }
+
+    ///* Erases every element of 'l_' for which 'pred_' returns true and returns how many were erased.
+    template < typename T, typename Alloc, typename SizePolicy, typename UnaryPredicate >
+    inline size_t erase_if( sc::list<T, Alloc, SizePolicy> & l_, UnaryPredicate pred_ )
+    {
+        return l_.remove_if( pred_ );
+    }
 }
 #endif
@@ -0,0 +1,634 @@
+#ifndef _LIST_HOOK_H_
+#define _LIST_HOOK_H_
+
+#include <algorithm> // std::sort, std::min
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <cstring>   // std::memcpy
+#include <limits>    // std::numeric_limits
+#include <type_traits>
+#include <utility>   // std::declval
+
+namespace sc {
+    /*!
+     * The links of a node in a doubly linked list.
+     *
+     * `sc::list` derives its nodes from it, and types stored in an
+     * `sc::intrusive_list` embed one as a member. Copying a hook yields an
+     * unlinked hook, so that copying an element never copies its position.
+     */
+    struct list_hook
+    {
+        list_hook * next;
+        list_hook * prev;
+
+        list_hook( list_hook * next_ = nullptr, list_hook * prev_ = nullptr ) : next{ next_ }, prev{ prev_ }
+        { /* empty */ }
+        list_hook( const list_hook & ) : list_hook() { /* empty */ }
+        list_hook & operator=( const list_hook & ) { return *this; }
+
+        /// Whether the hook is on some list (only meaningful for hooks reset when unlinked).
+        bool is_linked( void ) const { return next != nullptr; }
+    };
+
+    namespace detail {
+        /// Whether keys of type K can be sorted by list_algorithms::radix_sort() (through radix_key).
+        template < typename K >
+        struct is_radix_key : std::integral_constant< bool, std::is_integral<K>::value
+                                                            or std::is_same<K, float>::value
+                                                            or std::is_same<K, double>::value >
+        { };
+
+        /*!
+         * Maps an arithmetic key to an unsigned integer with the same order, so that the
+         * radix sort may look at its bits: the sign bit of a signed integer is flipped, and
+         * a negative float has all its bits flipped (a positive one, only the sign bit).
+         */
+        template < typename K, typename = void >
+        struct radix_key;
+
+        template < typename K >
+        struct radix_key< K, typename std::enable_if< std::is_integral<K>::value and std::is_unsigned<K>::value
+                                                      and not std::is_same<K, bool>::value >::type >
+        {
+            using type = K;
+            static type of( K key_ ) { return key_; }
+        };
+
+        template <>
+        struct radix_key< bool, void >
+        {
+            using type = unsigned char;
+            static type of( bool key_ ) { return key_ ? 1 : 0; }
+        };
+
+        template < typename K >
+        struct radix_key< K, typename std::enable_if< std::is_integral<K>::value and std::is_signed<K>::value >::type >
+        {
+            using type = typename std::make_unsigned<K>::type;
+            static type of( K key_ )
+            { return static_cast< type >( static_cast< type >( key_ ) ^ ( type(1) << ( std::numeric_limits<type>::digits - 1 ) ) ); }
+        };
+
+        template < typename K >
+        struct radix_key< K, typename std::enable_if< std::is_floating_point<K>::value and is_radix_key<K>::value >::type >
+        {
+            static_assert( std::numeric_limits<K>::is_iec559, "radix_key: floating point keys must be IEEE 754" );
+            using type = typename std::conditional< sizeof(K) == 4, std::uint32_t, std::uint64_t >::type;
+            static type of( K key_ )
+            {
+                if (key_ == 0) key_ = 0;                // -0.0 e +0.0 são equivalentes para std::less.
+                type bits;
+                std::memcpy( &bits, &key_, sizeof(bits) );
+                const type sign = type(1) << ( std::numeric_limits<type>::digits - 1 );
+                return ( bits & sign ) ? type( ~bits ) : type( bits | sign );
+            }
+        };
+
+        /*!
+         * Relinking algorithms shared by the lists built on `list_hook`.
+         *
+         * Every list is circular, around a data-less sentinel hook. The algorithms
+         * never allocate, copy or destroy an element; they only rewrite links.
+         * `ValueTraits` maps a hook to its element:
+         *
+         *     struct ValueTraits {
+         *         using value_type = ...;
+         *         static value_type & value_of( list_hook * );
+         *     };
+         */
+        template < typename ValueTraits >
+        struct list_algorithms
+        {
+            using value_type = typename ValueTraits::value_type;
+
+            static value_type & value_of( list_hook * node_ ) { return ValueTraits::value_of( node_ ); }
+
+            /// Links 'node_' right before 'pos_'.
+            static void link_before( list_hook * pos_, list_hook * node_ ){
+                node_->next = pos_;                     // Liga o novo nó ao seguinte...
+                node_->prev = pos_->prev;               // ... e ao anterior.
+                (pos_->prev)->next = node_;             // Faz o next do anterior apontar para o novo nó.
+                pos_->prev = node_;                     // Faz o prev do seguinte apontar para o novo nó.
+            }
+
+            /// Unlinks 'node_' from its neighbours (its own links are left untouched).
+            static void unlink( list_hook * node_ ){
+                (node_->prev)->next = node_->next;
+                (node_->next)->prev = node_->prev;
+            }
+
+            /// Links the chain [first_, last_], already unlinked from wherever it was, right before 'pos_'.
+            static void transfer( list_hook * pos_, list_hook * first_, list_hook * last_ ){
+                (pos_->prev)->next = first_;            // Faz o next do nó anterior ao pos apontar para o primeiro nó.
+                first_->prev = pos_->prev;              // Faz o prev do primeiro nó apontar para o nó anterior ao pos.
+                last_->next = pos_;                     // Faz o next do último nó apontar para pos.
+                pos_->prev = last_;                     // Faz o prev de pos apontar para o último nó.
+            }
+
+            /// Links the sentinel to itself: the list becomes empty.
+            static void reset( list_hook * sentinel_ ){
+                sentinel_->next = sentinel_;
+                sentinel_->prev = sentinel_;
+            }
+
+            /// Exchanges the nodes of two lists, fixing the links to both sentinels.
+            static void swap_nodes( list_hook * a_, list_hook * b_ ){
+                list_hook * a_next{a_->next}, * a_prev{a_->prev};
+                a_->next = b_->next == b_ ? a_ : b_->next;
+                a_->prev = b_->prev == b_ ? a_ : b_->prev;
+                b_->next = a_next == a_ ? b_ : a_next;
+                b_->prev = a_prev == a_ ? b_ : a_prev;
+                a_->next->prev = a_;
+                a_->prev->next = a_;
+                b_->next->prev = b_;
+                b_->prev->next = b_;
+            }
+
+            /// Reverses the order of the nodes by swapping the links of every node (and of the sentinel).
+            static void reverse( list_hook * sentinel_ ){
+                list_hook * node{sentinel_};
+                do {
+                    list_hook * next{node->next};
+                    node->next = node->prev;
+                    node->prev = next;
+                    node = next;                        // O antigo seguinte.
+                } while(node != sentinel_);
+            }
+
+            /*! Unlinks every node equivalent, by 'pred_', to the node kept right before it,
+             *  and hands it over to 'dispose_'.
+             *  @return The number of nodes removed.
+             */
+            template < typename BinaryPredicate, typename Dispose >
+            static std::size_t unique( list_hook * sentinel_, BinaryPredicate & pred_, Dispose dispose_ ){
+                std::size_t removed{0};
+                if(sentinel_->next == sentinel_) return removed;
+                list_hook * kept{sentinel_->next};
+                // O sentinela não guarda valor: a comparação para no último nó válido.
+                for(list_hook * next{kept->next}; next != sentinel_; next = kept->next){
+                    if(pred_(value_of(kept), value_of(next))) { unlink( next ); dispose_( next ); ++removed; }
+                    else kept = next;
+                }
+                return removed;
+            }
+
+            /*! Unlinks every node for which 'pred_' returns true, in a single pass: each run of
+             *  consecutive matches is cut out with one relink and handed over to 'dispose_' right
+             *  away, while its nodes are still in cache.
+             *  @return The number of nodes removed.
+             */
+            template < typename UnaryPredicate, typename Dispose >
+            static std::size_t remove_if( list_hook * sentinel_, UnaryPredicate & pred_, Dispose dispose_ ){
+                auto matches = [&]( list_hook * node ){ return pred_(value_of(node)); };
+                return remove_nodes( sentinel_, matches, dispose_ );
+            }
+
+            /// Same as remove_if(), with 'pred_' applied to the nodes themselves.
+            template < typename NodePredicate, typename Dispose >
+            static std::size_t remove_nodes( list_hook * sentinel_, NodePredicate & pred_, Dispose dispose_ ){
+                std::size_t removed{0};
+                list_hook * node{sentinel_->next};
+                while(node != sentinel_){
+                    if(not pred_(node)) { node = node->next; continue; }
+                    list_hook * first{node};            // Início de uma sequência de nós a remover.
+                    do node = node->next; while(node != sentinel_ and pred_(node));
+                    list_hook * before{first->prev};
+                    before->next = node;                // Um só religamento por sequência.
+                    node->prev = before;
+                    while(first != node){               // Os nós da sequência já estão fora da lista.
+                        list_hook * next{first->next};
+                        dispose_( first );
+                        first = next;
+                        ++removed;
+                    }
+                }
+                return removed;
+            }
+
+            /*! Merges the sorted list around 'b_' into the sorted list around 'a_' (see merge_chains()).
+             *  'b_' is left empty. If 'comp_' throws, no node is lost.
+             */
+            template < typename Compare >
+            static void merge( list_hook * a_, list_hook * b_, Compare & comp_ ){
+                list_hook * merged = detach_chain( a_ );
+                try {
+                    merge_chains( merged, detach_chain( b_ ), comp_ );
+                }
+                catch (...) {
+                    attach_chain( a_, merged );         // Nenhum nó se perde, mesmo se comp lançar exceção.
+                    throw;
+                }
+                attach_chain( a_, merged );             // Refaz os links prev e religa ao sentinela.
+            }
+
+            /*! Sorts the list around 'sentinel_' (see sort_chain()).
+             *  If 'comp_' throws, every node is kept in the list, in unspecified order.
+             */
+            template < typename Compare >
+            static void sort( list_hook * sentinel_, Compare & comp_ ){
+                list_hook * chain = detach_chain( sentinel_ );
+                try {
+                    sort_chain( chain, comp_ );
+                }
+                catch (...) {
+                    attach_chain( sentinel_, chain );
+                    throw;
+                }
+                attach_chain( sentinel_, chain );
+            }
+
+            /*! Sorts the list around 'sentinel_' by the unsigned integer that 'key_' returns for
+             *  each element, with a least significant digit first radix sort on digits of
+             *  'DigitBits' bits.
+             *
+             *  Each pass walks the nodes in their current order and appends every node to the
+             *  bucket of its digit, by relinking 'next' only; the buckets are then chained
+             *  in order, so the sort is stable, never compares two elements and never copies
+             *  or allocates one. The first pass also finds the digits in which the keys
+             *  differ at all, and only those get a pass of their own: O(n) per digit that varies.
+             *  If 'key_' throws, every node is kept in the list, in unspecified order.
+             */
+            template < unsigned DigitBits, typename KeyOf >
+            static void radix_sort( list_hook * sentinel_, KeyOf & key_ ){
+                list_hook * chain = detach_chain( sentinel_ );
+                try {
+                    radix_sort_chain< DigitBits >( chain, key_ );
+                }
+                catch (...) {
+                    attach_chain( sentinel_, chain );
+                    throw;
+                }
+                attach_chain( sentinel_, chain );
+            }
+
+            /*! Sorts a null-terminated chain with the radix sort (see radix_sort()); only the
+             *  'next' links are rewritten. If 'key_' throws, 'chain_' still holds every node.
+             */
+            template < unsigned DigitBits, typename KeyOf >
+            static void radix_sort_chain( list_hook *& chain_, KeyOf & key_ ){
+                using key_type = typename std::decay< decltype( key_( std::declval< value_type & >() ) ) >::type;
+                static_assert( std::is_unsigned<key_type>::value, "radix_sort: the key must be an unsigned integer" );
+                constexpr unsigned digit_bits = DigitBits;
+                constexpr std::size_t n_buckets = std::size_t(1) << digit_bits;
+                constexpr key_type digit_mask = key_type( n_buckets - 1 );
+
+                list_hook *& chain = chain_;
+                if(chain == nullptr) return;
+                list_hook * heads[ n_buckets ];
+                list_hook ** tails[ n_buckets ];            // Campo 'next' que receberá o próximo nó de cada balde.
+                list_hook * node{chain};
+                try {
+                    // A primeira passada também acumula os bits em que alguma chave difere da primeira:
+                    // os dígitos seguintes em que nenhuma difere não precisam de passada.
+                    const key_type first_key = key_( value_of( chain ) );
+                    key_type varying{0};
+                    for(unsigned shift{0}; shift < unsigned( std::numeric_limits<key_type>::digits ); shift += digit_bits){
+                        if(shift > 0 and key_type( varying >> shift ) == 0) break;
+                        if(shift > 0 and key_type( ( varying >> shift ) & digit_mask ) == 0) continue;
+                        for(std::size_t b{0}; b < n_buckets; ++b) tails[b] = &heads[b];
+                        for(node = chain, chain = nullptr; node != nullptr; node = node->next){
+                            const key_type key = key_( value_of( node ) );
+                            if(shift == 0) varying |= key_type( key ^ first_key );
+                            std::size_t b = ( key >> shift ) & digit_mask;
+                            *tails[b] = node;               // 'node->next' só é reescrito quando outro nó entra no balde.
+                            tails[b] = &node->next;
+                        }
+                        list_hook ** last{&chain};
+                        for(std::size_t b{0}; b < n_buckets; ++b)
+                            if(tails[b] != &heads[b]) { *last = heads[b]; last = tails[b]; }
+                        *last = nullptr;
+                    }
+                }
+                catch (...) {
+                    if(chain == nullptr){                   // A exceção veio no meio de uma passada: junta os baldes ao resto.
+                        list_hook ** last{&chain};
+                        for(std::size_t b{0}; b < n_buckets; ++b)
+                            if(tails[b] != &heads[b]) { *last = heads[b]; last = tails[b]; }
+                        *last = node;
+                    }
+                    throw;
+                }
+            }
+
+            /*! Moves the 'k_' smallest nodes, by 'comp_', to the front of the list around
+             *  'sentinel_', in sorted order; the other nodes follow, in unspecified order.
+             *
+             *  The nodes are read in order and each one is compared with the largest of the
+             *  k kept so far: the ones that are not smaller go straight to the rest, and the
+             *  others gather in a batch of k nodes. A full batch is sorted, merged with the
+             *  kept nodes, and the merged chain is cut back to k. That is O(n log k) in the
+             *  worst case and close to one comparison per node on random input. The result
+             *  is stable, the same first k nodes as sort() would give.
+             *  If 'comp_' throws, every node is kept in the list, in unspecified order.
+             */
+            template < typename Compare >
+            static void partial_sort( list_hook * sentinel_, std::size_t k_, Compare & comp_ ){
+                if(k_ == 0) return;
+                list_hook * input = detach_chain( sentinel_ );
+                list_hook * best{nullptr};                  // Os (até) k menores já vistos, ordenados.
+                list_hook * worst{nullptr};                 // O k-ésimo deles, assim que houver k.
+                node_chain batch, rest;
+                std::size_t batch_len{0};
+                try {
+                    while(true){
+                        while(input != nullptr and batch_len < k_){
+                            list_hook * node{input};
+                            const bool candidate = worst == nullptr or comp_( value_of( node ), value_of( worst ) );
+                            input = node->next;
+                            if(candidate) { batch.push_back( node ); ++batch_len; }
+                            else rest.push_back( node );
+                        }
+                        if(batch_len == 0) break;
+                        sort_chain( batch.first, comp_ );
+                        list_hook * run{batch.first};
+                        batch = node_chain();
+                        batch_len = 0;
+                        merge_chains( best, run, comp_ ); // Os já guardados vêm primeiro entre equivalentes.
+                        list_hook * node{best};
+                        std::size_t len{1};
+                        for( ; len < k_ and node->next != nullptr; ++len) node = node->next;
+                        if(len == k_){                      // Corta em k: o excedente vai para o resto.
+                            worst = node;
+                            rest.append( chain_of( node->next ) );
+                            node->next = nullptr;
+                        }
+                    }
+                }
+                catch (...) {
+                    node_chain all = chain_of( best );
+                    all.append( chain_of( batch.first ) ); // Após sort_chain(), 'batch.last' não vale mais.
+                    all.append( rest );
+                    all.append( chain_of( input ) );
+                    attach_chain( sentinel_, all.first );
+                    throw;
+                }
+                node_chain all = chain_of( best );
+                all.append( rest );
+                attach_chain( sentinel_, all.first );
+            }
+
+            /*! Puts in position 'nth_' of the list around 'sentinel_' (of 'len_' nodes) the node
+             *  that would be there if the list were sorted by 'comp_'; no node before it is
+             *  greater, and no node after it is smaller.
+             *
+             *  Selection by relinking, after Floyd and Rivest: a sample of the chain that holds
+             *  position 'nth_' is sorted, and two sampled nodes that bracket that rank become
+             *  the pivots. One pass splits the chain into the nodes below, between and above
+             *  them, and only the part that holds the position (most likely the short middle
+             *  one) is split again, until it is short enough to be sorted. Short chains, and
+             *  chains the pivots did not split, use a single pivot taken at random instead.
+             *  O(n) expected, with about two passes over the list; equivalent nodes never make
+             *  it quadratic. If 'comp_' throws, every node is kept in the list, in unspecified order.
+             *  @return The node in position 'nth_', or 'sentinel_' if 'nth_' >= 'len_'.
+             */
+            template < typename Compare >
+            static list_hook * nth_element( list_hook * sentinel_, std::size_t len_, std::size_t nth_, Compare & comp_ ){
+                if(nth_ >= len_) return sentinel_;
+                constexpr std::size_t sort_threshold = 16;
+                constexpr std::size_t sample_size = 255;
+                constexpr std::size_t sample_margin = 16;   // Posições da amostra entre o alvo e cada pivô.
+                list_hook * current = detach_chain( sentinel_ ); // A parte que contém a posição procurada.
+                node_chain prefix, suffix;                  // Já no lugar, antes e depois dela.
+                node_chain less, middle, greater;
+                std::size_t len{len_}, nth{nth_};
+                std::uint64_t seed{ ( 0x9E3779B97F4A7C15ull ^ len_ ^ ( std::uint64_t( nth_ ) << 32 ) ) | 1 };
+                auto random = [&]( void ){                  // xorshift64.
+                    seed ^= seed << 13;
+                    seed ^= seed >> 7;
+                    seed ^= seed << 17;
+                    return seed;
+                };
+                bool sampled{true};                         // false quando a amostra não conseguiu dividir a cadeia.
+                list_hook * result{nullptr};
+                auto assemble = [&]( void ){
+                    node_chain all = prefix;
+                    all.append( less );
+                    all.append( middle );
+                    all.append( greater );
+                    all.append( chain_of( current ) );
+                    all.append( suffix );
+                    attach_chain( sentinel_, all.first );
+                };
+                try {
+                    while(result == nullptr){
+                        less = middle = greater = node_chain();
+                        if(len <= sort_threshold){
+                            sort_chain( current, comp_ );
+                            result = current;
+                            for(std::size_t i{0}; i < nth; ++i) result = result->next;
+                            break;
+                        }
+                        list_hook * low, * high;            // Os nós entre os dois pivôs (inclusive) formam 'middle'.
+                        if(sampled and len >= 4 * sample_size){
+                            list_hook * sample[ sample_size ];
+                            const std::size_t stride{ len / sample_size };
+                            list_hook * node{current};
+                            for(std::size_t i = random() % stride; i > 0; --i) node = node->next;
+                            for(std::size_t i{0}; i < sample_size; ++i){
+                                sample[i] = node;
+                                for(std::size_t j{0}; j < stride and i + 1 < sample_size; ++j) node = node->next;
+                            }
+                            std::sort( sample, sample + sample_size,
+                                       [&]( list_hook * a, list_hook * b ){ return comp_( value_of( a ), value_of( b ) ); } );
+                            const std::size_t rank{ nth * sample_size / len };
+                            low = sample[ rank > sample_margin ? rank - sample_margin : 0 ];
+                            high = sample[ std::min( rank + sample_margin, sample_size - 1 ) ];
+                        }
+                        else {
+                            low = current;
+                            for(std::size_t i = random() % len; i > 0; --i) low = low->next;
+                            high = low;
+                        }
+
+                        std::size_t n_less{0}, n_middle{0};
+                        while(current != nullptr){          // 'current' só avança depois de comparar o nó.
+                            list_hook * node{current};
+                            if(comp_( value_of( node ), value_of( low ) )) { current = node->next; less.push_back( node ); ++n_less; }
+                            else if(comp_( value_of( high ), value_of( node ) )) { current = node->next; greater.push_back( node ); }
+                            else { current = node->next; middle.push_back( node ); ++n_middle; }
+                        }
+                        if(nth < n_less){
+                            middle.append( greater );
+                            middle.append( suffix );
+                            suffix = middle;
+                            middle = greater = node_chain();
+                            current = less.first;
+                            less = node_chain();
+                            len = n_less;
+                        }
+                        else if(nth < n_less + n_middle){
+                            if(not comp_( value_of( low ), value_of( high ) )){ // Pivôs equivalentes: 'middle' já está no lugar.
+                                result = middle.first;
+                                for(std::size_t i{n_less}; i < nth; ++i) result = result->next;
+                                break;
+                            }
+                            sampled = n_middle < len;
+                            prefix.append( less );
+                            greater.append( suffix );
+                            suffix = greater;
+                            current = middle.first;
+                            less = middle = greater = node_chain();
+                            nth -= n_less;
+                            len = n_middle;
+                        }
+                        else {
+                            prefix.append( less );
+                            prefix.append( middle );
+                            current = greater.first;
+                            less = middle = greater = node_chain();
+                            nth -= n_less + n_middle;
+                            len -= n_less + n_middle;
+                        }
+                    }
+                }
+                catch (...) { assemble(); throw; }
+                assemble();
+                return result;
+            }
+
+            /*! Merges two sorted null-terminated chains, linked only by 'next', into 'a_'.
+             *  On ties the node from 'a_' goes first, so the merge is stable.
+             *  If 'comp_' throws, 'a_' still receives every node of both chains; or, if 'rest_'
+             *  is given, 'a_' receives the nodes merged so far followed by what was left of 'a_'
+             *  (so it is still sorted), and '*rest_' what was left of 'b_'.
+             */
+            template < typename Compare >
+            static void merge_chains( list_hook *& a_, list_hook * b_, Compare & comp_, list_hook ** rest_ = nullptr ){
+                list_hook * first{nullptr};
+                list_hook ** last{&first};                       // Campo 'next' que receberá o próximo nó.
+                list_hook * a{a_};
+                try {
+                    while(a != nullptr and b_ != nullptr){
+                        if(comp_(value_of(b_), value_of(a))) { *last = b_; b_ = b_->next; }
+                        else { *last = a; a = a->next; }
+                        last = &((*last)->next);
+                    }
+                }
+                catch (...) {
+                    *last = a;                              // Anexa o que sobrou das duas cadeias.
+                    if (rest_ != nullptr) *rest_ = b_;
+                    else {
+                        while(*last != nullptr) last = &((*last)->next);
+                        *last = b_;
+                    }
+                    a_ = first;
+                    throw;
+                }
+                *last = (a != nullptr) ? a : b_;            // Anexa o que sobrou.
+                a_ = first;
+            }
+
+            /*! Sorts a null-terminated chain with the bottom-up merge sort (see sort()).
+             *  If 'comp_' throws, 'chain_' still holds every node, in unspecified order.
+             */
+            template < typename Compare >
+            static void sort_chain( list_hook *& chain_, Compare & comp_ ){
+                list_hook * bins[ 64 ] = {};                     // bins[i]: sequência ordenada com 2^i nós (ou vazia).
+                size_t fill{0};                             // Quantidade de bins em uso.
+                list_hook * current{chain_};
+                list_hook * carry{nullptr};
+                list_hook * result{nullptr};
+                try {
+                    while(current != nullptr){
+                        carry = current;                    // Retira o primeiro nó da cadeia.
+                        current = current->next;
+                        carry->next = nullptr;
+                        size_t i{0};
+                        // Enquanto o bin estiver ocupado, funde (os nós mais antigos vêm primeiro, para manter a estabilidade).
+                        for( ; i < fill and bins[i] != nullptr; ++i){
+                            list_hook * run{carry};
+                            carry = nullptr;
+                            merge_chains( bins[i], run, comp_ );
+                            carry = bins[i];
+                            bins[i] = nullptr;
+                        }
+                        bins[i] = carry;
+                        carry = nullptr;
+                        if(i == fill) ++fill;
+                    }
+                    // Junta os bins restantes, dos mais novos (menores) para os mais antigos.
+                    for(size_t i{0}; i < fill; ++i){
+                        if(bins[i] == nullptr) continue;
+                        list_hook * run{result};
+                        result = nullptr;
+                        merge_chains( bins[i], run, comp_ );
+                        result = bins[i];
+                        bins[i] = nullptr;
+                    }
+                }
+                catch (...) {
+                    // Nenhum nó pode ser perdido: junta todas as cadeias pendentes.
+                    list_hook ** last{&chain_};
+                    list_hook * pending[] = { carry, current, result };
+                    for(auto c : pending){
+                        *last = c;
+                        while(*last != nullptr) last = &((*last)->next);
+                    }
+                    for(size_t i{0}; i < fill; ++i){
+                        *last = bins[i];
+                        while(*last != nullptr) last = &((*last)->next);
+                    }
+                    throw;
+                }
+                chain_ = result;
+            }
+
+            /*! Unlinks every node from the list as a null-terminated chain (the prev links
+             *  are left untouched).
+             *  @return The first node of the chain, or nullptr if the list is empty.
+             */
+            static list_hook * detach_chain( list_hook * sentinel_ ){
+                if(sentinel_->next == sentinel_) return nullptr;
+                list_hook * first = sentinel_->next;
+                (sentinel_->prev)->next = nullptr;
+                reset( sentinel_ );
+                return first;
+            }
+
+            /// A null-terminated chain under construction, with both ends at hand.
+            struct node_chain
+            {
+                list_hook * first{nullptr};
+                list_hook * last{nullptr};
+
+                /// Appends one node, which becomes the end of the chain.
+                void push_back( list_hook * node_ ){
+                    node_->next = nullptr;
+                    if(last != nullptr) last->next = node_;
+                    else first = node_;
+                    last = node_;
+                }
+
+                /// Appends the nodes of 'other_' after the last one.
+                void append( const node_chain & other_ ){
+                    if(other_.first == nullptr) return;
+                    if(last != nullptr) last->next = other_.first;
+                    else first = other_.first;
+                    last = other_.last;
+                }
+            };
+
+            /// The ends of the null-terminated chain that starts at 'first_', found by walking it.
+            static node_chain chain_of( list_hook * first_ ){
+                node_chain c;
+                c.first = first_;
+                for(c.last = first_; c.last != nullptr and c.last->next != nullptr; ) c.last = c.last->next;
+                return c;
+            }
+
+            /// Links a null-terminated chain to the sentinel, rebuilding the prev links.
+            static void attach_chain( list_hook * sentinel_, list_hook * first_ ){
+                list_hook * prev_node{sentinel_};
+                for( ; first_ != nullptr; first_ = first_->next){
+                    prev_node->next = first_;
+                    first_->prev = prev_node;
+                    prev_node = first_;
+                }
+                prev_node->next = sentinel_;
+                sentinel_->prev = prev_node;
+            }
+        };
+    }
+}
+#endif
@@ -0,0 +1,311 @@
+#ifndef _LOCKFREE_LIST_QUEUE_H_
+#define _LOCKFREE_LIST_QUEUE_H_
+
+#include <algorithm>  // std::sort, std::binary_search
+#include <atomic>
+#include <cstddef>    // std::size_t, std::ptrdiff_t
+#include <functional> // std::hash
+#include <memory>     // std::allocator, std::allocator_traits
+#include <mutex>
+#include <new>        // placement new
+#include <thread>     // std::this_thread
+#include <type_traits>
+#include <utility>    // std::forward, std::move
+
+namespace sc {
+    /*!
+     * A lock-free multi-producer, multi-consumer FIFO queue (Michael and Scott).
+     *
+     * Each node has its own atomic link and raw storage, in which the element is
+     * constructed only while the node is queued. The queue always holds a
+     * dummy node at the front; push() links a node after the last one with a CAS
+     * and try_pop() moves the head past the dummy with another, so neither end
+     * ever blocks the other.
+     *
+     * Memory reclamation uses hazard pointers: a thread publishes the nodes it is
+     * about to read, and a popped node is only retired, never released, while some
+     * thread still publishes it. Retired nodes that are safe again go to a free
+     * stack and are reused by later pushes, so a node address can never come back
+     * under a pending CAS (no ABA). The allocator is only called when that stack
+     * is empty, under a mutex, so an unsynchronized `sc::pool_allocator` may be
+     * used; every node goes back to it when the queue is destroyed.
+     *
+     * \note
+     * At most `max_threads` threads may be inside push() or try_pop() at the same
+     * time; more wait for a free hazard record. T's move assignment should not
+     * throw: if it does, the popped element is lost (the queue stays consistent).
+     */
+    template < typename T, typename Alloc = std::allocator<T> >
+    class lockfree_list_queue
+    {
+        public:
+            /// Threads that may work on the queue at the same time without waiting for each other.
+            static constexpr std::size_t max_threads = 128;
+
+        private:
+        //=== the node: an atomic link plus the element, constructed in place only while queued.
+        struct Node
+        {
+            std::atomic< Node * > next;      //!< Next node in the queue.
+            std::atomic< Node * > free_next; //!< Next node in the retired or the free stack.
+            typename std::aligned_storage< sizeof(T), alignof(T) >::type storage;
+
+            Node() : next{ nullptr }, free_next{ nullptr } { /* empty */ }
+
+            T * data( void ) { return reinterpret_cast< T * >( &storage ); }
+        };
+
+        using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+
+        /// Hazard pointers of one thread while it is inside an operation (one cache line each).
+        struct Record
+        {
+            std::atomic< Node * > hazards[ 2 ];
+            std::atomic< bool > owned;
+            char pad[ 64 - 2 * sizeof(void *) - sizeof(bool) ];
+        };
+
+        /// Retired nodes accumulated before a thread scans the hazard pointers.
+        static constexpr std::ptrdiff_t scan_threshold = 2 * 2 * max_threads;
+
+        //=== Private members.
+        private:
+            std::atomic< Node * > m_head;           // o nó fictício (o primeiro elemento é o seguinte).
+            char m_pad1[ 64 ];
+            std::atomic< Node * > m_tail;           // o último nó (ou um pouco antes, até ser ajudado).
+            char m_pad2[ 64 ];
+            std::atomic< Node * > m_retired;        // nós retirados, à espera de que ninguém os publique.
+            std::atomic< std::ptrdiff_t > m_retired_count; // aproximado: pode ficar negativo por um instante.
+            std::atomic< Node * > m_free;           // nós livres, prontos para reuso.
+            std::mutex m_alloc_lock;                // serializa as chamadas ao alocador.
+            node_allocator_type m_alloc;
+            Record m_records[ max_threads ];        // registros de hazard pointers.
+
+            /// A hazard record held for the length of one operation.
+            class hazard_guard
+            {
+                private:
+                    Record * m_record;
+
+                public:
+                    explicit hazard_guard( lockfree_list_queue & queue_ ) : m_record{ queue_.acquire_record() }
+                    { /* empty */ }
+
+                    ~hazard_guard()
+                    {
+                        m_record->hazards[0].store( nullptr );
+                        m_record->hazards[1].store( nullptr );
+                        m_record->owned.store( false, std::memory_order_release );
+                    }
+
+                    hazard_guard( const hazard_guard & ) = delete;
+                    hazard_guard & operator=( const hazard_guard & ) = delete;
+
+                    /// Publishes the node read from 'source_' in slot 'slot_', reading again until it is stable.
+                    Node * protect( int slot_, const std::atomic< Node * > & source_ )
+                    {
+                        Node * node = source_.load();
+                        while (true) {
+                            m_record->hazards[ slot_ ].store( node );
+                            Node * again = source_.load();
+                            if (again == node) return node;
+                            node = again;
+                        }
+                    }
+
+                    /// Publishes 'node_' in slot 'slot_'; the caller must then check it is still reachable.
+                    void set( int slot_, Node * node_ ) { m_record->hazards[ slot_ ].store( node_ ); }
+            };
+
+            /// Takes a free hazard record, starting from one chosen by the thread (and waiting if all are taken).
+            Record * acquire_record( void )
+            {
+                static thread_local std::size_t hint = std::hash< std::thread::id >()( std::this_thread::get_id() );
+                while (true) {
+                    for (std::size_t i{0}; i < max_threads; ++i) {
+                        Record & record = m_records[ ( hint + i ) % max_threads ];
+                        if (not record.owned.load( std::memory_order_relaxed )
+                            and not record.owned.exchange( true, std::memory_order_acquire ))
+                            return &record;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+
+            /// Pushes 'node_' onto one of the stacks linked by free_next (a push never suffers from ABA).
+            static void push_stack( std::atomic< Node * > & stack_, Node * node_ )
+            {
+                Node * top = stack_.load();
+                do node_->free_next.store( top );
+                while (not stack_.compare_exchange_weak( top, node_ ));
+            }
+
+            /*! Pops a node from the free stack, or allocates a new one. The top is published before
+             *  its link is read, so it cannot be popped, reused, retired and freed again meanwhile.
+             */
+            Node * acquire_node( hazard_guard & guard_ )
+            {
+                while (true) {
+                    Node * top = guard_.protect( 0, m_free );
+                    if (top == nullptr) break;
+                    Node * next = top->free_next.load();
+                    if (m_free.compare_exchange_strong( top, next )) { guard_.set( 0, nullptr ); return top; }
+                }
+                guard_.set( 0, nullptr );
+                std::lock_guard< std::mutex > lock( m_alloc_lock );
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                node_traits::construct( m_alloc, node );
+                return node;
+            }
+
+            /// Hands over a node no longer reachable from the queue; releases it once no thread publishes it.
+            void retire( Node * node_ )
+            {
+                push_stack( m_retired, node_ );
+                if (++m_retired_count >= scan_threshold) scan();
+            }
+
+            /// Moves every retired node that no thread publishes to the free stack.
+            void scan( void )
+            {
+                Node * retired = m_retired.exchange( nullptr ); // Leva todos de uma vez: sem ABA.
+                if (retired == nullptr) return;
+                Node * hazards[ 2 * max_threads ];
+                std::size_t count{0};
+                for (auto & record : m_records)
+                    for (auto & hazard : record.hazards) {
+                        Node * node = hazard.load();
+                        if (node != nullptr) hazards[ count++ ] = node;
+                    }
+                std::sort( hazards, hazards + count );
+                std::ptrdiff_t taken{0};
+                while (retired != nullptr) {
+                    Node * next = retired->free_next.load();
+                    if (std::binary_search( hazards, hazards + count, retired )) push_stack( m_retired, retired );
+                    else { push_stack( m_free, retired ); ++taken; }
+                    retired = next;
+                }
+                m_retired_count -= taken;
+            }
+
+            /// Gives every node of a stack back to the allocator (only when no other thread uses the queue).
+            void release_stack( std::atomic< Node * > & stack_ )
+            {
+                Node * node = stack_.exchange( nullptr );
+                while (node != nullptr) {
+                    Node * next = node->free_next.load();
+                    node_traits::destroy( m_alloc, node );
+                    node_traits::deallocate( m_alloc, node, 1 );
+                    node = next;
+                }
+            }
+
+        public:
+            using value_type     = T;
+            using allocator_type = Alloc;
+            using size_type      = std::size_t;
+
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty queue.
+        lockfree_list_queue() : lockfree_list_queue( Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty queue that draws its nodes from 'alloc_'.
+        explicit lockfree_list_queue( const Alloc & alloc_ )
+            : m_head{ nullptr }, m_tail{ nullptr }, m_retired{ nullptr }, m_retired_count{ 0 }, m_free{ nullptr }, m_alloc{ alloc_ }
+        {
+            for (auto & record : m_records) {
+                record.hazards[0].store( nullptr );
+                record.hazards[1].store( nullptr );
+                record.owned.store( false );
+            }
+            Node * dummy = node_traits::allocate( m_alloc, 1 );
+            node_traits::construct( m_alloc, dummy );
+            m_head.store( dummy );
+            m_tail.store( dummy );
+        }
+
+        ///* (2) A queue shared by threads is neither copied nor moved.
+        lockfree_list_queue( const lockfree_list_queue & ) = delete;
+        lockfree_list_queue & operator=( const lockfree_list_queue & ) = delete;
+
+        ///* (3) Destroys the remaining elements and gives every node back. No other thread may be using the queue.
+        ~lockfree_list_queue()
+        {
+            Node * node = m_head.load();
+            for (Node * next = node->next.load(); next != nullptr; next = node->next.load()) {
+                next->data()->~T();             // O nó fictício não guarda elemento.
+                push_stack( m_retired, node );
+                node = next;
+            }
+            push_stack( m_retired, node );
+            release_stack( m_retired );
+            release_stack( m_free );
+        }
+
+        ///* Returns a copy of the allocator associated with the queue.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        //!=== [II] Modifiers
+        ///* Constructs an element in place at the end of the queue.
+        template < typename... Args >
+        void emplace( Args&&... args_ )
+        {
+            hazard_guard guard( *this );
+            Node * node = acquire_node( guard );
+            try {
+                ::new ( static_cast< void * >( node->data() ) ) T( std::forward<Args>( args_ )... );
+            }
+            catch (...) { retire( node ); throw; }  // Outra thread pode ainda publicar o nó (topo antigo da pilha livre).
+            node->next.store( nullptr );
+            while (true) {
+                Node * tail = guard.protect( 0, m_tail );
+                Node * next = tail->next.load();
+                if (tail != m_tail.load()) continue;
+                if (next == nullptr) {
+                    if (tail->next.compare_exchange_weak( next, node )) {
+                        m_tail.compare_exchange_strong( tail, node ); // Se falhar, alguém já ajudou.
+                        return;
+                    }
+                }
+                else m_tail.compare_exchange_weak( tail, next );   // Ajuda um push que ficou no meio.
+            }
+        }
+
+        ///* Adds 'value_' to the end of the queue.
+        void push( const T & value_ ) { this->emplace( value_ ); }
+        void push( T && value_ ) { this->emplace( std::move( value_ ) ); }
+
+        /*! Removes the first element, moving it into 'value_'.
+         *  @return false (and 'value_' untouched) if the queue was empty.
+         */
+        bool try_pop( T & value_ )
+        {
+            hazard_guard guard( *this );
+            while (true) {
+                Node * head = guard.protect( 0, m_head );
+                Node * tail = m_tail.load();
+                Node * next = head->next.load();
+                guard.set( 1, next );
+                if (head != m_head.load()) continue;    // 'next' só é seguro se 'head' ainda for a cabeça.
+                if (next == nullptr) return false;
+                if (head == tail) { m_tail.compare_exchange_weak( tail, next ); continue; }
+                if (m_head.compare_exchange_strong( head, next )) {
+                    // 'next' é o novo nó fictício: só quem avançou a cabeça toca o seu elemento.
+                    T * data = next->data();
+                    try {
+                        value_ = std::move( *data );
+                    }
+                    catch (...) { data->~T(); retire( head ); throw; }
+                    data->~T();
+                    retire( head );
+                    return true;
+                }
+            }
+        }
+    };
+}
+#endif
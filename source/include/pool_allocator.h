@@ -0,0 +1,244 @@
+#ifndef _POOL_ALLOCATOR_H_
+#define _POOL_ALLOCATOR_H_
+
+#include <cstddef>   // std::size_t, std::max_align_t
+#include <cstdint>   // std::uintptr_t
+#include <memory>    // std::shared_ptr, std::make_shared
+#include <new>       // ::operator new, ::operator delete
+#include <type_traits>
+
+namespace sc {
+    /*!
+     * A slab (pool) memory resource for single objects.
+     *
+     * Blocks are carved out of large contiguous chunks and, once released,
+     * recycled through an intrusive free list, one list per size class.
+     * After the pool has grown to the working-set size of the client, a
+     * steady insert/erase workload does not touch the heap at all.
+     *
+     * Requests for arrays (n > 1), for blocks larger than `max_block_size`
+     * or for over-aligned types are forwarded to the global `operator new`;
+     * an over-aligned block is carved out of a larger one, so it keeps its
+     * alignment.
+     *
+     * \note
+     * The pool is not synchronized. Sharing one pool between threads
+     * requires external locking; otherwise, give each thread its own pool.
+     *
+     * Chunks are only returned to the system when the pool is destroyed.
+     */
+    class slab_pool
+    {
+        public:
+            static constexpr std::size_t granularity    = alignof(std::max_align_t); //!< Size class step (and block alignment).
+            static constexpr std::size_t max_block_size = 512;                       //!< Largest block served by the pool.
+            static constexpr std::size_t max_chunk_blocks = 1u << 16;                //!< Growth cap, in blocks per chunk.
+
+        private:
+            /// A free block, reusing the storage of the released object.
+            struct FreeBlock { FreeBlock * next; };
+
+            /// Header placed at the beginning of every chunk, so they can be released later.
+            struct alignas(std::max_align_t) Chunk { Chunk * next; };
+
+            /// One size class.
+            struct Bucket
+            {
+                FreeBlock * free_list;   //!< Recycled blocks.
+                char * cursor;           //!< Next untouched block in the current chunk.
+                char * limit;            //!< End of the current chunk.
+                std::size_t next_chunk;  //!< Number of blocks of the next chunk to be allocated.
+            };
+
+            static constexpr std::size_t n_buckets = max_block_size / granularity;
+
+            Bucket m_buckets[ n_buckets ]; //!< Size classes.
+            Chunk * m_chunks;              //!< Every chunk requested from the system.
+
+        public:
+            /// Creates an empty pool; the first chunk of each size class holds `blocks_per_chunk` blocks.
+            explicit slab_pool( std::size_t blocks_per_chunk = 64 )
+                : m_chunks{ nullptr }
+            {
+                for ( auto & b : m_buckets )
+                    b = Bucket{ nullptr, nullptr, nullptr, blocks_per_chunk > 0 ? blocks_per_chunk : 1 };
+            }
+
+            slab_pool( const slab_pool & ) = delete;
+            slab_pool & operator=( const slab_pool & ) = delete;
+
+            /// Releases every chunk back to the system.
+            ~slab_pool()
+            {
+                while ( m_chunks != nullptr )
+                {
+                    Chunk * next = m_chunks->next;
+                    ::operator delete( m_chunks );
+                    m_chunks = next;
+                }
+            }
+
+            /*! Gets `bytes` bytes aligned to `align` (a power of two) from the global `operator new`.
+             *  Past `granularity`, it over-allocates by `align` and keeps the address it got right
+             *  before the aligned block, for system_deallocate().
+             */
+            static void * system_allocate( std::size_t bytes, std::size_t align )
+            {
+                if ( align <= granularity ) return ::operator new( bytes );
+                char * raw = static_cast< char * >( ::operator new( bytes + align ) );
+                char * block = raw + align - reinterpret_cast< std::uintptr_t >( raw ) % align;
+                reinterpret_cast< void ** >( block )[ -1 ] = raw;
+                return block;
+            }
+
+            /// Gives back a block obtained from `system_allocate( bytes, align )`.
+            static void system_deallocate( void * p, std::size_t align ) noexcept
+            {
+                if ( align <= granularity ) ::operator delete( p );
+                else ::operator delete( static_cast< void ** >( p )[ -1 ] );
+            }
+
+            /// Checks whether a block of `bytes` bytes aligned to `align` is served by the pool.
+            static constexpr bool pooled( std::size_t bytes, std::size_t align )
+            { return bytes <= max_block_size and align <= granularity; }
+
+            /// Returns a block with room for `bytes` bytes.
+            void * allocate( std::size_t bytes, std::size_t align = granularity )
+            {
+                if ( not pooled( bytes, align ) )
+                    return system_allocate( bytes, align );
+
+                Bucket & b = m_buckets[ bucket_index( bytes ) ];
+                // Recycled blocks first.
+                if ( b.free_list != nullptr )
+                {
+                    FreeBlock * block = b.free_list;
+                    b.free_list = block->next;
+                    return block;
+                }
+                // Then untouched blocks of the current chunk.
+                if ( b.cursor == b.limit )
+                    grow( b, block_size( bytes ), b.next_chunk );
+                void * block = b.cursor;
+                b.cursor += block_size( bytes );
+                return block;
+            }
+
+            /// Gives back a block previously obtained from `allocate( bytes, align )`.
+            void deallocate( void * p, std::size_t bytes, std::size_t align = granularity ) noexcept
+            {
+                if ( p == nullptr ) return;
+                if ( not pooled( bytes, align ) )
+                {
+                    system_deallocate( p, align );
+                    return;
+                }
+                Bucket & b = m_buckets[ bucket_index( bytes ) ];
+                FreeBlock * block = static_cast< FreeBlock * >( p );
+                block->next = b.free_list;
+                b.free_list = block;
+            }
+
+        private:
+            static constexpr std::size_t block_size( std::size_t bytes )
+            { return bytes == 0 ? granularity : ( bytes + granularity - 1 ) / granularity * granularity; }
+
+            static constexpr std::size_t bucket_index( std::size_t bytes )
+            { return block_size( bytes ) / granularity - 1; }
+
+            /// Requests a new chunk with `count` blocks of `bsize` bytes for the bucket `b`.
+            void grow( Bucket & b, std::size_t bsize, std::size_t count )
+            {
+                // Whatever is left of the current chunk goes to the free list, so it is not lost.
+                while ( b.cursor != b.limit )
+                {
+                    FreeBlock * block = reinterpret_cast< FreeBlock * >( b.cursor );
+                    block->next = b.free_list;
+                    b.free_list = block;
+                    b.cursor += bsize;
+                }
+                auto raw = static_cast< char * >( ::operator new( sizeof(Chunk) + bsize * count ) );
+                Chunk * chunk = reinterpret_cast< Chunk * >( raw );
+                chunk->next = m_chunks;
+                m_chunks = chunk;
+                b.cursor = raw + sizeof(Chunk);
+                b.limit = b.cursor + bsize * count;
+                // Chunks grow geometrically, so the number of system calls is logarithmic.
+                if ( b.next_chunk < max_chunk_blocks ) b.next_chunk *= 2;
+            }
+    };
+
+    /*!
+     * A standard-conforming allocator that draws single objects from a `slab_pool`.
+     *
+     * Copies (and rebound copies) of an allocator share the same pool, so a
+     * container can allocate its internal nodes from the pool of the
+     * allocator it received for `T`. Two allocators compare equal iff they
+     * share the same pool.
+     *
+     * \note
+     * A default-constructed allocator creates a fresh pool (a pool is not
+     * thread-safe, so none is shared behind the user's back). Containers that
+     * exchange nodes (`splice()`, `merge()`) must be built from copies of the
+     * same allocator; sc::list asserts that they are.
+     */
+    template < typename T >
+    class pool_allocator
+    {
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using propagate_on_container_copy_assignment = std::false_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            template < typename U >
+            struct rebind { using other = pool_allocator<U>; };
+
+        private:
+            std::shared_ptr< slab_pool > m_pool; //!< The (shared) pool.
+
+            template < typename U > friend class pool_allocator;
+
+        public:
+            /// Creates an allocator with its own pool.
+            pool_allocator() : m_pool{ std::make_shared< slab_pool >() }
+            { /* empty */ }
+
+            /// Creates an allocator that draws from `pool`.
+            explicit pool_allocator( std::shared_ptr< slab_pool > pool ) : m_pool{ std::move( pool ) }
+            { /* empty */ }
+
+            pool_allocator( const pool_allocator & ) = default;
+            pool_allocator & operator=( const pool_allocator & ) = default;
+
+            /// Rebinding constructor: shares the pool of `other`.
+            template < typename U >
+            pool_allocator( const pool_allocator<U> & other ) noexcept : m_pool{ other.m_pool }
+            { /* empty */ }
+
+            T * allocate( size_type n )
+            {
+                if ( n == 1 )
+                    return static_cast< T * >( m_pool->allocate( sizeof(T), alignof(T) ) );
+                return static_cast< T * >( slab_pool::system_allocate( n * sizeof(T), alignof(T) ) );
+            }
+
+            void deallocate( T * p, size_type n ) noexcept
+            {
+                if ( n == 1 ) m_pool->deallocate( p, sizeof(T), alignof(T) );
+                else slab_pool::system_deallocate( p, alignof(T) );
+            }
+
+            /// Returns the pool this allocator draws from.
+            const std::shared_ptr< slab_pool > & pool() const noexcept { return m_pool; }
+
+            template < typename U >
+            bool operator==( const pool_allocator<U> & rhs ) const noexcept { return m_pool == rhs.m_pool; }
+
+            template < typename U >
+            bool operator!=( const pool_allocator<U> & rhs ) const noexcept { return m_pool != rhs.m_pool; }
+    };
+}
+#endif
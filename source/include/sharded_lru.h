@@ -0,0 +1,381 @@
+#ifndef _SHARDED_LRU_H_
+#define _SHARDED_LRU_H_
+
+#include <algorithm>     // std::fill
+#include <atomic>
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint64_t
+#include <functional>    // std::hash, std::equal_to
+#include <iterator>      // std::prev
+#include <memory>        // std::allocator, std::allocator_traits
+#include <mutex>
+#include <new>           // placement new
+#include <thread>        // std::this_thread
+#include <vector>
+#include <utility>       // std::pair, std::forward, std::move
+
+#include "list.h"
+
+namespace sc {
+    namespace detail {
+        /*!
+         * A reader-writer lock for short critical sections: readers only touch an atomic
+         * counter, so hits on different threads never wait for each other. They do still
+         * write that counter, one increment and one decrement each, so its cache line moves
+         * between the cores reading the same shard. Writers are serialized by a mutex, raise
+         * a flag that holds back new readers, and wait for the readers already in to leave.
+         */
+        class shared_spin_lock
+        {
+            private:
+                std::atomic< std::size_t > m_readers{ 0 };
+                std::atomic< bool > m_writer{ false };
+                std::mutex m_writers;
+
+            public:
+                void lock_shared( void )
+                {
+                    while (true) {
+                        while (m_writer.load()) std::this_thread::yield();
+                        m_readers.fetch_add( 1 );
+                        if (not m_writer.load()) return;    // Nenhum escritor entrou no meio.
+                        m_readers.fetch_sub( 1 );
+                    }
+                }
+
+                void unlock_shared( void ) { m_readers.fetch_sub( 1 ); }
+
+                void lock( void )
+                {
+                    m_writers.lock();
+                    enter();
+                }
+
+                bool try_lock( void )
+                {
+                    if (not m_writers.try_lock()) return false;
+                    enter();
+                    return true;
+                }
+
+                void unlock( void )
+                {
+                    m_writer.store( false );
+                    m_writers.unlock();
+                }
+
+            private:
+                void enter( void )
+                {
+                    m_writer.store( true );
+                    while (m_readers.load() != 0) std::this_thread::yield();
+                }
+        };
+
+        /// Holds a shared_spin_lock in shared mode for the length of a scope.
+        class shared_guard
+        {
+            private:
+                shared_spin_lock & m_lock;
+
+            public:
+                explicit shared_guard( shared_spin_lock & lock_ ) : m_lock( lock_ ) { m_lock.lock_shared(); }
+                ~shared_guard() { m_lock.unlock_shared(); }
+                shared_guard( const shared_guard & ) = delete;
+                shared_guard & operator=( const shared_guard & ) = delete;
+        };
+    }
+
+    /*!
+     * A concurrent LRU cache: the keys are partitioned among independently locked shards,
+     * so threads working on different shards never contend.
+     *
+     * Each shard is a classic LRU: an `sc::list` of the entries, from the least to the most
+     * recently used, plus a hash index. A hit is moved to the back with splice() and the
+     * front is evicted with pop_front(), so recency updates only relink nodes. The index is
+     * a bucket array whose chains run through the entries themselves, so an entry costs a
+     * single allocation and a lookup a single pointer chase per probe.
+     *
+     * Hits do not take the shard lock exclusively. A reader looks the key up in shared mode
+     * and only records the hit in the shard's read buffer; the buffered hits are replayed,
+     * in order, by the next writer to the shard, or by the reader that finds the buffer full
+     * (if it gets the lock at once: otherwise the hit is dropped, as the recency order is
+     * only a heuristic). Writers replay the buffer before any erase or eviction, so it never
+     * refers to a removed entry.
+     *
+     * A hit is not free of shared writes, though: it increments and decrements the shard's
+     * reader count and reserves a slot of its read buffer, three atomic read-modify-writes on
+     * lines shared by every thread reading that shard. Threads spread over many shards barely
+     * notice; threads hammering one hot key all land on one shard and pay for that line. The
+     * lookup cannot skip the reader count: without it a writer could free the entry while a
+     * reader copies its value.
+     *
+     * \note
+     * get() returns a copy of the value: a reference would outlive the shard lock. The
+     * allocator is used under the shard locks, one shard at a time, so it must be safe to
+     * use from several threads at once (std::allocator is).
+     */
+    template < typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+               typename Alloc = std::allocator< std::pair< const Key, T > > >
+    class sharded_lru
+    {
+        public:
+            using key_type       = Key;
+            using mapped_type    = T;
+            using value_type     = std::pair< const Key, T >;
+            using size_type      = std::size_t;
+            using hasher         = Hash;
+            using key_equal      = KeyEqual;
+            using allocator_type = Alloc;
+
+            /// Hits each shard buffers before they are replayed on its recency list.
+            static constexpr size_type read_buffer_size = 64;
+
+        private:
+        struct Entry;
+        using entry_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc< Entry >;
+        using list_type = sc::list< Entry, entry_allocator >;
+        using list_iterator = typename list_type::iterator;
+        using bucket_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc< list_iterator >;
+
+        //=== an element of a recency list: the key and value, plus its link in the hash index.
+        struct Entry
+        {
+            value_type value;
+            std::uint64_t hash;     //!< The mixed hash of the key (see mix()).
+            list_iterator chain;    //!< Next entry in the same bucket (a null iterator ends the chain).
+
+            template < typename M >
+            Entry( const Key & key_, M && value_, std::uint64_t hash_ )
+                : value( key_, std::forward<M>( value_ ) ), hash{ hash_ }, chain{}
+            { /* empty */ }
+        };
+
+        //=== one shard: an LRU list, its index and the hits not yet replayed.
+        struct Shard
+        {
+            detail::shared_spin_lock lock;
+            list_type order;                                    // do menos para o mais recente.
+            std::vector< list_iterator, bucket_allocator > buckets; // início de cada cadeia.
+            std::atomic< size_type > pending{ 0 };              // posições do buffer já reservadas.
+            list_iterator buffer[ read_buffer_size ];           // acertos ainda não aplicados.
+            char pad[ 64 ];                                     // evita que dois shards dividam uma linha de cache.
+
+            Shard( size_type buckets_, const Alloc & alloc_ )
+                : order( entry_allocator( alloc_ ) ), buckets( buckets_, list_iterator{}, bucket_allocator( alloc_ ) )
+            { /* empty */ }
+        };
+
+        //=== Private members.
+        private:
+            size_type m_capacity;                   // capacidade de cada shard.
+            size_type m_shard_count;                // potência de 2.
+            unsigned m_shard_bits;                  // log2( m_shard_count ).
+            unsigned m_bucket_bits;                 // log2( buckets por shard ).
+            Hash m_hash;
+            KeyEqual m_equal;
+            Shard * m_shards;                       // construídos no lugar (Shard não é movível).
+
+            /// Spreads the hash over all 64 bits (a Fibonacci product, a bijection): weak hashes still spread.
+            std::uint64_t mix( const Key & key_ ) const
+            { return static_cast< std::uint64_t >( m_hash( key_ ) ) * 0x9E3779B97F4A7C15ull; }
+
+            /// The shard takes the top bits of the mixed hash...
+            Shard & shard_of( std::uint64_t hash_ ) const
+            { return m_shards[ m_shard_bits == 0 ? 0 : static_cast< size_type >( hash_ >> ( 64 - m_shard_bits ) ) ]; }
+
+            /// ... and the bucket the ones right below them.
+            size_type bucket_of( std::uint64_t hash_ ) const
+            { return static_cast< size_type >( ( hash_ << m_shard_bits ) >> ( 64 - m_bucket_bits ) ); }
+
+            /// The link that refers to the entry for 'key_', or the null one that ends its chain.
+            list_iterator * locate( Shard & shard_, const Key & key_, std::uint64_t hash_ ) const
+            {
+                list_iterator * link = &shard_.buckets[ bucket_of( hash_ ) ];
+                while (*link != list_iterator{} and not ( (*link)->hash == hash_ and m_equal( (*link)->value.first, key_ ) ))
+                    link = &(*link)->chain;
+                return link;
+            }
+
+            /// Takes 'it_' out of its chain (it stays on the recency list).
+            void unchain( Shard & shard_, list_iterator it_ ) const
+            {
+                list_iterator * link = &shard_.buckets[ bucket_of( it_->hash ) ];
+                while (*link != it_) link = &(*link)->chain;
+                *link = it_->chain;
+            }
+
+            /// Replays the buffered hits, oldest first. The shard must be locked exclusively.
+            static void drain( Shard & shard_ )
+            {
+                size_type count = shard_.pending.load();
+                if (count > read_buffer_size) count = read_buffer_size;
+                for (size_type i{0}; i < count; ++i)
+                    shard_.order.splice( shard_.order.cend(), shard_.order, shard_.buffer[ i ] );
+                shard_.pending.store( 0 );
+            }
+
+            /*! Records a hit on 'it_' (shared lock held). @return false if the buffer was
+             *  full, so the caller should try to drain it once the shared lock is released.
+             */
+            static bool record( Shard & shard_, list_iterator it_ )
+            {
+                size_type slot = shard_.pending.fetch_add( 1 );
+                if (slot >= read_buffer_size) return false;
+                shard_.buffer[ slot ] = it_;    // Posição exclusiva: nenhum outro leitor a escreve.
+                return slot + 1 < read_buffer_size;
+            }
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        /*! (1) Constructs an empty cache holding about 'capacity_' entries, split evenly among
+         *  'shards_' shards (rounded up to a power of two). Each shard evicts its own least
+         *  recently used entry when it is full.
+         */
+        explicit sharded_lru( size_type capacity_, size_type shards_ = 16, const Hash & hash_ = Hash(),
+                              const KeyEqual & equal_ = KeyEqual(), const Alloc & alloc_ = Alloc() )
+            : m_shard_count{ 1 }, m_shard_bits{ 0 }, m_bucket_bits{ 1 }, m_hash{ hash_ }, m_equal{ equal_ }, m_shards{ nullptr }
+        {
+            while (m_shard_count < shards_) { m_shard_count <<= 1; ++m_shard_bits; }
+            m_capacity = ( capacity_ + m_shard_count - 1 ) / m_shard_count;
+            if (m_capacity == 0) m_capacity = 1;
+            while (( size_type{1} << m_bucket_bits ) < m_capacity) ++m_bucket_bits;   // Carga máxima de 1: sem rehash.
+            std::allocator< Shard > raw;
+            Shard * shards = raw.allocate( m_shard_count );
+            size_type built{0};
+            try {
+                for ( ; built < m_shard_count; ++built)
+                    ::new ( static_cast< void * >( shards + built ) ) Shard( size_type{1} << m_bucket_bits, alloc_ );
+            }
+            catch (...) {
+                while (built > 0) shards[ --built ].~Shard();
+                raw.deallocate( shards, m_shard_count );
+                throw;
+            }
+            m_shards = shards;
+        }
+
+        ///* (2) A cache shared by threads is neither copied nor moved.
+        sharded_lru( const sharded_lru & ) = delete;
+        sharded_lru & operator=( const sharded_lru & ) = delete;
+
+        ///* (3) Destructs the cache. No other thread may be using it.
+        ~sharded_lru()
+        {
+            for (size_type i{0}; i < m_shard_count; ++i) m_shards[ i ].~Shard();
+            std::allocator< Shard >().deallocate( m_shards, m_shard_count );
+        }
+
+        //!=== [II] Capacity
+        ///* Maximum number of entries (the capacity of a shard times the number of shards).
+        size_type capacity( void ) const { return m_capacity * m_shard_count; }
+        size_type shard_count( void ) const { return m_shard_count; }
+
+        ///* Number of entries; only a snapshot while other threads use the cache.
+        size_type size( void ) const
+        {
+            size_type total{0};
+            for (size_type i{0}; i < m_shard_count; ++i) {
+                detail::shared_guard guard( m_shards[ i ].lock );
+                total += m_shards[ i ].order.size();
+            }
+            return total;
+        }
+
+        bool empty( void ) const { return size() == 0; }
+
+        //!=== [III] Lookup
+        /*! The hit path: copies the value of 'key_' into 'value_' and records the hit, holding
+         *  the shard lock in shared mode only (still three atomic writes to the shard, see above).
+         *  @return false (and 'value_' untouched) on a miss.
+         */
+        bool get( const Key & key_, T & value_ )
+        {
+            std::uint64_t hash = mix( key_ );
+            Shard & shard = shard_of( hash );
+            bool full;
+            {
+                detail::shared_guard guard( shard.lock );
+                list_iterator found = *locate( shard, key_, hash );
+                if (found == list_iterator{}) return false;
+                value_ = found->value.second;
+                full = not record( shard, found );
+            }
+            // Buffer cheio: aplica os acertos, se ninguém estiver escrevendo no shard.
+            if (full and shard.lock.try_lock()) {
+                drain( shard );
+                shard.lock.unlock();
+            }
+            return true;
+        }
+
+        ///* Whether 'key_' is in the cache; not a hit.
+        bool contains( const Key & key_ ) const
+        {
+            std::uint64_t hash = mix( key_ );
+            Shard & shard = shard_of( hash );
+            detail::shared_guard guard( shard.lock );
+            return *locate( shard, key_, hash ) != list_iterator{};
+        }
+
+        //!=== [IV] Modifiers
+        /*! Assigns 'value_' to the entry for 'key_', making it the most recently used, or
+         *  inserts it, evicting the shard's least recently used entry if the shard is full.
+         *  @return true if the entry was inserted.
+         */
+        template < typename M >
+        bool put( const Key & key_, M && value_ )
+        {
+            std::uint64_t hash = mix( key_ );
+            Shard & shard = shard_of( hash );
+            std::lock_guard< detail::shared_spin_lock > guard( shard.lock );
+            drain( shard );
+            list_iterator found = *locate( shard, key_, hash );
+            if (found != list_iterator{}) {
+                found->value.second = std::forward<M>( value_ );
+                shard.order.splice( shard.order.cend(), shard.order, found );
+                return false;
+            }
+            shard.order.emplace_back( key_, std::forward<M>( value_ ), hash );  // Se lançar, nada muda.
+            list_iterator entry = std::prev( shard.order.end() );
+            list_iterator & head = shard.buckets[ bucket_of( hash ) ];
+            entry->chain = head;
+            head = entry;
+            if (shard.order.size() > m_capacity) {
+                unchain( shard, shard.order.begin() );
+                shard.order.pop_front();
+            }
+            return true;
+        }
+
+        ///* Removes the entry for 'key_', if any; returns how many were removed (0 or 1).
+        size_type erase( const Key & key_ )
+        {
+            std::uint64_t hash = mix( key_ );
+            Shard & shard = shard_of( hash );
+            std::lock_guard< detail::shared_spin_lock > guard( shard.lock );
+            drain( shard );
+            list_iterator * link = locate( shard, key_, hash );
+            if (*link == list_iterator{}) return 0;
+            list_iterator entry = *link;
+            *link = entry->chain;
+            shard.order.erase( entry );
+            return 1;
+        }
+
+        ///* Removes every entry, one shard at a time.
+        void clear( void )
+        {
+            for (size_type i{0}; i < m_shard_count; ++i) {
+                Shard & shard = m_shards[ i ];
+                std::lock_guard< detail::shared_spin_lock > guard( shard.lock );
+                shard.pending.store( 0 );
+                std::fill( shard.buckets.begin(), shard.buckets.end(), list_iterator{} );
+                shard.order.clear();
+            }
+        }
+    };
+}
+#endif
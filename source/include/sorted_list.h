@@ -0,0 +1,674 @@
+#ifndef _SORTED_LIST_H_
+#define _SORTED_LIST_H_
+
+#include <algorithm>  // std::equal, std::lexicographical_compare, std::fill
+#include <cstddef>    // std::ptrdiff_t, std::size_t
+#include <cstdint>    // std::uint32_t
+#include <functional> // std::less
+#include <initializer_list>
+#include <iterator>   // bidirectional_iterator_tag
+#include <memory>     // std::allocator, std::allocator_traits
+#include <type_traits> // std::aligned_storage
+#include <utility>    // std::forward, std::move, std::swap, std::pair
+
+#include "list_hook.h"
+
+namespace sc {
+    /*!
+     * A doubly linked list that keeps its elements in ascending order (by `Compare`).
+     *
+     * The nodes are linked as in `sc::list`, which is the bottom level of a skip list:
+     * each node also gets a tower of forward links, of random height (a quarter of the
+     * nodes reach level 1, a sixteenth level 2, and so on), that skips over the nodes
+     * below it. insert(), find(), lower_bound() and upper_bound() descend the towers and
+     * take O(log n) expected; erase() finds the predecessors of the node by the prev links
+     * of the base, with no comparison, in O(log n) amortized. Iteration follows the base
+     * links only and costs what it costs in `sc::list`. merge() and unique() relink the base level with the
+     * algorithms of `sc::list` and then relink every tower in a single O(n) pass.
+     *
+     * Equivalent elements are kept in insertion order (a new one goes after those
+     * already in the list), and merge() is stable, so it behaves as a multiset.
+     *
+     * \note
+     * The elements are only reachable through const iterators: changing one in place
+     * could break the order. A node and its tower are allocated as a single block, the
+     * tower right after the element, so a step on an upper level touches one node only.
+     */
+    template < typename T, typename Compare = std::less<T>, typename Alloc = std::allocator<T> >
+    class sorted_list
+    {
+        public:
+            /// Levels of the skip list, the base one included: enough for about 4^16 elements.
+            static constexpr unsigned max_height = 16;
+
+        private:
+        //=== the links of a node, in the base list and in the upper levels (also used by the sentinel).
+        struct NodeBase : sc::list_hook
+        {
+            NodeBase ** tower;      //!< tower[l - 1]: next node on level l (nullptr past the last one).
+            unsigned height;        //!< Levels the node is linked on (1: only the base list).
+
+            NodeBase() : sc::list_hook{}, tower{ nullptr }, height{ 1 }
+            { /* empty */ }
+        };
+
+        //=== the data node.
+        struct Node : NodeBase
+        {
+            T data;
+
+            /// Constructs 'data' in place from 'args', with null links.
+            template < typename... Args >
+            explicit Node( Args&&... args ) : NodeBase{}, data( std::forward<Args>( args )... )
+            { /* empty */ }
+        };
+
+        static NodeBase * base_of( sc::list_hook * hook_ ) { return static_cast< NodeBase * >( hook_ ); }
+
+        /// Accesses the element of a data node (never of the sentinel).
+        static T & data_of( sc::list_hook * node_ ) { return static_cast< Node * >( base_of( node_ ) )->data; }
+
+        /// Maps a node to its element for the relinking algorithms shared with sc::list.
+        struct value_traits
+        {
+            using value_type = T;
+            static T & value_of( sc::list_hook * node_ ) { return data_of( node_ ); }
+        };
+        using algorithms = sc::detail::list_algorithms< value_traits >;
+
+        /*! A node and its tower come from the client allocator as one block of slots, each
+         *  as large as the alignment of Node, so the block is aligned for the node and the
+         *  tower (at the end of the node) is aligned for pointers.
+         */
+        using slot_type = typename std::aligned_storage< alignof(Node), alignof(Node) >::type;
+        using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+
+        /// Slots in the block of a node of height 'height_'.
+        static std::size_t slots_for( unsigned height_ )
+        { return ( sizeof(Node) + ( height_ - 1 ) * sizeof(NodeBase *) + sizeof(slot_type) - 1 ) / sizeof(slot_type); }
+
+        //=== Private members.
+        private:
+            NodeBase m_sentinel;                    // sentinela: next/prev ligam a lista; tower aponta para m_head.
+            NodeBase * m_head[ max_height - 1 ];    // primeiro nó de cada nível acima da base.
+            unsigned m_height;                      // níveis em uso (ao menos a base).
+            std::size_t m_len;                      // número de elementos.
+            Compare m_comp;
+            node_allocator_type m_alloc;            // alocador dos nós de dados.
+            std::uint32_t m_seed = 2463534242u;     // estado do gerador das alturas (xorshift).
+
+            NodeBase * sentinel( void ) const { return const_cast< NodeBase * >( &m_sentinel ); }
+
+            /// Leaves the list empty, with no level above the base.
+            void reset( void )
+            {
+                algorithms::reset( sentinel() );
+                m_sentinel.tower = m_head;
+                m_sentinel.height = max_height;
+                std::fill( m_head, m_head + ( max_height - 1 ), nullptr );
+                m_height = 1;
+                m_len = 0;
+            }
+
+            /// A random height: 1, and one more level with probability 1/4 each time.
+            unsigned random_height( void )
+            {
+                m_seed ^= m_seed << 13;
+                m_seed ^= m_seed >> 17;
+                m_seed ^= m_seed << 5;
+                unsigned height{1};
+                for (std::uint32_t bits = m_seed; ( bits & 3 ) == 0 and height < max_height; bits >>= 2) ++height;
+                return height;
+            }
+
+            /// Allocates a data node with a tower of random height, and constructs its element in place from 'args_'.
+            template < typename... Args >
+            NodeBase * create_node( Args&&... args_ )
+            {
+                unsigned height = random_height();
+                slot_type * block = node_traits::allocate( m_alloc, slots_for( height ) );
+                Node * node = reinterpret_cast< Node * >( block );
+                try {
+                    node_traits::construct( m_alloc, node, std::forward<Args>( args_ )... );
+                }
+                catch (...) {
+                    node_traits::deallocate( m_alloc, block, slots_for( height ) );
+                    throw;
+                }
+                node->tower = reinterpret_cast< NodeBase ** >( reinterpret_cast< char * >( node ) + sizeof(Node) );
+                node->height = height;
+                return node;
+            }
+
+            /// Destroys and deallocates a data node, with its tower, through the allocator.
+            void destroy_node( sc::list_hook * node_ )
+            {
+                Node * node = static_cast< Node * >( base_of( node_ ) );
+                std::size_t slots = slots_for( node->height );
+                node_traits::destroy( m_alloc, node );
+                node_traits::deallocate( m_alloc, reinterpret_cast< slot_type * >( node ), slots );
+            }
+
+            /// Destroys every node of a list linked only by the base links to 'head_', leaving it empty.
+            void destroy_chain( sc::list_hook * head_ )
+            {
+                auto every = []( sc::list_hook * ){ return true; };
+                algorithms::remove_nodes( head_, every, [&]( sc::list_hook * node ){ destroy_node( node ); } );
+            }
+
+            /*! Descends the levels, moving past every node for which 'before_' holds, and stores
+             *  in 'update_[l]' (if given) the last node passed on each level l > 0.
+             *  @return The first node of the base list for which 'before_' does not hold (or the sentinel).
+             */
+            template < typename Before >
+            NodeBase * descend( Before before_, NodeBase ** update_ ) const
+            {
+                NodeBase * x = sentinel();
+                for (unsigned l = m_height - 1; l > 0; --l) {
+                    for (NodeBase * n = x->tower[ l - 1 ]; n != nullptr and before_( n ); n = x->tower[ l - 1 ]) x = n;
+                    if (update_ != nullptr) update_[ l ] = x;
+                }
+                sc::list_hook * n = x->next;        // Na base, segue os links de sc::list.
+                while (n != sentinel() and before_( base_of( n ) )) n = n->next;
+                return base_of( n );
+            }
+
+            /// The first node not less than 'value_' (the sentinel, if there is none).
+            NodeBase * lower_node( const T & value_ ) const
+            { return descend( [&]( NodeBase * n ){ return m_comp( data_of( n ), value_ ); }, nullptr ); }
+
+            /// The first node greater than 'value_' (the sentinel, if there is none).
+            NodeBase * upper_node( const T & value_ ) const
+            { return descend( [&]( NodeBase * n ){ return not m_comp( value_, data_of( n ) ); }, nullptr ); }
+
+            /// Links 'node_' on every one of its levels, after the elements equivalent to it, in O(log n).
+            NodeBase * link_node( NodeBase * node_ )
+            {
+                NodeBase * update[ max_height ];
+                const T & value = data_of( node_ );
+                NodeBase * pos = descend( [&]( NodeBase * n ){ return not m_comp( value, data_of( n ) ); }, update );
+                for ( ; m_height < node_->height; ++m_height) update[ m_height ] = sentinel();
+                algorithms::link_before( pos, node_ );
+                for (unsigned l{1}; l < node_->height; ++l) {
+                    node_->tower[ l - 1 ] = update[ l ]->tower[ l - 1 ];
+                    update[ l ]->tower[ l - 1 ] = node_;
+                }
+                ++m_len;
+                return node_;
+            }
+
+            /*! Unlinks 'node_' from every one of its levels, without comparing elements (so it
+             *  never throws): the predecessor on level l is the nearest node before it, found
+             *  by the prev links of the base, that is taller than l. O(log n) amortized expected.
+             */
+            void unlink_node( NodeBase * node_ ) noexcept
+            {
+                sc::list_hook * x = node_->prev;
+                for (unsigned l{1}; l < node_->height; ++l) {
+                    // A sentinela tem a altura máxima: a busca para nela.
+                    while (base_of( x )->height <= l) x = x->prev;
+                    base_of( x )->tower[ l - 1 ] = node_->tower[ l - 1 ];
+                }
+                algorithms::unlink( node_ );
+                while (m_height > 1 and m_head[ m_height - 2 ] == nullptr) --m_height;
+                --m_len;
+            }
+
+            /*! Links a null-terminated chain (linked only by 'next') to the sentinel, rebuilding
+             *  the prev links and every level above the base in the same single pass: O(n).
+             */
+            void relink( sc::list_hook * first_ )
+            {
+                NodeBase * last[ max_height ];
+                std::fill( last, last + max_height, sentinel() );
+                unsigned height{1};
+                sc::list_hook * prev_node{ sentinel() };
+                for ( ; first_ != nullptr; first_ = first_->next) {
+                    prev_node->next = first_;
+                    first_->prev = prev_node;
+                    prev_node = first_;
+                    NodeBase * node = base_of( first_ );
+                    for (unsigned l{1}; l < node->height; ++l) {
+                        last[ l ]->tower[ l - 1 ] = node;
+                        last[ l ] = node;
+                    }
+                    if (node->height > height) height = node->height;
+                }
+                prev_node->next = sentinel();
+                sentinel()->prev = prev_node;
+                for (unsigned l{1}; l < max_height; ++l) last[ l ]->tower[ l - 1 ] = nullptr;
+                m_height = height;
+            }
+
+            /// Relinks every level above the base following the order of the base list, in O(n).
+            void rebuild( void ) { relink( algorithms::detach_chain( sentinel() ) ); }
+
+            /*! Links the elements of [first_, last_), already in order, at the end, then builds the
+             *  levels in a single pass: O(n) (used to copy a list). If a constructor throws, the
+             *  list is left empty.
+             */
+            template < typename InputIt >
+            void append_sorted( InputIt first_, InputIt last_ )
+            {
+                try {
+                    for ( ; first_ != last_; ++first_, ++m_len)
+                        algorithms::link_before( sentinel(), create_node( *first_ ) );
+                }
+                catch (...) { clear(); throw; }
+                rebuild();
+            }
+
+            /// Walks the nodes of another list, yielding each element as an rvalue (for the move assignment).
+            struct node_mover
+            {
+                sc::list_hook * node;
+                T && operator*() const { return std::move( data_of( node ) ); }
+                node_mover & operator++() { node = node->next; return *this; }
+                bool operator!=( const node_mover & rhs ) const { return node != rhs.node; }
+            };
+
+            /// Exchanges the nodes (and levels) of two lists.
+            void swap_nodes( sorted_list & other_ ) noexcept
+            {
+                algorithms::swap_nodes( sentinel(), other_.sentinel() );
+                std::swap_ranges( m_head, m_head + ( max_height - 1 ), other_.m_head );
+                std::swap( m_height, other_.m_height );
+                std::swap( m_len, other_.m_len );
+            }
+
+        public:
+            using value_type      = T;
+            using value_compare   = Compare;
+            using allocator_type  = Alloc;
+            using size_type       = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference       = const T &;
+            using const_reference = const T &;
+
+        //=== The iterator class (the elements are read-only, as in std::set).
+        public:
+        class const_iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = const T *;
+                using reference         = const T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_ptr; //!< The node of the element (the sentinel for end()).
+
+            public:
+                const_iterator( NodeBase * ptr = nullptr ) : m_ptr{ ptr } { /* empty */ }
+
+                reference operator*() const { return data_of(m_ptr); }
+                pointer operator->() const { return &data_of(m_ptr); }
+
+                const_iterator & operator++() { m_ptr = base_of( m_ptr->next ); return *this; }
+                const_iterator operator++(int) { const_iterator retval{m_ptr}; ++*this; return retval; }
+                const_iterator & operator--() { m_ptr = base_of( m_ptr->prev ); return *this; }
+                const_iterator operator--(int) { const_iterator retval{m_ptr}; --*this; return retval; }
+
+                bool operator==( const const_iterator & rhs ) const { return m_ptr == rhs.m_ptr; }
+                bool operator!=( const const_iterator & rhs ) const { return m_ptr != rhs.m_ptr; }
+
+                // We need friendship so the list class may access the m_ptr field.
+                friend class sorted_list;
+        };
+        using iterator = const_iterator;
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty list.
+        sorted_list() : sorted_list( Compare(), Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty list ordered by 'comp_', that draws its nodes from 'alloc_'.
+        explicit sorted_list( const Compare & comp_, const Alloc & alloc_ = Alloc() ) : m_comp( comp_ ), m_alloc{ alloc_ }
+        { reset(); }
+
+        ///* (2) Constructs the list with the elements of the range [first, last), sorted, in O(n log n).
+        template < typename InputIt >
+        sorted_list( InputIt first, InputIt last, const Compare & comp_ = Compare(), const Alloc & alloc_ = Alloc() )
+            : sorted_list( comp_, alloc_ )
+        { this->insert( first, last ); }
+
+        ///* (3) Copy constructor: the nodes are linked in order and the levels built in a single pass.
+        sorted_list( const sorted_list & clone_ )
+            : sorted_list( clone_.m_comp, node_traits::select_on_container_copy_construction( clone_.m_alloc ) )
+        { this->append_sorted( clone_.cbegin(), clone_.cend() ); }
+
+        ///* (4) Constructs the list with the elements of the initializer list 'ilist_', sorted.
+        sorted_list( std::initializer_list<T> ilist_, const Compare & comp_ = Compare(), const Alloc & alloc_ = Alloc() )
+            : sorted_list( ilist_.begin(), ilist_.end(), comp_, alloc_ )
+        { /* empty */ }
+
+        ///* (3a) Move constructor. Takes over the nodes of 'other' in O(1); 'other' is left empty.
+        sorted_list( sorted_list && other ) noexcept : sorted_list( other.m_comp, Alloc( other.m_alloc ) )
+        { this->swap_nodes( other ); }
+
+        ///* (5) Destructs the list.
+        ~sorted_list() { clear(); }
+
+        ///* (6) Copy assignment operator.
+        sorted_list & operator=( const sorted_list & rhs )
+        {
+            if (this != &rhs) {
+                this->clear();
+                if (node_traits::propagate_on_container_copy_assignment::value) m_alloc = rhs.m_alloc;
+                m_comp = rhs.m_comp;
+                this->append_sorted( rhs.cbegin(), rhs.cend() );
+            }
+            return *this;
+        }
+
+        ///* (6a) Move assignment operator. Takes over the nodes of 'rhs', which is left empty.
+        ///* If the allocators differ and do not propagate, the elements are moved one by one.
+        sorted_list & operator=( sorted_list && rhs ) noexcept( node_traits::propagate_on_container_move_assignment::value )
+        {
+            if (this != &rhs) {
+                this->clear();
+                m_comp = rhs.m_comp;
+                if (node_traits::propagate_on_container_move_assignment::value or m_alloc == rhs.m_alloc) {
+                    if (node_traits::propagate_on_container_move_assignment::value)
+                        m_alloc = std::move(rhs.m_alloc);
+                    this->swap_nodes( rhs );            // Troca em O(1): this está vazia.
+                }
+                else {
+                    sc::list_hook * end = rhs.sentinel();
+                    this->append_sorted( node_mover{ end->next }, node_mover{ end } );
+                    rhs.clear();
+                }
+            }
+            return *this;
+        }
+
+        ///* (7) Replaces the contents with the elements of the initializer list 'ilist_', sorted.
+        sorted_list & operator=( std::initializer_list<T> ilist_ )
+        {
+            this->clear();
+            this->insert( ilist_.begin(), ilist_.end() );
+            return *this;
+        }
+
+        ///* Returns a copy of the allocator associated with the list.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        ///* Returns the function object that orders the elements.
+        value_compare value_comp( void ) const { return m_comp; }
+
+        //!=== [II] ITERATORS (in ascending order)
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return const_iterator{ base_of( sentinel()->next ) }; }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator{ sentinel() }; }
+
+        //!=== [III] Capacity/Status and element access
+        ///* Check if the list is empty, that is, there are no elements.
+        bool empty( void ) const { return m_len == 0; }
+
+        ///* Check the size of the list.
+        size_type size( void ) const { return m_len; }
+
+        ///* Returns the least element.
+        const T & front( void ) const { return data_of( sentinel()->next ); }
+
+        ///* Returns the greatest element.
+        const T & back( void ) const { return data_of( sentinel()->prev ); }
+
+        //!=== [IV] Lookup, in O(log n) expected
+        ///* Returns an iterator to the first element not less than 'value_' (or end()).
+        const_iterator lower_bound( const T & value_ ) const { return const_iterator{ lower_node( value_ ) }; }
+
+        ///* Returns an iterator to the first element greater than 'value_' (or end()).
+        const_iterator upper_bound( const T & value_ ) const { return const_iterator{ upper_node( value_ ) }; }
+
+        ///* Returns the range of the elements equivalent to 'value_'.
+        std::pair< const_iterator, const_iterator > equal_range( const T & value_ ) const
+        {
+            const_iterator first = lower_bound( value_ );
+            const_iterator last = first;
+            while (last != cend() and not m_comp( value_, *last )) ++last;  // Os equivalentes são vizinhos.
+            return { first, last };
+        }
+
+        ///* Returns an iterator to the first element equivalent to 'value_', or end() if there is none.
+        const_iterator find( const T & value_ ) const
+        {
+            NodeBase * node = lower_node( value_ );
+            return node == sentinel() or m_comp( value_, data_of( node ) ) ? cend() : const_iterator{ node };
+        }
+
+        ///* Checks whether some element is equivalent to 'value_'.
+        bool contains( const T & value_ ) const { return find( value_ ) != cend(); }
+
+        ///* Counts the elements equivalent to 'value_'.
+        size_type count( const T & value_ ) const
+        {
+            auto range = equal_range( value_ );
+            size_type n{0};
+            for ( ; range.first != range.second; ++range.first) ++n;
+            return n;
+        }
+
+        //!=== [V] Modifiers
+        ///* Remove all elements from the container.
+        void clear()
+        {
+            sc::list_hook * node = sentinel()->next;
+            while (node != sentinel()) {
+                sc::list_hook * next = node->next;
+                destroy_node( node );
+                node = next;
+            }
+            reset();
+        }
+
+        ///* Constructs an element in place and inserts it after its equivalents, in O(log n); returns an iterator to it.
+        template < typename... Args >
+        const_iterator emplace( Args&&... args_ )
+        {
+            NodeBase * node = create_node( std::forward<Args>( args_ )... );
+            try { return const_iterator{ link_node( node ) }; }
+            catch (...) { destroy_node( node ); throw; }    // O comparador lançou: a lista não mudou.
+        }
+
+        ///* Inserts 'value_' after its equivalents, in O(log n); returns an iterator to it.
+        const_iterator insert( const T & value_ ) { return this->emplace( value_ ); }
+        const_iterator insert( T && value_ ) { return this->emplace( std::move( value_ ) ); }
+
+        /*! Inserts the elements of [first_, last_). A few are inserted one by one; a range
+         *  comparable to the size of the list is linked aside, sorted with the merge sort of
+         *  sc::list and merged in, and the levels are then rebuilt, in O(n + k log k) overall.
+         *  If a constructor throws, the list is left as it was. If the comparator throws, the
+         *  list stays sorted and keeps every element it had; the new elements not in it yet
+         *  are destroyed, and no node is leaked.
+         */
+        template < typename InputIt >
+        void insert( InputIt first_, InputIt last_ )
+        {
+            NodeBase batch;                         // Os novos nós, só na base, fora da lista.
+            algorithms::reset( &batch );
+            size_type count{0};
+            try {
+                for ( ; first_ != last_; ++first_, ++count)
+                    algorithms::link_before( &batch, create_node( *first_ ) );
+            }
+            catch (...) { destroy_chain( &batch ); throw; }
+            if (count * max_height < m_len) {
+                try {
+                    while (batch.next != &batch) {
+                        NodeBase * node = base_of( batch.next );
+                        algorithms::unlink( node );
+                        try { link_node( node ); }
+                        catch (...) { destroy_node( node ); throw; }
+                    }
+                }
+                catch (...) { destroy_chain( &batch ); throw; }     // Os que já entraram ficam.
+                return;
+            }
+            try { algorithms::sort( &batch, m_comp ); }
+            catch (...) { destroy_chain( &batch ); throw; }    // A lista não mudou.
+            sc::list_hook * merged = algorithms::detach_chain( sentinel() );
+            sc::list_hook * rest{ nullptr };
+            try {
+                algorithms::merge_chains( merged, algorithms::detach_chain( &batch ), m_comp, &rest );
+            }
+            catch (...) {
+                // O que já foi intercalado fica, em ordem; o resto do lote é destruído.
+                for (sc::list_hook * next; rest != nullptr; rest = next, --count) {
+                    next = rest->next;
+                    destroy_node( rest );
+                }
+                m_len += count;
+                relink( merged );
+                throw;
+            }
+            m_len += count;
+            relink( merged );
+        }
+
+        ///* Inserts the elements of 'ilist_'.
+        void insert( std::initializer_list<T> ilist_ ) { this->insert( ilist_.begin(), ilist_.end() ); }
+
+        ///* Erases the element at 'pos_', with no comparison and no throw; returns an iterator to the element after it.
+        const_iterator erase( const_iterator pos_ ) noexcept
+        {
+            NodeBase * next = base_of( pos_.m_ptr->next );
+            unlink_node( pos_.m_ptr );
+            destroy_node( pos_.m_ptr );
+            return const_iterator{ next };
+        }
+
+        ///* Erases the elements of [first_, last_), each in O(log n); returns 'last_'.
+        const_iterator erase( const_iterator first_, const_iterator last_ )
+        {
+            while (first_ != last_) first_ = erase( first_ );
+            return last_;
+        }
+
+        ///* Erases every element equivalent to 'value_'; returns how many were erased.
+        size_type erase( const T & value_ )
+        {
+            auto range = equal_range( value_ );
+            size_type n{0};
+            for ( ; range.first != range.second; ++n) range.first = erase( range.first );
+            return n;
+        }
+
+        ///* Removes the least element.
+        void pop_front( void ) { erase( cbegin() ); }
+
+        ///* Removes the greatest element.
+        void pop_back( void ) { erase( const_iterator{ base_of( sentinel()->prev ) } ); }
+
+        ///* Exchanges the contents of the list with those of 'other' in O(1).
+        void swap( sorted_list & other ) noexcept
+        {
+            if (node_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap( m_alloc, other.m_alloc );
+            }
+            using std::swap;
+            swap( m_comp, other.m_comp );
+            this->swap_nodes( other );
+        }
+
+        //!=== [VI] UTILITY METHODS
+        /*! Merges the elements of 'other' into *this with the stable merge of sc::list (the
+         *  elements of *this go first among equivalents); the prev links and the levels are
+         *  then rebuilt together, in one more pass: O(n + m) overall. 'other' is left empty.
+         *  If the comparison throws, both lists stay sorted and no element is lost: those of
+         *  'other' not merged yet are left in it.
+         */
+        void merge( sorted_list & other )
+        {
+            if (other.empty() or this == &other) return;
+            size_type count = other.m_len;
+            sc::list_hook * merged = algorithms::detach_chain( sentinel() );
+            sc::list_hook * rest{ nullptr };
+            try {
+                algorithms::merge_chains( merged, algorithms::detach_chain( other.sentinel() ), m_comp, &rest );
+            }
+            catch (...) {
+                size_type left{0};
+                for (sc::list_hook * node = rest; node != nullptr; node = node->next) ++left;
+                m_len += count - left;
+                relink( merged );
+                other.m_len = left;
+                other.relink( rest );
+                throw;
+            }
+            m_len += count;
+            relink( merged );
+            other.m_len = 0;
+            other.relink( nullptr );
+        }
+
+        ///* Removes all but the first of each run of equivalent elements, in O(n).
+        void unique( void )
+        {
+            auto equivalent = [&]( const T & a, const T & b ){ return not m_comp( a, b ); };  // Em ordem, a <= b.
+            this->unique( equivalent );
+        }
+
+        ///* Removes every element for which 'pred', applied to the element kept before it and to itself, returns true.
+        template < typename BinaryPredicate >
+        void unique( BinaryPredicate pred )
+        {
+            try {
+                algorithms::unique( sentinel(), pred, [&]( sc::list_hook * node ){ destroy_node( node ); --m_len; } );
+            }
+            catch (...) { rebuild(); throw; }
+            rebuild();
+        }
+
+        ///* Removes every element for which 'pred' returns true, in O(n); returns how many were removed.
+        template < typename UnaryPredicate >
+        size_type remove_if( UnaryPredicate pred )
+        {
+            size_type removed{0};
+            try {
+                removed = algorithms::remove_if( sentinel(), pred, [&]( sc::list_hook * node ){ destroy_node( node ); --m_len; } );
+            }
+            catch (...) { rebuild(); throw; }
+            rebuild();
+            return removed;
+        }
+    };
+
+    //!=== [VII] OPERATORS
+
+    ///* Checks if the contents of 'l1_' and 'l2_' are equal.
+    template < typename T, typename Compare, typename Alloc >
+    inline bool operator==( const sc::sorted_list<T, Compare, Alloc> & l1_, const sc::sorted_list<T, Compare, Alloc> & l2_ )
+    {
+        return l1_.size() == l2_.size() and std::equal( l1_.cbegin(), l1_.cend(), l2_.cbegin() );
+    }
+
+    ///* Checks if the contents of 'l1_' and 'l2_' are different.
+    template < typename T, typename Compare, typename Alloc >
+    inline bool operator!=( const sc::sorted_list<T, Compare, Alloc> & l1_, const sc::sorted_list<T, Compare, Alloc> & l2_ )
+    {
+        return not ( l1_ == l2_ );
+    }
+
+    ///* Compares 'l1_' and 'l2_' lexicographically.
+    template < typename T, typename Compare, typename Alloc >
+    inline bool operator<( const sc::sorted_list<T, Compare, Alloc> & l1_, const sc::sorted_list<T, Compare, Alloc> & l2_ )
+    {
+        return std::lexicographical_compare( l1_.cbegin(), l1_.cend(), l2_.cbegin(), l2_.cend() );
+    }
+
+    ///* Exchanges the contents of 'l1_' and 'l2_' in O(1).
+    template < typename T, typename Compare, typename Alloc >
+    inline void swap( sc::sorted_list<T, Compare, Alloc> & l1_, sc::sorted_list<T, Compare, Alloc> & l2_ )
+    {
+        l1_.swap( l2_ );
+    }
+}
+#endif
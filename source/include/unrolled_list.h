@@ -0,0 +1,738 @@
+#ifndef _UNROLLED_LIST_H_
+#define _UNROLLED_LIST_H_
+
+#include <algorithm>  // std::stable_sort, std::reverse
+#include <cassert>    // assert()
+#include <cstddef>    // std::ptrdiff_t, std::size_t
+#include <functional> // std::less, std::equal_to
+#include <initializer_list>
+#include <iterator>   // bidirectional_iterator_tag, make_move_iterator
+#include <memory>     // std::allocator, std::allocator_traits
+#include <stdexcept>  // std::length_error
+#include <type_traits>
+#include <utility>    // std::forward, std::move, std::swap
+#include <vector>     // sort buffer
+
+namespace sc {
+    /*!
+     * A doubly linked list that stores several elements per node (an unrolled list).
+     *
+     * Each node packs a small array of elements after its links, so that a node
+     * takes about `BytesPerNode` bytes (one cache line by default). A traversal
+     * then touches one node per `capacity` elements, instead of one per element.
+     *
+     * The interface follows `sc::list`, with one important difference: since the
+     * elements of a node are shifted when an element is inserted into or erased
+     * from it, those operations invalidate the iterators to the other elements of
+     * the affected nodes. The element type must be nothrow move constructible.
+     */
+    template < typename T, std::size_t BytesPerNode = 64, typename Alloc = std::allocator<T> >
+    class unrolled_list
+    {
+        static_assert( std::is_nothrow_move_constructible<T>::value,
+                       "unrolled_list shifts elements between slots: T must be nothrow move constructible" );
+
+        private:
+        //=== the links of a node (also used, alone, by the sentinel).
+        struct NodeBase
+        {
+            NodeBase * next;
+            NodeBase * prev;
+        };
+
+        /// Bytes taken by the links and the element count of a node.
+        static constexpr std::size_t header_size = sizeof(NodeBase) + sizeof(std::size_t);
+
+        public:
+            /// Number of elements stored in each node (at least one).
+            static constexpr std::size_t capacity =
+                BytesPerNode >= header_size + sizeof(T) ? ( BytesPerNode - header_size ) / sizeof(T) : 1;
+
+        private:
+        //=== the data node: 'count' constructed elements at the beginning of 'slots'.
+        struct Node : NodeBase
+        {
+            std::size_t count;
+            typename std::aligned_storage< sizeof(T), alignof(T) >::type slots[ capacity ];
+
+            Node() : NodeBase{ nullptr, nullptr }, count{ 0 } { /* empty */ }
+
+            T * data( void ) { return reinterpret_cast< T * >( slots ); }
+            const T * data( void ) const { return reinterpret_cast< const T * >( slots ); }
+        };
+
+        static Node * as_node( NodeBase * node_ ) { return static_cast< Node * >( node_ ); }
+        static const Node * as_node( const NodeBase * node_ ) { return static_cast< const Node * >( node_ ); }
+
+        public:
+            using value_type      = T;
+            using allocator_type  = Alloc;
+            using size_type       = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference       = T &;
+            using const_reference = const T &;
+
+        private:
+            /// Nodes are drawn from the client allocator, rebound to Node.
+            using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+            using node_traits = std::allocator_traits<node_allocator_type>;
+
+        //=== The iterator classes: a node plus the index of the element inside it.
+        public:
+        class const_iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = const T *;
+                using reference         = const T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_node;   //!< The node (the sentinel for end()).
+                std::size_t m_index; //!< The element inside the node.
+
+            public:
+                const_iterator( NodeBase * node_ = nullptr, std::size_t index_ = 0 ) : m_node{ node_ }, m_index{ index_ }
+                { /* empty */ }
+
+                reference operator*() const { return as_node(m_node)->data()[ m_index ]; }
+                pointer operator->() const { return as_node(m_node)->data() + m_index; }
+
+                /// Moves to the next element, which may be the first one of the next node.
+                const_iterator & operator++()
+                {
+                    if (++m_index == as_node(m_node)->count) { m_node = m_node->next; m_index = 0; }
+                    return *this;
+                }
+                const_iterator operator++(int) { const_iterator retval{ *this }; ++(*this); return retval; }
+
+                /// Moves to the previous element, which may be the last one of the previous node.
+                const_iterator & operator--()
+                {
+                    if (m_index == 0) { m_node = m_node->prev; m_index = as_node(m_node)->count; }
+                    --m_index;
+                    return *this;
+                }
+                const_iterator operator--(int) { const_iterator retval{ *this }; --(*this); return retval; }
+
+                bool operator==( const const_iterator & rhs ) const { return m_node == rhs.m_node and m_index == rhs.m_index; }
+                bool operator!=( const const_iterator & rhs ) const { return not (*this == rhs); }
+
+                // We need friendship so the list class may access the position.
+                friend class unrolled_list;
+        };
+
+        class iterator
+        {
+            public:
+                using value_type        = T;
+                using pointer           = T *;
+                using reference         = T &;
+                using difference_type   = std::ptrdiff_t;
+                using iterator_category = std::bidirectional_iterator_tag;
+
+            private:
+                NodeBase * m_node;   //!< The node (the sentinel for end()).
+                std::size_t m_index; //!< The element inside the node.
+
+            public:
+                iterator( NodeBase * node_ = nullptr, std::size_t index_ = 0 ) : m_node{ node_ }, m_index{ index_ }
+                { /* empty */ }
+
+                /// Every iterator may be used where a const_iterator is expected.
+                operator const_iterator() const { return const_iterator{ m_node, m_index }; }
+
+                reference operator*() const { return as_node(m_node)->data()[ m_index ]; }
+                pointer operator->() const { return as_node(m_node)->data() + m_index; }
+
+                /// Moves to the next element, which may be the first one of the next node.
+                iterator & operator++()
+                {
+                    if (++m_index == as_node(m_node)->count) { m_node = m_node->next; m_index = 0; }
+                    return *this;
+                }
+                iterator operator++(int) { iterator retval{ *this }; ++(*this); return retval; }
+
+                /// Moves to the previous element, which may be the last one of the previous node.
+                iterator & operator--()
+                {
+                    if (m_index == 0) { m_node = m_node->prev; m_index = as_node(m_node)->count; }
+                    --m_index;
+                    return *this;
+                }
+                iterator operator--(int) { iterator retval{ *this }; --(*this); return retval; }
+
+                bool operator==( const iterator & rhs ) const { return m_node == rhs.m_node and m_index == rhs.m_index; }
+                bool operator!=( const iterator & rhs ) const { return not (*this == rhs); }
+
+                // We need friendship so the list class may access the position.
+                friend class unrolled_list;
+        };
+
+        //=== Private members.
+        private:
+            std::size_t m_len;           // number of elements (not of nodes).
+            NodeBase m_sentinel;         // sentinel (no elements): next is the first node and prev, the last.
+            node_allocator_type m_alloc; // allocator of the nodes.
+
+            NodeBase * sentinel( void ) const { return const_cast< NodeBase * >( &m_sentinel ); }
+
+            /// Allocates an empty node and links it right before 'pos_'.
+            Node * create_node_before( NodeBase * pos_ )
+            {
+                Node * node = node_traits::allocate( m_alloc, 1 );
+                ::new ( static_cast< void * >( node ) ) Node();
+                node->next = pos_;
+                node->prev = pos_->prev;
+                pos_->prev->next = node;
+                pos_->prev = node;
+                return node;
+            }
+
+            /// Unlinks and releases a node whose elements were already destroyed or moved out.
+            void destroy_node( NodeBase * node_ )
+            {
+                node_->prev->next = node_->next;
+                node_->next->prev = node_->prev;
+                Node * node = as_node(node_);
+                node->~Node();
+                node_traits::deallocate( m_alloc, node, 1 );
+            }
+
+            /// Move-constructs 'src_' into the raw slot 'dst_' and destroys 'src_'.
+            void relocate( T * dst_, T * src_ )
+            {
+                node_traits::construct( m_alloc, dst_, std::move( *src_ ) );
+                node_traits::destroy( m_alloc, src_ );
+            }
+
+            /// Moves the elements [from_, count) of 'src_' to the end of 'dst_' (which must fit them).
+            void move_tail( Node * src_, std::size_t from_, Node * dst_ )
+            {
+                for (std::size_t i{from_}; i < src_->count; ++i)
+                    relocate( dst_->data() + dst_->count++, src_->data() + i );
+                src_->count = from_;
+            }
+
+            /*! Opens an uninitialized slot for a new element before the position ('node_', 'index_').
+             *  A full node is split in half (or, when inserting at its front, a new node is put before it).
+             *  @return The node and the index of the slot; the element count already includes it.
+             */
+            std::pair< Node *, std::size_t > make_room( NodeBase * node_, std::size_t index_ )
+            {
+                Node * node;
+                std::size_t i{index_};
+                NodeBase * prev = node_->prev;
+                if (i == 0 and prev != sentinel() and as_node(prev)->count < capacity) {
+                    // Append to the previous node, which has room: nothing is shifted.
+                    node = as_node(prev);
+                    i = node->count;
+                }
+                else if (i == 0 and (node_ == sentinel() or as_node(node_)->count == capacity)) {
+                    node = create_node_before( node_ );
+                }
+                else if (as_node(node_)->count == capacity) {
+                    // Splits the full node: its upper half goes to a new node right after it.
+                    Node * fresh = create_node_before( node_->next );
+                    std::size_t half = capacity / 2;
+                    move_tail( as_node(node_), half, fresh );
+                    node = as_node(node_);
+                    if (i > half) { node = fresh; i -= half; }
+                }
+                else node = as_node(node_);
+                // Shifts [i, count) one slot to the right.
+                for (std::size_t k{node->count}; k > i; --k)
+                    relocate( node->data() + k, node->data() + k - 1 );
+                ++node->count;
+                ++m_len;
+                return std::make_pair( node, i );
+            }
+
+            /// Destroys every element from the position ('node_', 'index_') to the end, releasing the emptied nodes.
+            void truncate( NodeBase * node_, std::size_t index_ )
+            {
+                if (node_ == sentinel()) return;
+                Node * node = as_node(node_);
+                for (std::size_t i{index_}; i < node->count; ++i)
+                    node_traits::destroy( m_alloc, node->data() + i );
+                m_len -= node->count - index_;
+                node->count = index_;
+                NodeBase * current = index_ == 0 ? node_ : node_->next;
+                while (current != sentinel()) {
+                    NodeBase * next = current->next;
+                    Node * n = as_node(current);
+                    for (std::size_t i{0}; i < n->count; ++i)
+                        node_traits::destroy( m_alloc, n->data() + i );
+                    m_len -= n->count;
+                    destroy_node( current );
+                    current = next;
+                }
+            }
+
+            /*! Moves the element at 'head_' in the first node of 'src_' to the end of this list,
+             *  in a new node if the last one is full, and advances 'head_'. The elements before
+             *  'head_' were already moved out; the node is released once it is drained.
+             */
+            void take_front( unrolled_list & src_, std::size_t & head_ )
+            {
+                Node * last = as_node( sentinel()->prev );
+                if (m_len == 0 or last->count == capacity) last = create_node_before( sentinel() );
+                Node * first = as_node( src_.sentinel()->next );
+                relocate( last->data() + last->count++, first->data() + head_++ );
+                ++m_len;
+                --src_.m_len;
+                if (head_ == first->count) {
+                    src_.destroy_node( first );
+                    head_ = 0;
+                }
+            }
+
+            /// Closes the gap left by take_front(): the first 'head_' slots of the first node are shifted out.
+            void close_front( std::size_t head_ ) noexcept
+            {
+                if (head_ == 0) return;
+                Node * first = as_node( sentinel()->next );
+                for (std::size_t i{head_}; i < first->count; ++i)
+                    relocate( first->data() + i - head_, first->data() + i );
+                first->count -= head_;
+            }
+
+            /// Exchanges the nodes and sizes of two lists, fixing the links to both sentinels.
+            void swap_nodes( unrolled_list & other_ ) noexcept
+            {
+                std::swap( m_sentinel, other_.m_sentinel );
+                std::swap( m_len, other_.m_len );
+                this->adopt_nodes();
+                other_.adopt_nodes();
+            }
+
+            /// Makes the first and last nodes (if any) point back to this list's sentinel.
+            void adopt_nodes( void ) noexcept
+            {
+                if (m_len == 0) reset_sentinel();
+                else {
+                    m_sentinel.next->prev = &m_sentinel;
+                    m_sentinel.prev->next = &m_sentinel;
+                }
+            }
+
+            /// Links the sentinel to itself: the list becomes empty (no node is released).
+            void reset_sentinel( void ) noexcept
+            {
+                m_len = 0;
+                m_sentinel.next = &m_sentinel;
+                m_sentinel.prev = &m_sentinel;
+            }
+
+        public:
+        //=== Public interface
+
+        //!=== [I] Special members
+        ///* (1) Default constructor that creates an empty list. No memory is allocated.
+        unrolled_list() noexcept( std::is_nothrow_default_constructible<Alloc>::value ) : unrolled_list( Alloc() )
+        { /* empty */ }
+
+        ///* (1a) Constructs an empty list that draws its nodes from 'alloc_'.
+        explicit unrolled_list( const Alloc & alloc_ ) noexcept : m_alloc{ alloc_ }
+        { reset_sentinel(); }
+
+        ///* (2) Constructs the list with 'count' default-inserted instances of T.
+        explicit unrolled_list( size_type count, const Alloc & alloc_ = Alloc() ) : unrolled_list( alloc_ )
+        {
+            try {
+                for (size_type i{0}; i < count; ++i) this->emplace_back();
+            }
+            catch (...) { clear(); throw; }
+        }
+
+        ///* (3) Constructs the list with the contents of the range [first, last).
+        template < typename InputIt >
+        unrolled_list( InputIt first, InputIt last, const Alloc & alloc_ = Alloc() ) : unrolled_list( alloc_ )
+        {
+            try {
+                for ( ; first != last; ++first) this->emplace_back( *first );
+            }
+            catch (...) { clear(); throw; }
+        }
+
+        ///* (4) Copy constructor. Constructs a new list with the content of the 'clone_'.
+        unrolled_list( const unrolled_list & clone_ )
+            : unrolled_list( clone_.cbegin(), clone_.cend(),
+                             Alloc( node_traits::select_on_container_copy_construction( clone_.m_alloc ) ) )
+        { /* empty */ }
+
+        ///* (4a) Move constructor. Takes over the nodes of 'other' in O(1); 'other' is left empty.
+        unrolled_list( unrolled_list && other ) noexcept : m_alloc{ std::move( other.m_alloc ) }
+        {
+            reset_sentinel();
+            this->swap_nodes( other );
+        }
+
+        ///* (5) Constructs the list with the contents of the initializer list 'ilist_'.
+        unrolled_list( std::initializer_list<T> ilist_, const Alloc & alloc_ = Alloc() )
+            : unrolled_list( ilist_.begin(), ilist_.end(), alloc_ )
+        { /* empty */ }
+
+        ///* (6) Destructs the list.
+        ~unrolled_list() { clear(); }
+
+        ///* (7) Copy assignment operator. Replaces the contents with a copy of the contents of 'rhs'.
+        unrolled_list & operator=( const unrolled_list & rhs )
+        {
+            if (this != &rhs) {
+                this->clear();
+                if (node_traits::propagate_on_container_copy_assignment::value)
+                    m_alloc = rhs.m_alloc;
+                for (const auto & e : rhs) this->emplace_back( e );
+            }
+            return *this;
+        }
+
+        ///* (7a) Move assignment operator. Takes over the nodes of 'rhs', which is left empty.
+        ///* If the allocators differ and do not propagate, the elements are moved one by one.
+        unrolled_list & operator=( unrolled_list && rhs ) noexcept( node_traits::propagate_on_container_move_assignment::value )
+        {
+            if (this != &rhs) {
+                this->clear();
+                if (node_traits::propagate_on_container_move_assignment::value or m_alloc == rhs.m_alloc) {
+                    if (node_traits::propagate_on_container_move_assignment::value)
+                        m_alloc = std::move(rhs.m_alloc);
+                    this->swap_nodes( rhs );
+                }
+                else {
+                    for (auto & e : rhs) this->emplace_back( std::move(e) );
+                    rhs.clear();
+                }
+            }
+            return *this;
+        }
+
+        ///* (8) Replaces the contents with those identified by initializer list 'ilist_'.
+        unrolled_list & operator=( std::initializer_list<T> ilist_ )
+        {
+            this->clear();
+            for (const auto & e : ilist_) this->emplace_back( e );
+            return *this;
+        }
+
+        ///* Returns a copy of the allocator associated with the list.
+        allocator_type get_allocator( void ) const { return allocator_type( m_alloc ); }
+
+        //!=== [II] ITERATORS
+        iterator begin() { return iterator{ sentinel()->next }; }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return const_iterator{ sentinel()->next }; }
+        iterator end() { return iterator{ sentinel() }; }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator{ sentinel() }; }
+
+        //!=== [III] Capacity/Status
+        ///* Check if the list is empty, that is, there are no elements.
+        bool empty( void ) const { return m_len == 0; }
+
+        ///* Check the size of the list.
+        size_type size( void ) const { return m_len; }
+
+        //!=== [IV] Modifiers
+        ///* Remove all elements from the container.
+        void clear() { truncate( sentinel()->next, 0 ); }
+
+        ///* Returns the object at the beginning of the list.
+        T & front( void )
+        {
+            if (empty())
+                throw std::length_error("[unrolled_list::front()]: empty list.");
+            return *begin();
+        }
+        const T & front( void ) const
+        {
+            if (empty())
+                throw std::length_error("[unrolled_list::front()]: empty list.");
+            return *cbegin();
+        }
+
+        ///* Returns the object at the end of the list.
+        T & back( void )
+        {
+            if (empty())
+                throw std::length_error("[unrolled_list::back()]: empty list.");
+            return *(--end());
+        }
+        const T & back( void ) const
+        {
+            if (empty())
+                throw std::length_error("[unrolled_list::back()]: empty list.");
+            return *(--cend());
+        }
+
+        ///* Adds 'value' to the front of the list.
+        void push_front( const T & value_ ) { this->emplace( this->begin(), value_ ); }
+        ///* Moves 'value' to the front of the list.
+        void push_front( T && value_ ) { this->emplace( this->begin(), std::move(value_) ); }
+
+        ///* Adds 'value' to the end of the list.
+        void push_back( const T & value_ ) { this->emplace( this->end(), value_ ); }
+        ///* Moves 'value' to the end of the list.
+        void push_back( T && value_ ) { this->emplace( this->end(), std::move(value_) ); }
+
+        ///* Constructs an element in place, from 'args_', at the front of the list.
+        template < typename... Args >
+        T & emplace_front( Args&&... args_ ) { return *this->emplace( this->begin(), std::forward<Args>(args_)... ); }
+
+        ///* Constructs an element in place, from 'args_', at the end of the list.
+        template < typename... Args >
+        T & emplace_back( Args&&... args_ ) { return *this->emplace( this->end(), std::forward<Args>(args_)... ); }
+
+        ///* Removes the object at the front of the list.
+        void pop_front( void ) { this->erase( this->begin() ); }
+
+        ///* Removes the object at the end of the list.
+        void pop_back( void ) { this->erase( --this->end() ); }
+
+        ///* Exchanges the contents of the list with those of 'other' in O(1).
+        void swap( unrolled_list & other ) noexcept
+        {
+            if (node_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap( m_alloc, other.m_alloc );
+            }
+            this->swap_nodes( other );
+        }
+
+        //!=== [IV-a] MODIFIERS W/ ITERATORS
+        /*!
+         *  Constructs a new element, from 'args_', before the iterator 'pos_'.
+         *  The element is first built aside, so that nothing changes if its constructor throws;
+         *  then the elements after 'pos_' in the same node are shifted (or the node is split).
+         *
+         *  \param pos_ An iterator to the position before which we want to insert the new data.
+         *  \param args_ Arguments forwarded to the constructor of T.
+         *  \return An iterator to the new element in the list.
+         */
+        template < typename... Args >
+        iterator emplace( const_iterator pos_, Args&&... args_ )
+        {
+            T value( std::forward<Args>(args_)... );
+            auto slot = make_room( pos_.m_node, pos_.m_index );
+            node_traits::construct( m_alloc, slot.first->data() + slot.second, std::move(value) );
+            return iterator{ slot.first, slot.second };
+        }
+
+        /// Inserts a copy of 'value_' before 'pos_'; returns an iterator to the new element.
+        iterator insert( const_iterator pos_, const T & value_ ) { return this->emplace( pos_, value_ ); }
+
+        /// Moves 'value_' into a new element before 'pos_'; returns an iterator to the new element.
+        iterator insert( const_iterator pos_, T && value_ ) { return this->emplace( pos_, std::move(value_) ); }
+
+        /*! Inserts the elements of the range [first_, last_) before 'pos_'.
+         *  @return Iterator to the first inserted element, or 'pos_' if the range is empty.
+         */
+        template < typename InItr >
+        iterator insert( const_iterator pos_, InItr first_, InItr last_ )
+        {
+            if (first_ == last_) return iterator{ pos_.m_node, pos_.m_index };
+            // The first insertion may move the element at 'pos_'; the next ones go right after the last one inserted.
+            iterator first = this->emplace( pos_, *first_ );
+            iterator it{ first };
+            size_type n{1};
+            for (++first_; first_ != last_; ++first_, ++n)
+                it = this->emplace( std::next( it ), *first_ );
+            // Earlier insertions may have shifted the first element: walk back from the last one.
+            while (--n > 0) --it;
+            return it;
+        }
+
+        /// Inserts the elements of 'ilist_' before 'pos_'; returns an iterator to the first of them.
+        iterator insert( const_iterator pos_, std::initializer_list<T> ilist_ )
+        { return this->insert( pos_, ilist_.begin(), ilist_.end() ); }
+
+        /*!
+         *  Erases the element at 'pos_'. The elements after it in the same node are shifted;
+         *  a node left less than half full absorbs the next one, when it fits.
+         *
+         *  \param pos_ The element we wish to delete.
+         *  \return An iterator to the element following the deleted one.
+         */
+        iterator erase( const_iterator pos_ )
+        {
+            Node * node = as_node(pos_.m_node);
+            std::size_t i{pos_.m_index};
+            node_traits::destroy( m_alloc, node->data() + i );
+            for (std::size_t k{i + 1}; k < node->count; ++k)
+                relocate( node->data() + k - 1, node->data() + k );
+            --node->count;
+            --m_len;
+            if (node->count == 0) {
+                NodeBase * next = node->next;
+                destroy_node( node );
+                return iterator{ next };
+            }
+            NodeBase * next = node->next;
+            if (next != sentinel() and node->count < capacity / 2 and node->count + as_node(next)->count <= capacity) {
+                move_tail( as_node(next), 0, node );
+                destroy_node( next );
+            }
+            if (i == node->count) return iterator{ node->next };
+            return iterator{ node, i };
+        }
+
+        /// Erases the elements in [first_, last_); returns an iterator to the element following them.
+        iterator erase( const_iterator first_, const_iterator last_ )
+        {
+            // Erasing shifts the elements, so 'last_' may move: count the elements first.
+            size_type n = std::distance( first_, last_ );
+            iterator it{ first_.m_node, first_.m_index };
+            for ( ; n > 0; --n) it = this->erase( it );
+            return it;
+        }
+
+        //!=== [V] UTILITY METHODS
+
+        /*! Merges 'other' into *this. Both lists should be sorted in ascending order.
+         *  The container other becomes empty after the operation.
+         */
+        void merge( unrolled_list & other ) { this->merge( other, std::less<T>() ); }
+
+        /*! Merges 'other' into *this, using 'comp' to compare the elements.
+         *  Both lists should be sorted with respect to 'comp'. The merge is stable: for
+         *  equivalent elements, those from *this precede those from other.
+         *  The elements are moved, one at a time, from the front of either list into a new,
+         *  fully packed sequence of nodes, and each drained node is released at once; when
+         *  one list runs out, the nodes left in the other are relinked after them.
+         *  If 'comp' throws, no element is lost: *this keeps every element of both lists
+         *  (those already merged first, in order), in unspecified order, and other is empty.
+         *  @param other Another container to transfer the content from.
+         *  @param comp Binary predicate that returns true if the first argument is less than the second.
+         */
+        template < typename Compare >
+        void merge( unrolled_list & other, Compare comp )
+        {
+            if (other.empty() or this == &other) return;
+            unrolled_list result( get_allocator() );
+            std::size_t head_a{0}, head_b{0};   // Elementos já retirados do primeiro nó de cada lista.
+            try {
+                while (not empty() and not other.empty()) {
+                    if (comp( as_node( other.sentinel()->next )->data()[ head_b ], as_node( sentinel()->next )->data()[ head_a ] ))
+                        result.take_front( other, head_b );
+                    else result.take_front( *this, head_a );
+                }
+            }
+            catch (...) {
+                this->close_front( head_a );
+                other.close_front( head_b );
+                result.splice( result.cend(), *this );
+                result.splice( result.cend(), other );
+                this->swap_nodes( result );
+                throw;
+            }
+            this->close_front( head_a );
+            other.close_front( head_b );
+            result.splice( result.cend(), *this );
+            result.splice( result.cend(), other );
+            this->swap_nodes( result );
+        }
+
+        /*! Transfers all elements from 'other' into *this, before 'pos'.
+         *  The nodes of 'other' are relinked, not copied; if 'pos' is in the middle of a node,
+         *  that node is split first. The container other becomes empty after the operation.
+         *  The allocators must compare equal, and other must not be *this.
+         */
+        void splice( const_iterator pos, unrolled_list & other )
+        {
+            if (other.empty()) return;
+            assert( this != &other and m_alloc == other.m_alloc );
+            NodeBase * next = pos.m_node;
+            if (pos.m_index > 0) {
+                Node * fresh = create_node_before( pos.m_node->next );
+                move_tail( as_node(pos.m_node), pos.m_index, fresh );
+                next = fresh;
+            }
+            NodeBase * first = other.m_sentinel.next;
+            NodeBase * last = other.m_sentinel.prev;
+            first->prev = next->prev;
+            next->prev->next = first;
+            last->next = next;
+            next->prev = last;
+            m_len += other.m_len;
+            other.reset_sentinel();
+        }
+
+        /// Reverses the order of the elements: the node order and the elements inside each node.
+        void reverse( void )
+        {
+            NodeBase * node = sentinel();
+            do {
+                std::swap( node->next, node->prev );
+                if (node != sentinel())
+                    std::reverse( as_node(node)->data(), as_node(node)->data() + as_node(node)->count );
+                node = node->prev;                      // The old next.
+            } while (node != sentinel());
+        }
+
+        /// Removes all consecutive duplicate elements; the survivors are packed towards the front.
+        void unique( void ) { this->unique( std::equal_to<T>() ); }
+
+        /// Removes all consecutive elements for which 'pred' (applied to the kept one and the next) returns true.
+        template < typename BinaryPredicate >
+        void unique( BinaryPredicate pred )
+        {
+            if (m_len <= 1) return;
+            iterator write = begin();
+            iterator read = std::next( write );
+            for ( ; read != end(); ++read)
+                if (not pred( *write, *read ) and ++write != read) *write = std::move( *read );
+            ++write;
+            truncate( write.m_node, write.m_index );
+        }
+
+        /// Sorts the elements in ascending order. The sort is stable.
+        void sort( void ) { this->sort( std::less<T>() ); }
+
+        /*! Sorts the elements using 'comp' to compare them.
+         *  The elements are moved into a contiguous buffer, stable-sorted there and moved back
+         *  into the same slots, so no node is allocated or relinked and iterators remain valid
+         *  (though they now refer to other values).
+         *  If 'comp' throws, the list remains valid, but its contents are unspecified.
+         */
+        template < typename Compare >
+        void sort( Compare comp )
+        {
+            if (m_len <= 1) return;
+            std::vector< T > buffer( std::make_move_iterator( begin() ), std::make_move_iterator( end() ) );
+            try { std::stable_sort( buffer.begin(), buffer.end(), comp ); }
+            catch (...) { std::move( buffer.begin(), buffer.end(), begin() ); throw; }
+            std::move( buffer.begin(), buffer.end(), begin() );
+        }
+    };
+
+    //!=== [VI] OPERATORS
+    ///* Checks if the contents of 'l1_' and 'l2_' are equal, in a single lockstep pass.
+    template < typename T, std::size_t B, typename Alloc >
+    inline bool operator==( const sc::unrolled_list<T, B, Alloc> & l1_, const sc::unrolled_list<T, B, Alloc> & l2_ )
+    {
+        if (l1_.size() != l2_.size())
+            return false;
+        auto it1 = l1_.cbegin();
+        auto it2 = l2_.cbegin();
+        for ( ; it1 != l1_.cend(); ++it1, ++it2)
+            if (not (*it1 == *it2))
+                return false;
+        return true;
+    }
+
+    ///* Similar to the previous operator, but the opposite result.
+    template < typename T, std::size_t B, typename Alloc >
+    inline bool operator!=( const sc::unrolled_list<T, B, Alloc> & l1_, const sc::unrolled_list<T, B, Alloc> & l2_ )
+    {
+        return not (l1_ == l2_);
+    }
+
+    ///* Exchanges the contents of 'l1_' and 'l2_' in O(1).
+    template < typename T, std::size_t B, typename Alloc >
+    inline void swap( sc::unrolled_list<T, B, Alloc> & l1_, sc::unrolled_list<T, B, Alloc> & l2_ )
+    {
+        l1_.swap( l2_ );
+    }
+}
+#endif
@@ -1,10 +1,28 @@
 #include<iostream>
 #include<list>
 #include <iterator>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <set>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <thread>
 
 
 #include "tm/test_manager.h"
 #include "../include/list.h"
+#include "../include/pool_allocator.h"
+#include "../include/unrolled_list.h"
+#include "../include/intrusive_list.h"
+#include "../include/indexed_list.h"
+#include "../include/concurrent_list.h"
+#include "../include/lockfree_list_queue.h"
+#include "../include/linked_hash_map.h"
+#include "../include/sharded_lru.h"
+#include "../include/sorted_list.h"
 
 #define which_lib sc 
 // #define which_lib std
@@ -23,6 +41,64 @@ std::ostream & operator<<( std::ostream &os, const which_lib::list<T> & L )
     return os;
 }
 
+/// Number of live allocations made through any counting_allocator (rebound or not).
+int live_allocations{ 0 };
+
+/// Array allocations (n > 1) through a counting_allocator that succeed before one throws std::bad_alloc (-1: no limit).
+int array_allocations_left{ -1 };
+
+/// An allocator that counts how many allocations are alive, to check that no memory is requested behind our backs.
+template < typename T >
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+    template < typename U > counting_allocator( const counting_allocator<U> & ) { }
+
+    T * allocate( size_t n )
+    {
+        if ( n > 1 and array_allocations_left >= 0 and array_allocations_left-- == 0 ) throw std::bad_alloc();
+        ++live_allocations;
+        return std::allocator<T>().allocate( n );
+    }
+    void deallocate( T * p, size_t n ) { --live_allocations; std::allocator<T>().deallocate( p, n ); }
+
+    template < typename U > bool operator==( const counting_allocator<U> & ) const { return true; }
+    template < typename U > bool operator!=( const counting_allocator<U> & ) const { return false; }
+};
+
+/// Copies of this type throw once 'copies_left' reaches zero (copy assignment never throws).
+int copies_left{ -1 };
+
+struct throwing_copy
+{
+    int value;
+
+    throwing_copy( int v = 0 ) : value{ v } { }
+    throwing_copy( const throwing_copy & other ) : value{ other.value }
+    {
+        if ( copies_left == 0 ) throw std::runtime_error( "copy failed" );
+        if ( copies_left > 0 ) --copies_left;
+    }
+    throwing_copy & operator=( const throwing_copy & ) = default;
+
+    bool operator==( const throwing_copy & rhs ) const { return value == rhs.value; }
+};
+
+/// This comparison throws once 'compares_left' reaches zero (-1: never).
+int compares_left{ -1 };
+
+struct throwing_less
+{
+    bool operator()( int a, int b ) const
+    {
+        if ( compares_left == 0 ) throw std::runtime_error( "compare failed" );
+        if ( compares_left > 0 ) --compares_left;
+        return a < b;
+    }
+};
+
 int main( void )
 {
     //=== TESTING BASIC OPERATIONS METHODS
@@ -36,6 +112,92 @@ int main( void )
         EXPECT_TRUE( list.empty() );
     }
 
+    {
+        BEGIN_TEST(tm,"EmptyNoAllocation", "an empty list does not allocate memory");
+        static_assert( std::is_nothrow_default_constructible< which_lib::list<int> >::value,
+                "default constructor must be noexcept" );
+        static_assert( std::is_nothrow_move_constructible< which_lib::list<int> >::value,
+                "move constructor must be noexcept" );
+
+        auto & live = live_allocations;
+        {
+            using counted_list = which_lib::list< int, counting_allocator<int> >;
+            counted_list list;
+            counted_list list2( std::move( list ) );
+            EXPECT_EQ( live, 0 );
+
+            list2.push_back( 1 );
+            list2.push_back( 2 );
+            EXPECT_EQ( live, 2 );        // One allocation per node, none for the sentinel.
+            list = std::move( list2 );   // Nodes are taken over, not reallocated.
+            EXPECT_EQ( live, 2 );
+            EXPECT_EQ( list.size(), 2 );
+            EXPECT_EQ( list.back(), 2 );
+            EXPECT_EQ( *std::prev( list.end() ), 2 );
+            list.pop_front();
+            EXPECT_EQ( live, 1 );
+        }
+        EXPECT_EQ( live, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm,"BulkConstruction", "bulk constructors build each element in place, in a few large chunks");
+        auto & live = live_allocations;
+        {
+            using counted_list = which_lib::list< int, counting_allocator<int> >;
+            std::vector<int> values( 1000 );
+            for ( size_t i{0} ; i < values.size() ; ++i ) values[i] = static_cast<int>( i );
+
+            counted_list list( values.begin(), values.end() );
+            EXPECT_EQ( live, 1 );
+            counted_list list2{ list };
+            EXPECT_EQ( live, 2 );
+            counted_list list3( 100 );
+            EXPECT_EQ( live, 3 );
+            EXPECT_TRUE( std::equal( list2.begin(), list2.end(), values.begin() ) );
+            EXPECT_EQ( list3.back(), 0 );
+
+            // Each node is still erased on its own; a chunk goes with its last node.
+            list2.erase( std::next( list2.begin(), 10 ) );
+            list2.pop_front();
+            EXPECT_EQ( list2.size(), 998 );
+            EXPECT_EQ( list2.front(), 1 );
+            EXPECT_EQ( *std::next( list2.begin(), 9 ), 11 );
+            EXPECT_EQ( live, 3 );
+            list2.push_back( 1000 );
+            EXPECT_EQ( live, 4 );
+            while ( list2.size() > 1 ) list2.pop_front();
+            EXPECT_EQ( live, 3 );
+            EXPECT_EQ( list2.front(), 1000 );
+
+            // Nodes move to another list with no allocation.
+            list2.splice( list2.cend(), list3 );
+            counted_list list4{ std::move( list ) };
+            list4.merge( list2 );
+            EXPECT_EQ( live, 3 );
+            EXPECT_EQ( list4.size(), 1101 );
+            list4.clear();
+            EXPECT_EQ( live, 0 );
+
+            // A long list takes a few chunks of 64 KiB, not one request per node.
+            counted_list big( 100000 );
+            EXPECT_LT( live, 50 );
+            EXPECT_GT( live, 1 );
+        }
+        EXPECT_EQ( live, 0 );
+        {
+            // A constructor that throws midway gives back every chunk.
+            std::vector< throwing_copy > values( 5000 );
+            copies_left = 3000;
+            bool thrown{ false };
+            try { sc::list< throwing_copy, counting_allocator<throwing_copy> > list( values.begin(), values.end() ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            copies_left = -1;
+            EXPECT_TRUE( thrown );
+        }
+        EXPECT_EQ( live, 0 );
+    }
+
     {
         BEGIN_TEST(tm, "ConstructorSize", "Constructor size");
 
@@ -83,6 +245,33 @@ int main( void )
             EXPECT_EQ( *it, *it2 );
     }
 
+    {
+        BEGIN_TEST(tm,"InputIteratorRange", "building and assigning from single-pass ranges");
+        std::istringstream input{ "1 2 3 4 5" };
+        which_lib::list<int> list( std::istream_iterator<int>{ input }, std::istream_iterator<int>{} );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 1, 2, 3, 4, 5 } ) );
+
+        // From the iterators of another list: one pass, no indexing.
+        which_lib::list<int> list2( std::next( list.begin() ), list.end() );
+        EXPECT_EQ( list2, ( which_lib::list<int>{ 2, 3, 4, 5 } ) );
+
+        // assign() to a longer, a shorter and an empty list.
+        std::istringstream input2{ "7 8 9" };
+        list.assign( std::istream_iterator<int>{ input2 }, std::istream_iterator<int>{} );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 7, 8, 9 } ) );
+        EXPECT_EQ( list.back(), 9 );
+        std::istringstream input3{ "10 20 30 40 50 60" };
+        list.assign( std::istream_iterator<int>{ input3 }, std::istream_iterator<int>{} );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 10, 20, 30, 40, 50, 60 } ) );
+        EXPECT_EQ( *std::prev( list.end() ), 60 );
+        list2.assign( list.begin(), list.end() );
+        EXPECT_EQ( list2, list );
+        list2.assign( list.begin(), list.begin() );
+        EXPECT_TRUE( list2.empty() );
+        list2.assign( { 1, 2 } );
+        EXPECT_EQ( list2, ( which_lib::list<int>{ 1, 2 } ) );
+    }
+
     {
         BEGIN_TEST(tm, "CopyConstructor","constructor copy values of another list.");
         // Range = the entire list.
@@ -106,22 +295,27 @@ int main( void )
         for( auto e : list2 )
             EXPECT_EQ( e, i++ );
     }
-#ifdef MOVE_SYNTAX_IMPLEMENTED
-
-    // {
-    //     BEGIN_TEST(tm, "Molistonstructor", "move the elements from another");
-    //     // Range = the entire list.
-    //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    //     which_lib::list<int> list2( std::move( list ) );
+    {
+        BEGIN_TEST(tm, "MoveConstructor", "move the elements from another");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        auto first{ list.begin() };
+        which_lib::list<int> list2( std::move( list ) );
 
-    //     EXPECT_EQ( list2.size(), 5 );
-    //     // EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_TRUE( list.empty() );
+        // The nodes were taken over, not copied.
+        EXPECT_EQ( first, list2.begin() );
 
-    //     // CHeck whether the copy worked.
-    //     for( auto i{0u} ; i < list2.size() ; ++i )
-    //         EXPECT_EQ( i+1, list2[i] );
-    // }
-#endif
+        // CHeck whether the copy worked.
+        auto i{1};
+        for( auto e : list2 )
+            EXPECT_EQ( e, i++ );
+        // The moved-from list is still usable.
+        list.push_back( 6 );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 6 } ) );
+    }
 
 
     {
@@ -140,25 +334,115 @@ int main( void )
             EXPECT_EQ ( e,i++ );;
     }
 
-#ifdef MOVE_SYNTAX_IMPLEMENTED  
-    // // {
-    // //     BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
-    // //     // Range = the entire list.
-    // //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    // //     which_lib::list<int> list2;
-
-    // //     list2 = std::move( list );
-    // //     EXPECT_EQ( list2.size(), 5 );
-    // //     EXPECT_FALSE( list2.empty() );
-    // //     EXPECT_EQ( list.size(), 0 );
-    // //     EXPECT_EQ( list.capacity(), 0 );
-    // //     EXPECT_TRUE( list.empty() );
-
-    // //     // CHeck whether the copy worked.
-    // //     for( auto i{0u} ; i < list2.size() ; ++i )
-    // //         EXPECT_EQ( i+1, list2[i] );
-    // // }
-#endif
+    {
+        BEGIN_TEST(tm, "AssignReusesNodes", "assignment overwrites the nodes already in the list");
+        auto & live = live_allocations;
+        {
+            using counted_list = which_lib::list< int, counting_allocator<int> >;
+            counted_list list{ 1, 2, 3, 4, 5, 6, 7, 8 };
+            counted_list list2{ 10, 20, 30, 40, 50 };
+            EXPECT_EQ( live, 2 );                // One chunk each.
+
+            auto first = list2.begin();
+            list2 = list;                       // Only the 3 missing nodes are allocated (in one chunk).
+            EXPECT_EQ( live, 3 );
+            EXPECT_TRUE( ( first == list2.begin() ) );
+            EXPECT_EQ( list2, list );
+
+            list2.assign( { 7, 8, 9 } );        // The surplus is released.
+            EXPECT_EQ( live, 2 );               // The chunk of the surplus went with it.
+            EXPECT_EQ( list2, ( counted_list{ 7, 8, 9 } ) );
+
+            list2 = { 1, 2, 3, 4 };
+            EXPECT_EQ( live, 3 );
+            EXPECT_TRUE( ( first == list2.begin() ) );
+            EXPECT_EQ( list2.back(), 4 );
+
+            // A growing assign() builds the new nodes in one chunk; each is still released on its own.
+            std::vector<int> values( 100, 1 );
+            list2.assign( values.begin(), values.end() );
+            EXPECT_EQ( live, 4 );
+            list2.pop_back();
+            EXPECT_EQ( live, 4 );
+            list2.erase( std::next( list2.begin(), 3 ), list2.end() );
+            EXPECT_EQ( live, 2 );
+        }
+        EXPECT_EQ( live, 0 );
+
+        // If building the new nodes fails, the list is left as it was.
+        which_lib::list< throwing_copy > list3{ 1, 2 };
+        which_lib::list< throwing_copy > list4{ 5, 6, 7, 8 };
+        copies_left = 1;
+        bool thrown{ false };
+        try { list3 = list4; }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        copies_left = -1;
+        EXPECT_EQ( list3, ( which_lib::list< throwing_copy >{ 1, 2 } ) );
+    }
+
+    {
+        BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        which_lib::list<int> list2{ 10, 20 };
+
+        list2 = std::move( list );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list.size(), 0 );
+        EXPECT_TRUE( list.empty() );
+
+        // CHeck whether the copy worked.
+        auto i{1};
+        for( auto e : list2 )
+            EXPECT_EQ( e, i++ );
+    }
+
+    {
+        BEGIN_TEST(tm, "Swap", "swapping the contents of two lists");
+        which_lib::list<int> list{ 1, 2, 3 };
+        which_lib::list<int> list2{ 4, 5 };
+
+        swap( list, list2 );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 4, 5 } ) );
+        EXPECT_EQ( list2, ( which_lib::list<int>{ 1, 2, 3 } ) );
+        EXPECT_EQ( list.size(), 2 );
+        EXPECT_EQ( list2.size(), 3 );
+    }
+
+    {
+        BEGIN_TEST(tm, "Emplace", "constructing elements in place");
+        // A type that can be neither default-constructed nor copied.
+        struct Item {
+            std::string name; int qty;
+            Item( std::string n, int q ) : name{ std::move( n ) }, qty{ q } { }
+            Item( const Item & ) = delete;
+            Item( Item && ) = default;
+        };
+        which_lib::list<Item> list;
+
+        list.emplace_back( "b", 2 );
+        list.emplace_front( "a", 1 );
+        list.emplace( std::next( list.begin() ), "ab", 12 );
+        list.push_back( Item{ "c", 3 } );
+        auto & last = list.emplace_back( "d", 4 );
+
+        EXPECT_EQ( list.size(), 5 );
+        EXPECT_EQ( last.qty, 4 );
+        int expected[]{ 1, 12, 2, 3, 4 };
+        auto it = list.begin();
+        for ( const auto & e : expected )
+            EXPECT_EQ( (*it++).qty, e );
+        EXPECT_EQ( list.front().name, "a" );
+
+        // Moving a string into the list leaves the source empty.
+        which_lib::list<std::string> list2;
+        std::string s{ "a string long enough to live on the heap" };
+        list2.push_back( std::move( s ) );
+        EXPECT_TRUE( s.empty() );
+        EXPECT_EQ( list2.back().size(), 40 );
+    }
 
 
     {
@@ -401,6 +685,26 @@ int main( void )
         EXPECT_NE( list,list4 );
     }
 
+    {
+        BEGIN_TEST(tm, "OperatorRelational","lexicographical <, <=, > and >=");
+        which_lib::list<int> list { 1, 2, 3, 4, 5 };
+        which_lib::list<int> list2 { 1, 2, 3, 4, 5 };
+        which_lib::list<int> list3 { 1, 2, 8, 4, 5 };
+        which_lib::list<int> list4 { 1, 2, 3 };
+        which_lib::list<int> empty;
+
+        EXPECT_FALSE( ( list < list2 ) );
+        EXPECT_TRUE( ( list <= list2 ) );
+        EXPECT_TRUE( ( list >= list2 ) );
+        EXPECT_TRUE( ( list < list3 ) );
+        EXPECT_TRUE( ( list3 > list ) );
+        EXPECT_TRUE( ( list4 < list ) ); // A prefix comes first.
+        EXPECT_FALSE( ( list < list4 ) );
+        EXPECT_TRUE( ( empty < list4 ) );
+        EXPECT_TRUE( ( empty <= empty ) );
+        EXPECT_FALSE( ( empty < empty ) );
+    }
+
 
     {
         BEGIN_TEST(tm, "InsertSingleValueAtPosition","InsertSingleValueAtPosition");
@@ -571,6 +875,72 @@ past_last = list.erase( std::next(list.begin(),2) );
         EXPECT_EQ( list.size() , 4 );
     }
 
+    {
+        BEGIN_TEST(tm, "InsertRangeBulk","insert_range and push_back_range link a segment built aside.");
+        which_lib::list<int> list { 1, 5 };
+        std::vector<int> middle { 2, 3, 4 };
+        auto first = list.insert_range( std::next( list.cbegin() ), middle.begin(), middle.end() );
+        EXPECT_EQ( *first, 2 );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 1, 2, 3, 4, 5 } ) );
+        EXPECT_EQ( list.size() , 5 );
+        // An empty range returns 'pos'.
+        EXPECT_EQ( list.insert_range( list.cend(), middle.end(), middle.end() ), list.end() );
+
+        // A single-pass range.
+        std::istringstream input( "6 7 8" );
+        list.push_back_range( std::istream_iterator<int>( input ), std::istream_iterator<int>() );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 1, 2, 3, 4, 5, 6, 7, 8 } ) );
+        EXPECT_EQ( list.size() , 8 );
+
+        // If a copy throws, nothing is inserted.
+        sc::list< throwing_copy > guarded( 3 );
+        std::vector< throwing_copy > source( 5 );
+        copies_left = 2;
+        bool thrown{ false };
+        try { guarded.push_back_range( source.begin(), source.end() ); }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        copies_left = -1;
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( guarded.size(), 3 );
+
+        // Each inserted element has a node of its own, released as soon as it is erased.
+        {
+            sc::list< int, counting_allocator<int> > counted;
+            std::vector<int> values( 40, 7 );
+            counted.push_back_range( values.begin(), values.end() );
+            counted.push_back_range( values.begin(), values.end() );
+            EXPECT_EQ( live_allocations, 80 );
+            counted.pop_back();
+            counted.erase( std::next( counted.cbegin(), 10 ) );
+            EXPECT_EQ( live_allocations, 78 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm, "RemoveIf","remove, remove_if and sc::erase_if return the number of elements removed.");
+        which_lib::list<int> list { 1, 2, 2, 3, 4, 4, 4, 5, 6 };
+        EXPECT_EQ( list.remove( 4 ), 3 );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 1, 2, 2, 3, 5, 6 } ) );
+        EXPECT_EQ( list.remove_if( []( int e ){ return e % 2 == 0; } ), 3 );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 1, 3, 5 } ) );
+        EXPECT_EQ( list.size() , 3 );
+        EXPECT_EQ( list.remove( 7 ), 0 );
+
+        // The value may be an element of the list itself.
+        list = { 3, 1, 3, 3, 2, 3 };
+        EXPECT_EQ( list.remove( list.front() ), 4 );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 1, 2 } ) );
+
+        list = { 1, 2, 3, 4, 5, 6, 7 };
+        EXPECT_EQ( sc::erase_if( list, []( int e ){ return e > 2; } ), 5 );
+        EXPECT_EQ( sc::erase( list, 1 ), 1 );
+        EXPECT_EQ( list , ( which_lib::list<int>{ 2 } ) );
+        EXPECT_EQ( sc::erase_if( list, []( int ){ return true; } ), 1 );
+        EXPECT_TRUE( list.empty() );
+        EXPECT_EQ( list.begin(), list.end() );
+    }
+
     {
         BEGIN_TEST(tm, "Reverse","Checking the reverse methos");
         // Regular case odd list length 
@@ -591,6 +961,112 @@ past_last = list.erase( std::next(list.begin(),2) );
         EXPECT_TRUE( list4.empty() );
     }
 
+    {
+        BEGIN_TEST(tm, "Find", "find, find_if, contains and count");
+        // Even and odd sizes: the arithmetic fast path walks from both ends.
+        for ( auto n{0} ; n < 11 ; ++n )
+        {
+            which_lib::list<int> list;
+            for ( auto i{0} ; i < n ; ++i )
+                list.push_back( i );
+            for ( auto i{0} ; i < n ; ++i )
+            {
+                auto it = list.find( i );
+                EXPECT_NE( it, list.end() );
+                EXPECT_EQ( *it, i );
+                EXPECT_EQ( it, std::next( list.begin(), i ) );
+                EXPECT_TRUE( list.contains( i ) );
+                EXPECT_EQ( list.count( i ), 1 );
+            }
+            EXPECT_EQ( list.find( n ), list.end() );
+            EXPECT_FALSE( list.contains( -1 ) );
+            EXPECT_EQ( list.count( -1 ), 0 );
+        }
+
+        // Duplicates: find returns the first one.
+        const which_lib::list<int> list{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+        EXPECT_EQ( list.find( 5 ), std::next( list.cbegin(), 4 ) );
+        EXPECT_EQ( list.count( 5 ), 3 );
+        EXPECT_EQ( list.find_if( []( int e ){ return e > 5; } ), std::next( list.cbegin(), 5 ) );
+
+        // Non-arithmetic types use the generic search.
+        which_lib::list<std::string> list2{ "a", "b", "c", "b" };
+        EXPECT_EQ( list2.find( "b" ), std::next( list2.begin() ) );
+        EXPECT_EQ( list2.find( "z" ), list2.end() );
+        EXPECT_EQ( list2.count( "b" ), 2 );
+        EXPECT_TRUE( list2.contains( "c" ) );
+        *list2.find_if( []( const std::string & e ){ return e == "c"; } ) = "C";
+        EXPECT_EQ( list2, ( which_lib::list<std::string>{ "a", "b", "C", "b" } ) );
+    }
+
+    {
+        BEGIN_TEST(tm, "SlabPool","recycling blocks through the free list.");
+        sc::slab_pool pool{ 4 };
+
+        void * a = pool.allocate( 24 );
+        void * b = pool.allocate( 24 );
+        EXPECT_NE( a, b );
+        pool.deallocate( a, 24 );
+        // The last released block must be handed out first.
+        EXPECT_EQ( pool.allocate( 24 ), a );
+        // Blocks of a different size class come from a different chunk.
+        void * c = pool.allocate( 100 );
+        EXPECT_NE( c, b );
+        pool.deallocate( c, 100 );
+        pool.deallocate( b, 24 );
+        pool.deallocate( a, 24 );
+
+        // Over-aligned blocks bypass the pool, but keep their alignment.
+        struct alignas(128) wide { char c; };
+        sc::pool_allocator<wide> alloc;
+        wide * one = alloc.allocate( 1 );
+        wide * many = alloc.allocate( 3 );
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( one ) % 128, 0u );
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( many ) % 128, 0u );
+        alloc.deallocate( many, 3 );
+        alloc.deallocate( one, 1 );
+        void * big = pool.allocate( 1000, 64 );
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( big ) % 64, 0u );
+        pool.deallocate( big, 1000, 64 );
+    }
+
+    {
+        BEGIN_TEST(tm, "PoolAllocator","list drawing its nodes from a pool allocator.");
+        using pool_list = which_lib::list< int, sc::pool_allocator<int> >;
+        sc::pool_allocator<int> alloc;
+        pool_list list( { 1, 2, 3, 4, 5 }, alloc );
+        pool_list list2( alloc );
+
+        EXPECT_EQ( list.size(), 5 );
+        EXPECT_TRUE( ( list.get_allocator() == alloc ) );
+
+        // Churn: erase and insert reuse the released nodes.
+        for ( auto i{0} ; i < 100 ; ++i )
+        {
+            list.pop_front();
+            list.push_back( i );
+        }
+        auto i{95};
+        for ( const auto & e : list )
+            EXPECT_EQ( e, i++ );
+
+        // Lists sharing the same pool may exchange nodes.
+        list2.push_back( -1 );
+        list.splice( list.cbegin(), list2 );
+        EXPECT_EQ( list, ( pool_list( { -1, 95, 96, 97, 98, 99 }, alloc ) ) );
+        EXPECT_TRUE( list2.empty() );
+
+        pool_list list3( list );
+        EXPECT_EQ( list3, list );
+
+        // An empty node handle has no allocator, so it does not create a pool of its own.
+        static_assert( std::is_nothrow_default_constructible< pool_list::node_type >::value, "an empty handle allocates nothing" );
+        pool_list::node_type handle;
+        EXPECT_TRUE( handle.empty() );
+        handle = list3.extract( list3.cbegin() );
+        EXPECT_TRUE( ( handle.get_allocator() == alloc ) );
+    }
+
     tm.summary();
 
 
@@ -746,6 +1222,54 @@ past_last = list.erase( std::next(list.begin(),2) );
             EXPECT_EQ( *it++ , i++ );
     }
 
+    {
+        BEGIN_TEST(tm2, "Arithmetic","it + n, it - n (negative steps too) and it1 - it2");
+
+        which_lib::list<int> list { 1, 2, 3, 4, 5, 6 };
+
+        auto it = list.begin() + 4;
+        EXPECT_EQ( *it, 5 );
+        EXPECT_EQ( *( it + (-3) ), 2 );
+        EXPECT_EQ( *( it - 2 ), 3 );
+        it -= -1;
+        EXPECT_EQ( *it, 6 );
+        EXPECT_EQ( it - list.begin(), 5 );
+        EXPECT_EQ( list.end() - list.begin(), 6 );
+        EXPECT_EQ( std::distance( list.cbegin(), list.cend() ), 6 );
+        EXPECT_EQ( list.begin() - list.begin(), 0 );
+    }
+
+    {
+        BEGIN_TEST(tm2, "Conformance","iterator_traits, operator->, const conversion and std algorithms");
+        using list_t = which_lib::list< std::pair<int, int> >;
+        using traits = std::iterator_traits< list_t::const_iterator >;
+        static_assert( std::is_same< traits::iterator_category, std::bidirectional_iterator_tag >::value, "category" );
+        static_assert( std::is_same< traits::reference, const std::pair<int, int> & >::value, "const reference" );
+        static_assert( std::is_same< std::iterator_traits< list_t::iterator >::pointer, std::pair<int, int> * >::value, "pointer" );
+        static_assert( std::is_trivially_copyable< list_t::iterator >::value, "trivially copyable" );
+        static_assert( std::is_trivially_copyable< list_t::const_iterator >::value, "trivially copyable" );
+
+        list_t list{ { 1, 10 }, { 2, 20 }, { 3, 30 } };
+        const list_t & clist = list;
+
+        auto it = list.begin();
+        EXPECT_EQ( it->second, 10 );
+        it->second = 11;
+        EXPECT_EQ( ( ++++it )->first, 3 );          // Pre-increment yields the iterator itself.
+        list_t::const_iterator cit = it;             // iterator -> const_iterator.
+        EXPECT_TRUE( ( cit == it ) );
+        EXPECT_TRUE( ( it != clist.cbegin() ) );
+
+        auto found = std::find_if( clist.begin(), clist.end(), []( const std::pair<int, int> & p ){ return p.second == 20; } );
+        EXPECT_EQ( found->first, 2 );
+        int sum = std::accumulate( clist.begin(), clist.end(), 0, []( int acc, const std::pair<int, int> & p ){ return acc + p.second; } );
+        EXPECT_EQ( sum, 61 );
+        list.erase( clist.cbegin() );               // Positions may be const_iterators.
+        list.insert( list.cend(), { 4, 40 } );
+        EXPECT_EQ( list.size(), 3 );
+        EXPECT_EQ( list.back().second, 40 );
+    }
+
     std::cout << std::endl;
     tm2.summary();
 
@@ -887,6 +1411,168 @@ past_last = list.erase( std::next(list.begin(),2) );
             ++i;
         }
     }
+    {
+        BEGIN_TEST(tm3, "Splice 6", "splicing a single element and a range, from another list or the same one.");
+        which_lib::list<int> list_a{ 1, 2, 3, 4 };
+        which_lib::list<int> list_b{ 10, 20, 30, 40 };
+        auto moved = std::next( list_b.cbegin() );
+        list_a.splice( list_a.cend(), list_b, moved );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 2, 3, 4, 20 } ) );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 10, 30, 40 } ) );
+        EXPECT_EQ( *moved, 20 );                            // The node itself was moved.
+        EXPECT_EQ( list_a.size(), 5 );
+        EXPECT_EQ( list_b.size(), 3 );
+
+        list_a.splice( std::next( list_a.cbegin() ), list_b, list_b.cbegin(), std::prev( list_b.cend() ) );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 10, 30, 2, 3, 4, 20 } ) );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 40 } ) );
+        EXPECT_EQ( list_a.size(), 7 );
+        EXPECT_EQ( list_b.size(), 1 );
+
+        // Within the same list.
+        list_a.splice( list_a.cbegin(), list_a, std::prev( list_a.cend() ) );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 20, 1, 10, 30, 2, 3, 4 } ) );
+        list_a.splice( list_a.cend(), list_a, list_a.cbegin(), std::next( list_a.cbegin(), 3 ) );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 30, 2, 3, 4, 20, 1, 10 } ) );
+        list_a.splice( list_a.cbegin(), list_a, list_a.cbegin() );
+        EXPECT_EQ( list_a.size(), 7 );
+
+        // Nothing is allocated.
+        {
+            sc::list< int, counting_allocator<int> > a{ 1, 2, 3 }, b{ 4, 5, 6 };
+            int before{ live_allocations };
+            a.splice( a.cbegin(), b, std::next( b.cbegin() ), b.cend() );
+            a.splice( a.cend(), b, b.cbegin() );
+            EXPECT_EQ( live_allocations, before );
+            EXPECT_EQ( a, ( sc::list< int, counting_allocator<int> >{ 5, 6, 1, 2, 3, 4 } ) );
+            EXPECT_TRUE( b.empty() );
+        }
+    }
+
+    {
+        BEGIN_TEST(tm3, "Extract", "extract and insert move an element between lists through a node handle.");
+        {
+            sc::list< std::string, counting_allocator<std::string> > high{ "a", "b", "c" }, low{ "x" };
+            int before{ live_allocations };
+            auto handle = high.extract( std::next( high.cbegin() ) );
+            EXPECT_FALSE( handle.empty() );
+            EXPECT_EQ( handle.value(), std::string{ "b" } );
+            EXPECT_EQ( high.size(), 2 );
+            handle.value() = "B";
+            auto it = low.insert( low.cbegin(), std::move( handle ) );
+            EXPECT_TRUE( handle.empty() );
+            EXPECT_EQ( *it, std::string{ "B" } );
+            EXPECT_EQ( low, ( sc::list< std::string, counting_allocator<std::string> >{ "B", "x" } ) );
+            EXPECT_EQ( live_allocations, before );          // No node was allocated or released.
+            // An empty handle inserts nothing; a handle that is never inserted releases its node.
+            EXPECT_EQ( low.insert( low.cend(), std::move( handle ) ), low.end() );
+            { auto dropped = low.extract( std::next( low.cbegin() ) ); }   // "x", alocado sozinho.
+            EXPECT_EQ( live_allocations, before - 1 );
+            EXPECT_EQ( low.size(), 1 );
+            // Swapping a full handle with an empty one moves the node and its allocator across.
+            decltype( handle ) full = high.extract( high.cbegin() );
+            handle.swap( full );
+            EXPECT_TRUE( full.empty() );
+            EXPECT_EQ( handle.value(), std::string{ "a" } );
+            handle = std::move( full );                     // Releases "a".
+            EXPECT_TRUE( handle.empty() );
+            EXPECT_EQ( high.size(), 1 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+
+        // Elements of a bulk-built list leave it with their own nodes, and both lists may then
+        // be destroyed in any order.
+        {
+            std::vector<int> values( 100 );
+            std::iota( values.begin(), values.end(), 0 );
+            sc::list< int, counting_allocator<int> > * bulk = new sc::list< int, counting_allocator<int> >( values.begin(), values.end() );
+            sc::list< int, counting_allocator<int> > other;
+            int before{ live_allocations };
+            other.insert( other.cend(), bulk->extract( std::next( bulk->cbegin(), 10 ) ) );
+            other.splice( other.cend(), *bulk, bulk->cbegin() );
+            other.splice( other.cend(), *bulk, std::next( bulk->cbegin(), 50 ), bulk->cend() );
+            EXPECT_EQ( bulk->size(), 50 );
+            EXPECT_EQ( other.size(), 50 );
+            EXPECT_EQ( other.front(), 10 );
+            EXPECT_EQ( *std::next( other.cbegin() ), 0 );
+            EXPECT_EQ( other.back(), 99 );
+            EXPECT_EQ( live_allocations, before );          // Nada foi alocado nem liberado.
+            delete bulk;
+            EXPECT_EQ( std::accumulate( other.cbegin(), other.cend(), 0 ), 10 + 0 + ( 52 + 99 ) * 48 / 2 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+
+        // Only links change: elements that can be neither copied nor moved travel too, and nothing throws.
+        {
+            struct pinned {
+                int value;
+                explicit pinned( int value_ ) : value{ value_ } { }
+                pinned( const pinned & ) = delete;
+                pinned & operator=( const pinned & ) = delete;
+            };
+            sc::list< pinned > from, to;
+            for ( int i{0} ; i < 4 ; ++i ) from.emplace_back( i );
+            sc::list< pinned >::const_iterator pos;
+            static_assert( noexcept( from.extract( pos ) ), "extract must not throw" );
+            static_assert( noexcept( to.splice( pos, from, pos ) ), "splice must not throw" );
+            to.insert( to.cend(), from.extract( std::next( from.cbegin() ) ) );
+            to.splice( to.cbegin(), from, from.cbegin() );
+            EXPECT_EQ( to.front().value, 0 );
+            EXPECT_EQ( to.back().value, 1 );
+            EXPECT_EQ( from.size(), 2 );
+            EXPECT_EQ( to.size(), 2 );
+        }
+    }
+
+    {
+        BEGIN_TEST(tm3, "LazySize", "with sc::lazy_size a range splice is O(1) and size() counts the nodes later.");
+        using lazy_list = sc::list< int, std::allocator<int>, sc::lazy_size >;
+        lazy_list list_a{ 1, 2, 3, 4 };
+        lazy_list list_b{ 10, 20, 30, 40, 50 };
+        list_a.splice( std::next( list_a.cbegin() ), list_b, std::next( list_b.cbegin() ), std::prev( list_b.cend() ) );
+        EXPECT_EQ( list_a, ( lazy_list{ 1, 20, 30, 40, 2, 3, 4 } ) );
+        EXPECT_EQ( list_b, ( lazy_list{ 10, 50 } ) );
+        EXPECT_EQ( list_a.size(), 7 );
+        EXPECT_EQ( list_b.size(), 2 );
+
+        // The unknown length is carried through other operations, and resolved once.
+        list_b.splice( list_b.cend(), list_a, list_a.cbegin(), std::next( list_a.cbegin(), 4 ) );
+        list_a.push_back( 4 );
+        list_a.unique();
+        list_b.sort();
+        list_a.merge( list_b );
+        EXPECT_TRUE( list_b.empty() );
+        EXPECT_EQ( list_b.size(), 0 );
+        list_a.erase( list_a.cbegin() );
+        list_a.remove( 50 );
+        EXPECT_EQ( list_a, ( lazy_list{ 2, 3, 4, 10, 20, 30, 40 } ) );
+        EXPECT_EQ( list_a.size(), 7 );
+        lazy_list list_c;
+        list_c.splice( list_c.cend(), list_a, list_a.cbegin(), list_a.cend() );
+        EXPECT_TRUE( list_a.empty() );
+        EXPECT_FALSE( list_c.empty() );
+        lazy_list list_d( list_c );
+        EXPECT_EQ( list_d.size(), 7 );
+        list_a = list_c;
+        EXPECT_EQ( list_a.size(), 7 );
+        EXPECT_EQ( list_c.size(), 7 );
+
+        // find() and count() walk from both ends until they meet, whatever the length is known to be.
+        lazy_list list_e{ 5, 1, 5, 2 }, list_f{ 5, 3, 5 };
+        list_e.splice( list_e.cend(), list_f, list_f.cbegin(), std::next( list_f.cbegin(), 2 ) );
+        EXPECT_EQ( list_e.count( 5 ), 3 );                 // 5 1 5 2 5 3
+        EXPECT_TRUE( ( list_e.find( 5 ) == list_e.begin() ) );
+        EXPECT_TRUE( ( list_e.find( 3 ) == std::prev( list_e.end() ) ) );
+        EXPECT_TRUE( ( list_e.find( 2 ) == std::next( list_e.begin(), 3 ) ) );
+        EXPECT_EQ( list_f.count( 5 ), 1 );                 // 5
+        EXPECT_TRUE( list_f.contains( 5 ) );
+        EXPECT_FALSE( list_f.contains( 3 ) );
+        list_f.clear();
+        EXPECT_EQ( list_f.count( 5 ), 0 );
+        EXPECT_TRUE( ( list_f.find( 5 ) == list_f.end() ) );
+        EXPECT_EQ( list_e.size(), 6 );
+    }
+
 
     {
         BEGIN_TEST(tm3, "Reverse 1", "reverse a regular list.");
@@ -1060,9 +1746,1318 @@ past_last = list.erase( std::next(list.begin(),2) );
         EXPECT_EQ( list_r2, list_a ); // List A must be equal to list Result.
     }
 
+    {
+        BEGIN_TEST(tm3, "Sort 5", "sorting with a custom comparator.");
+        which_lib::list<int> list_a{ 4, 2, 1, 5, 3, 2 };
+        which_lib::list<int> list_r{ 5, 4, 3, 2, 2, 1 }; // List Result
+
+        list_a.sort( std::greater<int>() );
+        EXPECT_EQ( list_r, list_a ); // List A must be equal to list Result.
+        // The prev links must be consistent as well.
+        int expected[]{ 1, 2, 2, 3, 4, 5 };
+        auto it = list_a.end();
+        for ( const auto & e : expected )
+            EXPECT_EQ( *(--it), e );
+        EXPECT_EQ( it, list_a.begin() );
+        EXPECT_EQ( list_a.size(), 6 );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 6", "parallel sort keeps stability and links.");
+        struct Item{
+            int key; int seq;
+            inline bool operator<( const Item &a ) const
+            { return key < a.key; }
+        };
+        which_lib::list<Item> list_a;
+        const int n{ 200000 };
+        for ( auto i{0} ; i < n ; ++i )
+            list_a.push_back( { ( i * 7919 ) % 1000, i } ); // Many equivalent keys.
+
+        list_a.sort( sc::execution::par.with_threads( 4 ) );
+        EXPECT_EQ( list_a.size(), n );
+        auto ordered{ true };
+        auto count{ 1 };
+        for ( auto it = std::next( list_a.begin() ) ; it != list_a.end() ; ++it, ++count )
+        {
+            auto prev = std::prev( it );
+            if ( (*it).key < (*prev).key ) ordered = false;
+            if ( (*it).key == (*prev).key and (*it).seq < (*prev).seq ) ordered = false;
+        }
+        EXPECT_TRUE( ordered );
+        EXPECT_EQ( count, n );
+        // Walking backwards must reach the beginning as well.
+        count = 0;
+        for ( auto it = list_a.end() ; it != list_a.begin() ; --it ) ++count;
+        EXPECT_EQ( count, n );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 7", "parallel sort with a comparator matches the sequential one.");
+        which_lib::list<int> list_a;
+        for ( auto i{0} ; i < 100000 ; ++i )
+            list_a.push_back( static_cast<int>( ( i * 104729LL ) % 100003 ) );
+        which_lib::list<int> list_r{ list_a };
+
+        list_a.sort( sc::execution::par.with_threads( 3 ), std::greater<int>() );
+        list_r.sort( std::greater<int>() );
+        EXPECT_TRUE( std::equal( list_r.begin(), list_r.end(), list_a.begin() ) );
+        EXPECT_GE( list_a.front(), list_a.back() );
+
+        // A short list falls back to the sequential algorithm.
+        which_lib::list<int> list_b{ 3, 1, 2 };
+        list_b.sort( sc::execution::par );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 1, 2, 3 } ) );
+
+        // With std::less on ints, each run is radix sorted, as sort() does.
+        which_lib::list<int> list_c;
+        for ( auto i{0} ; i < 100000 ; ++i )
+            list_c.push_back( static_cast<int>( ( i * 7919LL ) % 100003 ) - 50000 );
+        which_lib::list<int> list_s{ list_c };
+        list_c.sort( sc::execution::par.with_threads( 4 ) );
+        list_s.sort();
+        EXPECT_TRUE( std::equal( list_s.begin(), list_s.end(), list_c.begin() ) );
+
+        // The pool is reused across calls, and a call made from inside a job runs inline.
+        std::vector<int> hits( 1000, 0 );
+        sc::execution::parallel_for( hits.size(), 4, [&]( size_t i ){ ++hits[i]; } );
+        sc::execution::parallel_for( 4, 4, [&]( size_t i ){
+            sc::execution::parallel_for( 250, 4, [&]( size_t j ){ ++hits[i * 250 + j]; } );
+        } );
+        EXPECT_TRUE( std::all_of( hits.begin(), hits.end(), []( int h ){ return h == 2; } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "Merge 7","merging two lists sorted in descending order.");
+        which_lib::list<int> list_a{ 9, 7, 5, 3, 1 };        // List A
+        which_lib::list<int> list_b{ 8, 6, 4, 2, 0 };        // List B
+        which_lib::list<int> list_r{ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }; // List Result
+
+        list_a.merge( list_b, std::greater<int>() ); // Merger B into A.
+        EXPECT_EQ( list_r, list_a ); // List A must be equal to list Result.
+        EXPECT_TRUE( list_b.empty() ); // List B must be empty (all nodes moved to A).
+        EXPECT_EQ( list_a.size(), 10 );
+        EXPECT_EQ( list_a.back(), 0 );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 8", "arithmetic lists are radix sorted, matching the merge sort.");
+        which_lib::list<int> list_a;
+        unsigned long long x{ 12345 };
+        for ( auto i{0} ; i < 100000 ; ++i ) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            list_a.push_back( static_cast<int>( x >> 32 ) );        // Negativos inclusive.
+        }
+        which_lib::list<int> list_r{ list_a };
+        auto first = list_a.begin();
+        auto value = *first;
+
+        list_a.sort();                                         // Radix sort.
+        list_r.sort( []( int a, int b ){ return a < b; } );    // Merge sort.
+        EXPECT_EQ( list_a, list_r );
+        EXPECT_EQ( *first, value );                            // Só os links mudam.
+        size_t count{ 0 };
+        for ( auto it = list_a.end() ; it != list_a.begin() ; --it ) ++count;
+        EXPECT_EQ( count, list_a.size() );
+
+        list_a.sort( std::greater<int>() );
+        list_r.sort( []( int a, int b ){ return a > b; } );
+        EXPECT_EQ( list_a, list_r );
+
+        which_lib::list<double> list_d;
+        for ( auto i{0} ; i < 1000 ; ++i ) list_d.push_back( ( ( i * 7919 ) % 2001 - 1000 ) / 8.0 );
+        list_d.push_back( -0.0 );
+        list_d.push_back( 1e300 );
+        list_d.push_back( -1e-300 );
+        list_d.sort();
+        EXPECT_TRUE( std::is_sorted( list_d.begin(), list_d.end() ) );
+        EXPECT_EQ( list_d.front(), -1000 / 8.0 );
+        EXPECT_EQ( list_d.back(), 1e300 );
+
+        which_lib::list<unsigned char> list_c;
+        for ( auto i{0} ; i < 300 ; ++i ) list_c.push_back( static_cast<unsigned char>( i * 37 ) );
+        list_c.sort();
+        EXPECT_TRUE( std::is_sorted( list_c.begin(), list_c.end() ) );
+        EXPECT_EQ( list_c.size(), 300 );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 9", "sort_by_radix() is stable and keeps every node if the key throws.");
+        struct Item{ unsigned long long key; int seq; };
+        which_lib::list<Item> list_a;
+        const int n{ 20000 };
+        for ( auto i{0} ; i < n ; ++i )
+            list_a.push_back( { ( i * 7919ULL % 1000 ) << 40, i } ); // Chaves só nos bits altos.
+
+        list_a.sort_by_radix( []( const Item & item ){ return item.key; } );
+        auto ordered{ true };
+        for ( auto it = std::next( list_a.begin() ) ; it != list_a.end() ; ++it )
+        {
+            auto prev = std::prev( it );
+            if ( (*it).key < (*prev).key ) ordered = false;
+            if ( (*it).key == (*prev).key and (*it).seq < (*prev).seq ) ordered = false;
+        }
+        EXPECT_TRUE( ordered );
+        EXPECT_EQ( list_a.size(), n );
+
+        // Ordena pelos números de sequência, com uma chave com sinal e decrescente.
+        list_a.sort_by_radix( []( const Item & item ){ return -item.seq; } );
+        EXPECT_EQ( list_a.front().seq, n - 1 );
+        EXPECT_EQ( list_a.back().seq, 0 );
+
+        int calls{ 0 };
+        auto throwing = [&]( const Item & item ){
+            if ( ++calls == n + n / 2 ) throw std::runtime_error( "key" ); // No meio de uma passada.
+            return item.seq;
+        };
+        bool thrown{ false };
+        try { list_a.sort_by_radix( throwing ); }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( list_a.size(), n );
+        long long sum{ 0 };
+        size_t count{ 0 };
+        for ( const auto & item : list_a ) { sum += item.seq; ++count; }
+        EXPECT_EQ( count, n );
+        EXPECT_EQ( sum, 1LL * n * ( n - 1 ) / 2 );
+        count = 0;
+        for ( auto it = list_a.end() ; it != list_a.begin() ; --it ) ++count;
+        EXPECT_EQ( count, n );
+    }
+    {
+        BEGIN_TEST(tm3, "Partial sort", "partial_sort() puts the k smallest in front, stably.");
+        struct Item{
+            int key; int seq;
+            inline bool operator<( const Item &a ) const
+            { return key < a.key; }
+        };
+        const int n{ 20000 };
+        which_lib::list<Item> list_a;
+        for ( auto i{0} ; i < n ; ++i )
+            list_a.push_back( { static_cast<int>( ( i * 104729LL ) % 5003 ), i } ); // Chaves repetidas.
+        which_lib::list<Item> list_r{ list_a };
+        auto first = list_a.begin();
+        auto value = (*first).seq;
+        list_r.sort();
+
+        for ( size_t k : { size_t{1}, size_t{7}, size_t{100}, size_t{5000} } ) {
+            which_lib::list<Item> list_b{ list_a };
+            list_b.partial_sort( k );
+            EXPECT_EQ( list_b.size(), n );
+            auto same = std::equal( list_r.begin(), std::next( list_r.begin(), k ), list_b.begin(),
+                []( const Item & a, const Item & b ){ return a.key == b.key and a.seq == b.seq; } );
+            EXPECT_TRUE( same );
+            long long sum{ 0 };
+            for ( const auto & item : list_b ) sum += item.seq;
+            EXPECT_EQ( sum, 1LL * n * ( n - 1 ) / 2 );
+            size_t count{ 0 };
+            for ( auto it = list_b.end() ; it != list_b.begin() ; --it ) ++count;
+            EXPECT_EQ( count, list_b.size() );
+        }
+        list_a.partial_sort( 3 );
+        EXPECT_EQ( (*first).seq, value );                      // Só os links mudam.
+
+        which_lib::list<int> list_c{ 5, 1, 4, 2, 3 };
+        list_c.partial_sort( 0 );
+        EXPECT_EQ( list_c, ( which_lib::list<int>{ 5, 1, 4, 2, 3 } ) );
+        list_c.partial_sort( 2, std::greater<int>() );
+        EXPECT_EQ( list_c.front(), 5 );
+        EXPECT_EQ( *std::next( list_c.begin() ), 4 );
+        list_c.partial_sort( 10 );
+        EXPECT_EQ( list_c, ( which_lib::list<int>{ 1, 2, 3, 4, 5 } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "Nth element", "nth_element() selects by relinking, and keeps every node if comp throws.");
+        const int n{ 10001 };
+        which_lib::list<int> list_a;
+        for ( auto i{0} ; i < n ; ++i ) list_a.push_back( static_cast<int>( ( i * 7919LL ) % 1000 ) );
+        std::vector<int> sorted( list_a.begin(), list_a.end() );
+        std::sort( sorted.begin(), sorted.end() );
+
+        for ( size_t nth : { size_t{0}, size_t{1}, size_t{n / 2}, size_t{n - 1} } ) {
+            which_lib::list<int> list_b{ list_a };
+            auto it = list_b.nth_element( nth );
+            EXPECT_EQ( *it, sorted[ nth ] );
+            EXPECT_TRUE( ( it == std::next( list_b.begin(), nth ) ) );
+            auto split{ true };
+            for ( auto p = list_b.begin() ; p != it ; ++p ) if ( *p > *it ) split = false;
+            for ( auto p = std::next( it ) ; p != list_b.end() ; ++p ) if ( *p < *it ) split = false;
+            EXPECT_TRUE( split );
+            EXPECT_EQ( list_b.size(), n );
+            size_t count{ 0 };
+            for ( auto p = list_b.end() ; p != list_b.begin() ; --p ) ++count;
+            EXPECT_EQ( count, list_b.size() );
+        }
+        EXPECT_TRUE( ( list_a.nth_element( n ) == list_a.end() ) );
+
+        // Listas já ordenadas (ou invertidas) e só com valores iguais.
+        which_lib::list<int> list_s;
+        for ( auto i{0} ; i < 5000 ; ++i ) list_s.push_back( i );
+        EXPECT_EQ( *list_s.nth_element( 1234, std::greater<int>() ), 5000 - 1 - 1234 );
+        which_lib::list<int> list_e;
+        for ( auto i{0} ; i < 3000 ; ++i ) list_e.push_back( 7 );
+        EXPECT_EQ( *list_e.nth_element( 2999 ), 7 );
+
+        int calls{ 0 };
+        auto throwing = [&]( int a, int b ){
+            if ( ++calls == 15000 ) throw std::runtime_error( "comp" );
+            return a < b;
+        };
+        bool thrown{ false };
+        try { list_a.nth_element( n / 3, throwing ); }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        std::vector<int> kept( list_a.begin(), list_a.end() );
+        std::sort( kept.begin(), kept.end() );
+        EXPECT_TRUE( ( kept == sorted ) );
+        calls = 15000 - 5000;
+        thrown = false;
+        try { list_a.partial_sort( 50, throwing ); }
+        catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        kept.assign( list_a.begin(), list_a.end() );
+        std::sort( kept.begin(), kept.end() );
+        EXPECT_TRUE( ( kept == sorted ) );
+        size_t count{ 0 };
+        for ( auto p = list_a.end() ; p != list_a.begin() ; --p ) ++count;
+        EXPECT_EQ( count, list_a.size() );
+    }
+
     std::cout << std::endl;
     tm3.summary();
 
+    //=== TESTING THE UNROLLED LIST
+    TestManager tm4{ "Unrolled List Test Suite"};
+    // Two ints per node, so that almost every operation crosses node boundaries.
+    using small_list = sc::unrolled_list<int, 32>;
+    {
+        BEGIN_TEST(tm4, "Capacity", "elements per node.");
+        EXPECT_EQ( small_list::capacity, 2 );
+        EXPECT_EQ( ( sc::unrolled_list<int, 64>::capacity ), 10 );
+        EXPECT_EQ( ( sc::unrolled_list<std::string, 8>::capacity ), 1 );
+    }
+    {
+        BEGIN_TEST(tm4, "Constructors", "constructors, assignment and comparison.");
+        small_list list{ 1, 2, 3, 4, 5 };
+        int v[]{ 1, 2, 3, 4, 5 };
+        small_list list2( std::begin(v), std::end(v) );
+        small_list list3{ list };
+        small_list list4( 3 );
+        EXPECT_EQ( list.size(), 5 );
+        EXPECT_EQ( list, list2 );
+        EXPECT_EQ( list, list3 );
+        EXPECT_EQ( list4, ( small_list{ 0, 0, 0 } ) );
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), std::begin(v) ) );
+
+        small_list list5{ std::move( list3 ) };
+        EXPECT_TRUE( list3.empty() );
+        list3 = list5;
+        list4 = std::move( list5 );
+        EXPECT_EQ( list3, list );
+        EXPECT_EQ( list4, list );
+        list4 = { 9, 8 };
+        EXPECT_NE( list4, list );
+        EXPECT_EQ( list4.front(), 9 );
+        EXPECT_EQ( list4.back(), 8 );
+    }
+    {
+        BEGIN_TEST(tm4, "InsertErase", "random inserts and erases agree with std::list.");
+        small_list list;
+        std::list<int> model;
+        unsigned seed{ 12345 };
+        auto next_rand = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 16 ) & 0x7fff; };
+        auto same = true;
+        for ( auto step{0} ; step < 2000 ; ++step )
+        {
+            size_t pos = model.empty() ? 0 : next_rand() % ( model.size() + 1 );
+            if ( next_rand() % 3 != 0 or model.empty() )
+            {
+                auto it = list.insert( std::next( list.begin(), pos ), step );
+                model.insert( std::next( model.begin(), pos ), step );
+                if ( *it != step ) same = false;
+            }
+            else
+            {
+                if ( pos == model.size() ) --pos;
+                auto it = list.erase( std::next( list.begin(), pos ) );
+                auto mit = model.erase( std::next( model.begin(), pos ) );
+                if ( ( it == list.end() ) != ( mit == model.end() ) or ( mit != model.end() and *it != *mit ) ) same = false;
+            }
+        }
+        EXPECT_TRUE( same );
+        EXPECT_EQ( list.size(), model.size() );
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), model.begin() ) );
+        // Walking backwards must visit the same elements.
+        EXPECT_TRUE( std::equal( model.rbegin(), model.rend(), std::reverse_iterator< small_list::iterator >( list.end() ) ) );
+
+        auto it = list.insert( std::next( list.begin() ), { 100, 200, 300 } );
+        EXPECT_EQ( *it, 100 );
+        EXPECT_EQ( *std::next( it, 2 ), 300 );
+        it = list.erase( std::next( list.begin() ), std::next( list.begin(), 4 ) );
+        EXPECT_EQ( list.size(), model.size() );
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), model.begin() ) );
+        list.erase( list.begin(), list.end() );
+        EXPECT_TRUE( list.empty() );
+    }
+    {
+        BEGIN_TEST(tm4, "PushPop", "push and pop at both ends.");
+        small_list list;
+        for ( auto i{0} ; i < 5 ; ++i ) { list.push_back( i ); list.push_front( -i ); }
+        EXPECT_EQ( list, ( small_list{ -4, -3, -2, -1, 0, 0, 1, 2, 3, 4 } ) );
+        list.pop_front();
+        list.pop_back();
+        EXPECT_EQ( list, ( small_list{ -3, -2, -1, 0, 0, 1, 2, 3 } ) );
+        while ( not list.empty() ) list.pop_back();
+        EXPECT_EQ( list.begin(), list.end() );
+        list.emplace_back( 7 );
+        EXPECT_EQ( list.front(), 7 );
+    }
+    {
+        BEGIN_TEST(tm4, "Splice", "splicing in the middle of a node.");
+        small_list list{ 1, 2, 3, 4, 5 };
+        small_list list2{ 10, 20, 30 };
+        list.splice( std::next( list.cbegin() ), list2 );
+        EXPECT_EQ( list, ( small_list{ 1, 10, 20, 30, 2, 3, 4, 5 } ) );
+        EXPECT_TRUE( list2.empty() );
+        EXPECT_EQ( list.size(), 8 );
+        small_list list3{ 7 };
+        list.splice( list.cend(), list3 );
+        EXPECT_EQ( list.back(), 7 );
+        EXPECT_EQ( *std::prev( list.end(), 2 ), 5 );
+    }
+    {
+        BEGIN_TEST(tm4, "Merge", "stable merge of two sorted lists.");
+        sc::unrolled_list< std::pair<int, int>, 40 > list{ { 1, 0 }, { 3, 0 }, { 5, 0 }, { 5, 1 } };
+        sc::unrolled_list< std::pair<int, int>, 40 > list2{ { 0, 2 }, { 3, 2 }, { 5, 2 }, { 9, 2 } };
+        list.merge( list2, []( const std::pair<int, int> & a, const std::pair<int, int> & b ){ return a.first < b.first; } );
+        sc::unrolled_list< std::pair<int, int>, 40 > expected{ { 0, 2 }, { 1, 0 }, { 3, 0 }, { 3, 2 }, { 5, 0 }, { 5, 1 }, { 5, 2 }, { 9, 2 } };
+        EXPECT_EQ( list, expected );
+        EXPECT_TRUE( list2.empty() );
+        {
+            using counted_list = sc::unrolled_list< int, 64, counting_allocator<int> >;
+            counted_list evens, odds;
+            for ( int i{0} ; i < 1000 ; ++i ) { evens.push_back( 2 * i ); odds.push_back( 2 * i + 1 ); }
+            evens.merge( odds, throwing_less() );
+            EXPECT_EQ( evens.size(), 2000u );
+            EXPECT_TRUE( std::is_sorted( evens.begin(), evens.end() ) );
+            EXPECT_LE( live_allocations, static_cast<int>( 2000 / counted_list::capacity + 2 ) );
+
+            counted_list more;
+            for ( int i{0} ; i < 1000 ; ++i ) more.push_back( 3 * i );
+            compares_left = 1500;                           // Lança no meio da intercalação.
+            bool thrown{ false };
+            try { evens.merge( more, throwing_less() ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            compares_left = -1;
+            EXPECT_TRUE( thrown );
+            EXPECT_TRUE( more.empty() );
+            EXPECT_EQ( evens.size(), 3000u );
+            std::vector<int> kept( evens.begin(), evens.end() ), all;
+            for ( int i{0} ; i < 2000 ; ++i ) all.push_back( i );
+            for ( int i{0} ; i < 1000 ; ++i ) all.push_back( 3 * i );
+            std::sort( kept.begin(), kept.end() );
+            std::sort( all.begin(), all.end() );
+            EXPECT_TRUE( ( kept == all ) );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+    {
+        BEGIN_TEST(tm4, "ReverseUnique", "reverse and unique.");
+        small_list list{ 1, 2, 3, 4, 5 };
+        list.reverse();
+        EXPECT_EQ( list, ( small_list{ 5, 4, 3, 2, 1 } ) );
+        EXPECT_EQ( *std::prev( list.end() ), 1 );
+        small_list list2{ 1, 1, 2, 2, 2, 3, 1, 1, 4 };
+        list2.unique();
+        EXPECT_EQ( list2, ( small_list{ 1, 2, 3, 1, 4 } ) );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_EQ( list2.back(), 4 );
+    }
+    {
+        BEGIN_TEST(tm4, "Sort", "stable sort with and without a comparator.");
+        small_list list;
+        for ( auto i{0} ; i < 1000 ; ++i ) list.push_back( ( i * 7919 ) % 1000 );
+        list.sort();
+        EXPECT_TRUE( std::is_sorted( list.begin(), list.end() ) );
+        EXPECT_EQ( list.size(), 1000 );
+        list.sort( std::greater<int>() );
+        EXPECT_EQ( list.front(), 999 );
+        EXPECT_EQ( list.back(), 0 );
+        sc::unrolled_list<std::string> list2{ "pear", "fig", "apple", "kiwi" };
+        list2.sort( []( const std::string & a, const std::string & b ){ return a.size() < b.size(); } );
+        EXPECT_EQ( list2, ( sc::unrolled_list<std::string>{ "fig", "pear", "kiwi", "apple" } ) );
+    }
+
+    std::cout << std::endl;
+    tm4.summary();
+
+    //=== TESTING THE INTRUSIVE LIST
+    TestManager tm5{ "Intrusive List Test Suite"};
+    struct Item
+    {
+        int value;
+        sc::list_hook hook;
+        Item( int v = 0 ) : value{ v } { }
+        bool operator<( const Item & rhs ) const { return value < rhs.value; }
+        bool operator==( const Item & rhs ) const { return value == rhs.value; }
+    };
+    using item_list = sc::intrusive_list< Item, &Item::hook >;
+    // Collects the values of a list, in order.
+    auto values_of = []( const item_list & l ){
+        std::vector<int> v;
+        for ( const auto & e : l ) v.push_back( e.value );
+        return v;
+    };
+    {
+        BEGIN_TEST(tm5, "Linking", "push, insert and erase link the client's own objects.");
+        std::vector<Item> items{ 0, 1, 2, 3, 4 };
+        item_list list;
+        for ( auto & e : items ) list.push_back( e );
+        EXPECT_EQ( list.size(), 5 );
+        EXPECT_EQ( &list.front(), &items[0] ); // No copy is made.
+        EXPECT_EQ( &list.back(), &items[4] );
+
+        auto it = list.erase( list.iterator_to( items[2] ) );
+        EXPECT_EQ( &(*it), &items[3] );
+        EXPECT_FALSE( items[2].hook.is_linked() );
+        list.insert( list.begin(), items[2] );
+        list.remove( items[4] );
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 2, 0, 1, 3 } ) );
+        list.pop_front();
+        list.pop_back();
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 0, 1 } ) );
+        list.clear();
+        EXPECT_TRUE( list.empty() );
+        for ( const auto & e : items ) EXPECT_FALSE( e.hook.is_linked() );
+    }
+    {
+        BEGIN_TEST(tm5, "SpliceSwap", "splice, swap and move relink in O(1).");
+        std::vector<Item> items{ 0, 1, 2, 3, 4, 5 };
+        item_list list, list2;
+        for ( auto i{0} ; i < 3 ; ++i ) list.push_back( items[i] );
+        for ( auto i{3} ; i < 6 ; ++i ) list2.push_back( items[i] );
+        list.splice( std::next( list.begin() ), list2 );
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 0, 3, 4, 5, 1, 2 } ) );
+        EXPECT_TRUE( list2.empty() );
+        list2.splice( list2.end(), list, list.iterator_to( items[4] ) );
+        EXPECT_EQ( list.size(), 5 );
+        EXPECT_EQ( values_of( list2 ), ( std::vector<int>{ 4 } ) );
+        list.swap( list2 );
+        EXPECT_EQ( list.size(), 1 );
+        EXPECT_EQ( list2.size(), 5 );
+        item_list list3{ std::move( list2 ) };
+        EXPECT_TRUE( list2.empty() );
+        EXPECT_EQ( values_of( list3 ), ( std::vector<int>{ 0, 3, 5, 1, 2 } ) );
+        EXPECT_EQ( &list3.back(), &items[2] );
+    }
+    {
+        BEGIN_TEST(tm5, "Algorithms", "sort, merge, reverse and unique never touch the objects.");
+        std::vector<Item> items{ 5, 3, 3, 1, 4, 1, 2, 6 };
+        item_list list, list2;
+        for ( auto i{0} ; i < 5 ; ++i ) list.push_back( items[i] );
+        for ( auto i{5} ; i < 8 ; ++i ) list2.push_back( items[i] );
+        list.sort();
+        list2.sort();
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 1, 3, 3, 4, 5 } ) );
+        EXPECT_EQ( &list.front(), &items[3] );
+        list.merge( list2 );
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 1, 1, 2, 3, 3, 4, 5, 6 } ) );
+        EXPECT_EQ( &list.front(), &items[3] ); // Stable: the element from *this comes first.
+        EXPECT_TRUE( list2.empty() );
+        list.unique();
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 1, 2, 3, 4, 5, 6 } ) );
+        EXPECT_EQ( list.size(), 6 );
+        EXPECT_FALSE( items[5].hook.is_linked() );
+        list.reverse();
+        EXPECT_EQ( values_of( list ), ( std::vector<int>{ 6, 5, 4, 3, 2, 1 } ) );
+        EXPECT_EQ( &list.back(), &items[3] );
+        EXPECT_EQ( &( *std::prev( list.end() ) ), &items[3] );
+        list.clear();
+    }
+
+    std::cout << std::endl;
+    tm5.summary();
+
+    //=== TESTING THE INDEXED LIST
+    TestManager tm6{ "Indexed List Test Suite"};
+    {
+        BEGIN_TEST(tm6, "Positions", "at(), index_of() and iterator arithmetic in O(log n).");
+        std::vector<int> values( 1000 );
+        for ( size_t i{0} ; i < values.size() ; ++i ) values[i] = static_cast<int>( i );
+        sc::indexed_list<int> list( values.begin(), values.end() );
+
+        EXPECT_EQ( list.size(), 1000 );
+        EXPECT_EQ( list.at( 0 ), 0 );
+        EXPECT_EQ( list[ 637 ], 637 );
+        EXPECT_EQ( list.at( 999 ), 999 );
+        bool thrown{ false };
+        try { list.at( 1000 ); }
+        catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        auto it = list.begin() + 500;
+        EXPECT_EQ( *it, 500 );
+        EXPECT_EQ( list.index_of( it ), 500 );
+        EXPECT_EQ( *( it - 450 ), 50 );
+        EXPECT_EQ( *( it + 3 ), 503 );
+        EXPECT_EQ( it[ -499 ], 1 );
+        EXPECT_EQ( list.end() - it, 500 );
+        EXPECT_EQ( it - list.end(), -500 );
+        EXPECT_EQ( std::distance( list.cbegin(), list.cend() ), 1000 );
+        EXPECT_TRUE( ( list.begin() < it ) );
+        EXPECT_TRUE( ( it + 500 == list.end() ) );
+        auto it2 = list.cbegin();
+        std::advance( it2, 999 );
+        EXPECT_EQ( *it2, 999 );
+    }
+
+    {
+        BEGIN_TEST(tm6, "Modifiers", "insert and erase keep the positions up to date.");
+        // Mirrors every operation on a vector and compares positions after each one.
+        sc::indexed_list<int> list;
+        std::vector<int> mirror;
+        bool consistent{ true };
+        unsigned seed{ 12345 };
+        for ( int i{0} ; i < 2000 ; ++i ) {
+            seed = seed * 1103515245u + 12345u;
+            size_t pos = mirror.empty() ? 0 : ( seed >> 8 ) % ( mirror.size() + 1 );
+            if ( mirror.empty() or ( seed >> 4 ) % 3 != 0 ) {
+                list.insert( list.cbegin() + pos, i );
+                mirror.insert( mirror.begin() + pos, i );
+            }
+            else {
+                pos = pos % mirror.size();
+                list.erase( list.cbegin() + pos );
+                mirror.erase( mirror.begin() + pos );
+            }
+            size_t probe = mirror.empty() ? 0 : ( seed >> 12 ) % mirror.size();
+            if ( list.size() != mirror.size() or ( not mirror.empty() and list[ probe ] != mirror[ probe ] ) )
+                consistent = false;
+        }
+        EXPECT_TRUE( consistent );
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), mirror.begin() ) );
+
+        for ( size_t i{0} ; i < mirror.size() ; ++i )
+            if ( list.index_of( list.cbegin() + i ) != i ) consistent = false;
+        EXPECT_TRUE( consistent );
+
+        list.erase( list.cbegin() + 10, list.cbegin() + 300 );
+        mirror.erase( mirror.begin() + 10, mirror.begin() + 300 );
+        EXPECT_EQ( list.size(), mirror.size() );
+        EXPECT_EQ( list[ 10 ], mirror[ 10 ] );
+        EXPECT_EQ( list.back(), mirror.back() );
+        list.push_front( -1 );
+        list.pop_back();
+        EXPECT_EQ( list.at( 11 ), mirror[ 10 ] );
+    }
+
+    {
+        BEGIN_TEST(tm6, "Splice", "splice of a list, an element or a range keeps both indexes right.");
+        sc::indexed_list<int> list{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        sc::indexed_list<int> list2{ 10, 11, 12, 13, 14 };
+
+        list.splice( list.cbegin() + 5, list2 );
+        EXPECT_EQ( list, ( sc::indexed_list<int>{ 0, 1, 2, 3, 4, 10, 11, 12, 13, 14, 5, 6, 7, 8, 9 } ) );
+        EXPECT_TRUE( list2.empty() );
+        EXPECT_EQ( list[ 9 ], 14 );
+        EXPECT_EQ( list.end() - list.begin(), 15 );
+
+        list2.splice( list2.cend(), list, list.cbegin() + 5, list.cbegin() + 10 );
+        EXPECT_EQ( list2, ( sc::indexed_list<int>{ 10, 11, 12, 13, 14 } ) );
+        EXPECT_EQ( list.size(), 10 );
+        EXPECT_EQ( list[ 5 ], 5 );
+
+        list.splice( list.cbegin(), list2, list2.cbegin() + 2 );
+        EXPECT_EQ( list.front(), 12 );
+        EXPECT_EQ( list2[ 2 ], 13 );
+        EXPECT_EQ( list2.size(), 4 );
+
+        // A range moved within the same list.
+        list.splice( list.cbegin(), list, list.cbegin() + 8, list.cend() );
+        EXPECT_EQ( list, ( sc::indexed_list<int>{ 7, 8, 9, 12, 0, 1, 2, 3, 4, 5, 6 } ) );
+        EXPECT_EQ( list.index_of( list.cend() - 1 ), 10 );
+        EXPECT_EQ( list[ 4 ], 0 );
+
+        list.insert( list.cbegin() + 3, { 100, 101 } );
+        EXPECT_EQ( list[ 3 ], 100 );
+        EXPECT_EQ( list[ 5 ], 12 );
+    }
+
+    {
+        BEGIN_TEST(tm6, "Algorithms", "sort, merge, reverse and unique rebuild the index.");
+        sc::indexed_list<int> list{ 5, 3, 3, 1, 4, 1, 9, 2 };
+        sc::indexed_list<int> list2{ 0, 6, 8 };
+
+        list.sort();
+        EXPECT_EQ( list, ( sc::indexed_list<int>{ 1, 1, 2, 3, 3, 4, 5, 9 } ) );
+        EXPECT_EQ( list[ 6 ], 5 );
+        list.merge( list2 );
+        EXPECT_EQ( list.size(), 11 );
+        EXPECT_EQ( list[ 9 ], 8 );
+        EXPECT_TRUE( list2.empty() );
+        list.unique();
+        EXPECT_EQ( list, ( sc::indexed_list<int>{ 0, 1, 2, 3, 4, 5, 6, 8, 9 } ) );
+        EXPECT_EQ( list.at( 8 ), 9 );
+        list.reverse();
+        EXPECT_EQ( list[ 0 ], 9 );
+        EXPECT_EQ( list[ 7 ], 1 );
+        EXPECT_EQ( list.index_of( list.cend() - 1 ), 8 );
+        list.push_back( 42 );
+        EXPECT_EQ( list[ 9 ], 42 );
+
+        sc::indexed_list<int> copy{ list };
+        EXPECT_EQ( copy, list );
+        copy = { 1, 2 };
+        EXPECT_EQ( copy.size(), 2 );
+        EXPECT_EQ( copy[ 1 ], 2 );
+        swap( copy, list );
+        EXPECT_EQ( list.size(), 2 );
+        EXPECT_EQ( copy[ 9 ], 42 );
+    }
+
+    std::cout << std::endl;
+    tm6.summary();
+
+    //=== TESTING THE CONCURRENT LIST
+    TestManager tm7{ "Concurrent List Test Suite"};
+    {
+        BEGIN_TEST(tm7, "BothEnds", "push and pop at both ends, and splice_out, on a single thread.");
+        sc::concurrent_list<int> list;
+        int value{ 0 };
+        EXPECT_FALSE( list.try_pop_front( value ) );
+        EXPECT_FALSE( list.try_pop_back( value ) );
+        for ( int i{1} ; i <= 5 ; ++i ) list.push_back( i );
+        list.push_front( 0 );
+        EXPECT_EQ( list.size(), 6 );
+        EXPECT_TRUE( list.try_pop_back( value ) );
+        EXPECT_EQ( value, 5 );
+        EXPECT_TRUE( list.try_pop_front( value ) );
+        EXPECT_EQ( value, 0 );
+
+        sc::list<int> batch = list.splice_out( 3 );
+        EXPECT_EQ( batch, ( sc::list<int>{ 1, 2, 3 } ) );
+        EXPECT_EQ( list.size(), 1 );
+        batch = list.splice_out( 10 );          // Fewer than asked for.
+        EXPECT_EQ( batch, ( sc::list<int>{ 4 } ) );
+        EXPECT_TRUE( list.empty() );
+        EXPECT_TRUE( list.splice_out( 10 ).empty() );
+        for ( int i{0} ; i < 8 ; ++i ) list.push_back( i );
+        batch = list.splice_out( 9 );           // More than size().
+        EXPECT_EQ( batch.size(), 8 );
+        EXPECT_TRUE( list.empty() );
+        for ( int i{0} ; i < 8 ; ++i ) list.push_back( i );
+        batch = list.splice_out( static_cast<size_t>( -1 ) );
+        EXPECT_EQ( batch, ( sc::list<int>{ 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+        EXPECT_TRUE( list.empty() );
+        list.emplace_back( 7 );
+        list.emplace_front( 6 );
+        EXPECT_TRUE( list.try_pop_back( value ) );
+        EXPECT_EQ( value, 7 );
+        EXPECT_TRUE( list.try_pop_back( value ) );
+        EXPECT_EQ( value, 6 );
+        EXPECT_TRUE( list.empty() );
+    }
+
+    {
+        BEGIN_TEST(tm7, "ProducersConsumers", "every element pushed by a producer is popped exactly once, in order.");
+        const int producers{ 4 }, consumers{ 4 }, per_producer{ 20000 };
+        sc::concurrent_list<int> list;
+        std::vector< std::vector<int> > received( consumers );
+        std::atomic<int> remaining{ producers * per_producer };
+        std::vector< std::thread > threads;
+        for ( int p{0} ; p < producers ; ++p )
+            threads.emplace_back( [&, p]{
+                for ( int i{0} ; i < per_producer ; ++i ) list.push_back( p * per_producer + i );
+            } );
+        for ( int c{0} ; c < consumers ; ++c )
+            threads.emplace_back( [&, c]{
+                int value;
+                while ( remaining > 0 ) {
+                    if ( c % 2 == 0 ) {                 // Half of the consumers take batches.
+                        sc::list<int> batch = list.splice_out( 16 );
+                        remaining -= static_cast<int>( batch.size() );
+                        for ( auto e : batch ) received[c].push_back( e );
+                    }
+                    else if ( list.try_pop_front( value ) ) {
+                        --remaining;
+                        received[c].push_back( value );
+                    }
+                    else std::this_thread::yield();
+                }
+            } );
+        for ( auto & t : threads ) t.join();
+
+        std::vector<int> seen( producers * per_producer, 0 );
+        bool in_order{ true };
+        for ( const auto & r : received ) {
+            std::vector<int> last( producers, -1 );
+            for ( auto e : r ) {
+                ++seen[e];
+                if ( e <= last[ e / per_producer ] ) in_order = false;
+                last[ e / per_producer ] = e;
+            }
+        }
+        EXPECT_TRUE( std::all_of( seen.begin(), seen.end(), []( int n ){ return n == 1; } ) );
+        EXPECT_TRUE( in_order );
+        EXPECT_TRUE( list.empty() );
+    }
+
+    {
+        BEGIN_TEST(tm7, "OppositeEnds", "threads working at opposite ends of a short list never lose an element.");
+        sc::concurrent_list<int> list;
+        const int rounds{ 50000 };
+        std::atomic<long long> popped_sum{ 0 };
+        auto worker = [&]( bool back ){
+            long long sum{ 0 };
+            int value;
+            for ( int i{1} ; i <= rounds ; ++i ) {
+                if ( back ) list.push_back( i ); else list.push_front( i );
+                if ( back ? list.try_pop_front( value ) : list.try_pop_back( value ) ) sum += value;
+            }
+            popped_sum += sum;
+        };
+        std::thread t1( worker, true ), t2( worker, false );
+        t1.join();
+        t2.join();
+        long long rest{ 0 };
+        int value;
+        while ( list.try_pop_back( value ) ) rest += value;
+        EXPECT_EQ( popped_sum + rest, 2LL * rounds * ( rounds + 1 ) / 2 );
+    }
+
+    std::cout << std::endl;
+    tm7.summary();
+
+    TestManager tm8{ "Lock-free Queue Test Suite"};
+    {
+        BEGIN_TEST(tm8, "Fifo", "elements come out in the order they went in; nodes are reused and all given back.");
+        {
+            sc::lockfree_list_queue< std::string, counting_allocator<std::string> > queue;
+            std::string value{ "untouched" };
+            EXPECT_FALSE( queue.try_pop( value ) );
+            EXPECT_EQ( value, std::string{ "untouched" } );
+            for ( int round{0} ; round < 3 ; ++round ) {
+                for ( int i{0} ; i < 1000 ; ++i ) queue.push( std::to_string( i ) );
+                bool in_order{ true };
+                for ( int i{0} ; i < 1000 ; ++i )
+                    if ( not queue.try_pop( value ) or value != std::to_string( i ) ) in_order = false;
+                EXPECT_TRUE( in_order );
+                EXPECT_FALSE( queue.try_pop( value ) );
+            }
+            queue.emplace( 3, 'x' );
+            EXPECT_TRUE( queue.try_pop( value ) );
+            EXPECT_EQ( value, std::string{ "xxx" } );
+            queue.push( "left behind" );        // Destroyed with the queue.
+        }
+        EXPECT_EQ( live_allocations, 0 );
+        {
+            // A constructor that throws hands its node back through the hazard pointers.
+            sc::lockfree_list_queue< throwing_copy, counting_allocator<throwing_copy> > queue;
+            throwing_copy item{ 7 }, out;
+            bool thrown{ false };
+            copies_left = 0;
+            try { queue.push( item ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            copies_left = -1;
+            EXPECT_TRUE( thrown );
+            EXPECT_FALSE( queue.try_pop( out ) );
+            queue.push( item );
+            EXPECT_TRUE( queue.try_pop( out ) );
+            EXPECT_EQ( out.value, 7 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm8, "ProducersConsumers", "every element pushed by a producer is popped exactly once, in order.");
+        const int producers{ 4 }, consumers{ 4 }, per_producer{ 20000 };
+        sc::pool_allocator<int> pool;               // Not thread-safe: the queue serializes its calls.
+        sc::lockfree_list_queue< int, sc::pool_allocator<int> > queue( pool );
+        std::vector< std::vector<int> > received( consumers );
+        std::atomic<int> remaining{ producers * per_producer };
+        std::vector< std::thread > threads;
+        for ( int p{0} ; p < producers ; ++p )
+            threads.emplace_back( [&, p]{
+                for ( int i{0} ; i < per_producer ; ++i ) queue.push( p * per_producer + i );
+            } );
+        for ( int c{0} ; c < consumers ; ++c )
+            threads.emplace_back( [&, c]{
+                int value;
+                while ( remaining > 0 ) {
+                    if ( queue.try_pop( value ) ) {
+                        --remaining;
+                        received[c].push_back( value );
+                    }
+                    else std::this_thread::yield();
+                }
+            } );
+        for ( auto & t : threads ) t.join();
+
+        std::vector<int> seen( producers * per_producer, 0 );
+        bool in_order{ true };
+        for ( const auto & r : received ) {
+            std::vector<int> last( producers, -1 );
+            for ( auto e : r ) {
+                ++seen[e];
+                if ( e <= last[ e / per_producer ] ) in_order = false;
+                last[ e / per_producer ] = e;
+            }
+        }
+        EXPECT_TRUE( std::all_of( seen.begin(), seen.end(), []( int n ){ return n == 1; } ) );
+        EXPECT_TRUE( in_order );
+        int value;
+        EXPECT_FALSE( queue.try_pop( value ) );
+    }
+
+    std::cout << std::endl;
+    tm8.summary();
+
+    TestManager tm9{ "Linked Hash Map Test Suite"};
+    {
+        BEGIN_TEST(tm9, "Lru", "a hit makes the entry the most recent; a full map evicts the least recent.");
+        sc::linked_hash_map< int, std::string > cache( 3 );
+        EXPECT_TRUE( cache.empty() );
+        EXPECT_EQ( cache.capacity(), 3u );
+        cache.put( 1, "one" );
+        cache.put( 2, "two" );
+        cache.put( 3, "three" );
+        EXPECT_EQ( cache.begin()->first, 1 );
+        EXPECT_EQ( *cache.get( 1 ), std::string{ "one" } );     // 1 passa a ser o mais recente.
+        EXPECT_EQ( cache.begin()->first, 2 );
+        cache.put( 4, "four" );                                 // Evicts 2.
+        EXPECT_EQ( cache.size(), 3u );
+        EXPECT_FALSE( cache.contains( 2 ) );
+        EXPECT_TRUE( ( cache.get( 2 ) == nullptr ) );
+        std::vector<int> order;
+        for ( const auto & e : cache ) order.push_back( e.first );
+        EXPECT_EQ( order, ( std::vector<int>{ 3, 1, 4 } ) );
+        cache.find( 3 );                                        // find() is not an access...
+        cache.put( 5, "five" );                                 // ... so 3 is evicted.
+        EXPECT_FALSE( cache.contains( 3 ) );
+        cache.put( 1, "uno" );                                  // Assigns and touches.
+        EXPECT_EQ( cache.at( 1 ), std::string{ "uno" } );
+        EXPECT_EQ( std::prev( cache.end() )->first, 1 );
+        EXPECT_FALSE( cache.try_emplace( 4, "cuatro" ).second );
+        EXPECT_EQ( cache.begin()->first, 4 );                   // try_emplace() of an existing key does not touch it.
+        cache[ 6 ] = "six";
+        EXPECT_EQ( cache.size(), 3u );
+        EXPECT_FALSE( cache.contains( 4 ) );
+    }
+
+    {
+        BEGIN_TEST(tm9, "Lfu", "the least frequently used entry is evicted, the oldest among ties.");
+        sc::linked_hash_map< int, int, sc::lfu_policy > cache( 3 );
+        cache.put( 1, 10 );
+        cache.put( 2, 20 );
+        cache.put( 3, 30 );
+        cache.get( 1 ); cache.get( 1 ); cache.get( 2 );         // Contagens: 1 -> 3, 2 -> 2, 3 -> 1.
+        cache.put( 4, 40 );                                     // Evicts 3.
+        EXPECT_FALSE( cache.contains( 3 ) );
+        cache.get( 4 );                                         // 4 -> 2, after 2 among the ties.
+        std::vector<int> order;
+        for ( const auto & e : cache ) order.push_back( e.first );
+        EXPECT_EQ( order, ( std::vector<int>{ 2, 4, 1 } ) );
+        cache.put( 5, 50 );                                     // Evicts 2.
+        EXPECT_FALSE( cache.contains( 2 ) );
+        cache.put( 6, 60 );                                     // 5 has the lowest count.
+        EXPECT_FALSE( cache.contains( 5 ) );
+        cache.erase( 1 );
+        for ( int i{0} ; i < 5 ; ++i ) cache.get( 6 );
+        order.clear();
+        for ( const auto & e : cache ) order.push_back( e.first );
+        EXPECT_EQ( order, ( std::vector<int>{ 4, 6 } ) );
+        // Stress against a reference count, with keys evicted and reinserted.
+        sc::linked_hash_map< int, int, sc::lfu_policy > big( 64 );
+        std::vector<int> hits( 256, 0 );
+        unsigned seed{ 7 };
+        bool consistent{ true };
+        for ( int i{0} ; i < 20000 ; ++i ) {
+            seed = seed * 1103515245u + 12345u;
+            int key = ( seed >> 16 ) % 256;
+            if ( big.get( key ) != nullptr ) ++hits[key];
+            else { big.put( key, key ); hits[key] = 0; }
+            int previous{ -1 };                                 // Counts never decrease along the order.
+            if ( i % 97 == 0 )
+                for ( const auto & e : big ) {
+                    if ( hits[e.first] < previous ) consistent = false;
+                    previous = hits[e.first];
+                }
+        }
+        EXPECT_TRUE( consistent );
+        EXPECT_EQ( big.size(), 64u );
+        // The group records come from the map's allocator.
+        {
+            sc::linked_hash_map< int, int, sc::lfu_policy, std::hash<int>, std::equal_to<int>,
+                                 counting_allocator< std::pair< const int, int > > > counted( 4 );
+            counted.put( 1, 1 );
+            counted.put( 2, 2 );
+            const int before{ live_allocations };
+            counted.get( 1 );                                   // A new group, for count 2.
+            counted.get( 2 );                                   // Joins it; the group of count 1 is recycled...
+            counted.get( 1 );                                   // ... for count 3.
+            EXPECT_EQ( live_allocations, before + 1 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm9, "Clock", "referenced entries get a second chance; hits do not relink.");
+        sc::linked_hash_map< int, int, sc::clock_policy > cache( 3 );
+        cache.put( 1, 1 );
+        cache.put( 2, 2 );
+        cache.put( 3, 3 );
+        cache.get( 1 );
+        std::vector<int> order;
+        for ( const auto & e : cache ) order.push_back( e.first );
+        EXPECT_EQ( order, ( std::vector<int>{ 1, 2, 3 } ) );
+        cache.put( 4, 4 );                                      // 1 is referenced: 2 goes.
+        EXPECT_FALSE( cache.contains( 2 ) );
+        EXPECT_TRUE( cache.contains( 1 ) );
+        cache.put( 5, 5 );                                      // The hand is past 1: 3 goes.
+        EXPECT_FALSE( cache.contains( 3 ) );
+        cache.get( 4 ); cache.get( 5 );
+        cache.put( 6, 6 );                                      // 1 lost its bit on the first sweep.
+        EXPECT_FALSE( cache.contains( 1 ) );
+        cache.get( 4 ); cache.get( 5 ); cache.get( 6 );
+        cache.put( 7, 7 );                                      // Every bit set: a full sweep, then the first one.
+        EXPECT_EQ( cache.size(), 3u );
+        cache.erase( cache.begin() );
+        cache.erase( cache.begin() );
+        cache.put( 8, 8 );
+        EXPECT_EQ( cache.size(), 2u );
+        cache.clear();
+        EXPECT_TRUE( cache.empty() );
+        cache.put( 9, 9 );
+        EXPECT_EQ( cache.begin()->first, 9 );
+    }
+
+    {
+        BEGIN_TEST(tm9, "Unbounded", "with no capacity the map grows, rehashing, and erases by key or position.");
+        {
+            sc::linked_hash_map< int, int, sc::lru_policy, std::hash<int>, std::equal_to<int>,
+                                 counting_allocator< std::pair< const int, int > > > map;
+            for ( int i{0} ; i < 10000 ; ++i ) map.try_emplace( i, i * 2 );
+            EXPECT_EQ( map.size(), 10000u );
+            EXPECT_GE( map.bucket_count(), 10000u );
+            bool found{ true };
+            for ( int i{0} ; i < 10000 ; ++i )
+                if ( map.find( i ) == map.end() or map.find( i )->second != i * 2 ) found = false;
+            EXPECT_TRUE( found );
+            for ( int i{0} ; i < 10000 ; i += 2 ) map.erase( i );
+            EXPECT_EQ( map.size(), 5000u );
+            EXPECT_EQ( map.erase( 0 ), 0u );
+            EXPECT_EQ( map.count( 1 ), 1u );
+            auto it = map.erase( map.find( 1 ) );
+            EXPECT_EQ( it->first, 3 );
+            int expected{ 3 };
+            bool in_order{ true };
+            for ( const auto & e : map ) { if ( e.first != expected ) in_order = false; expected += 2; }
+            EXPECT_TRUE( in_order );
+
+            static_assert( std::is_nothrow_move_constructible< decltype(map) >::value, "moving a map must not throw" );
+            const int before_move{ live_allocations };
+            decltype(map) moved( std::move( map ) );             // No buckets are made for the moved-from map.
+            EXPECT_EQ( live_allocations, before_move );
+            EXPECT_TRUE( map.empty() );
+            EXPECT_EQ( map.bucket_count(), 0u );
+            EXPECT_FALSE( map.contains( 3 ) );
+            EXPECT_EQ( map.erase( 3 ), 0u );
+            EXPECT_EQ( moved.size(), 4999u );
+            map = std::move( moved );
+            EXPECT_EQ( map.size(), 4999u );
+            map.put( -1, 0 );
+            EXPECT_EQ( std::prev( map.end() )->first, -1 );
+
+            // If growing the buckets fails, the new node is released and nothing changes.
+            decltype(map) small;
+            for ( int i{0} ; i < static_cast<int>( small.bucket_count() ) ; ++i ) small.try_emplace( i, i );
+            const auto len = small.size();
+            const int before{ live_allocations };
+            array_allocations_left = 0;
+            bool thrown{ false };
+            try { small.try_emplace( -1, 0 ); }
+            catch ( const std::bad_alloc & ) { thrown = true; }
+            array_allocations_left = -1;
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( live_allocations, before );
+            EXPECT_EQ( small.size(), len );
+            EXPECT_FALSE( small.contains( -1 ) );
+            EXPECT_EQ( small.begin()->first, 0 );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    std::cout << std::endl;
+    tm9.summary();
+
+    TestManager tm10{ "Sharded LRU Test Suite"};
+    {
+        BEGIN_TEST(tm10, "Lru", "buffered hits are replayed before an eviction, so each shard evicts its least recent entry.");
+        {
+            sc::sharded_lru< int, std::string, std::hash<int>, std::equal_to<int>,
+                             counting_allocator< std::pair< const int, std::string > > > cache( 3, 1 );
+            EXPECT_EQ( cache.shard_count(), 1u );
+            EXPECT_EQ( cache.capacity(), 3u );
+            EXPECT_TRUE( cache.put( 1, "one" ) );
+            cache.put( 2, "two" );
+            cache.put( 3, "three" );
+            std::string value{ "untouched" };
+            EXPECT_FALSE( cache.get( 9, value ) );
+            EXPECT_EQ( value, std::string{ "untouched" } );
+            EXPECT_TRUE( cache.get( 1, value ) );           // Só registrado no buffer...
+            EXPECT_EQ( value, std::string{ "one" } );
+            cache.put( 4, "four" );                         // ... e aplicado antes da remoção: sai o 2.
+            EXPECT_FALSE( cache.contains( 2 ) );
+            EXPECT_TRUE( cache.contains( 1 ) );
+            EXPECT_FALSE( cache.put( 3, "tres" ) );         // Assigns and makes 3 the most recent.
+            cache.put( 5, "five" );
+            EXPECT_FALSE( cache.contains( 1 ) );
+            EXPECT_TRUE( cache.get( 3, value ) );
+            EXPECT_EQ( value, std::string{ "tres" } );
+            for ( int i{0} ; i < 1000 ; ++i ) cache.get( 4, value );   // Fills the buffer many times over.
+            cache.put( 6, "six" );
+            EXPECT_FALSE( cache.contains( 5 ) );
+            EXPECT_TRUE( cache.contains( 3 ) and cache.contains( 4 ) );
+            EXPECT_EQ( cache.erase( 4 ), 1u );
+            EXPECT_EQ( cache.erase( 4 ), 0u );
+            EXPECT_EQ( cache.size(), 2u );
+            cache.clear();
+            EXPECT_TRUE( cache.empty() );
+            cache.put( 7, "seven" );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm10, "Shards", "the capacity is split among the shards and every shard stays within its share.");
+        sc::sharded_lru< int, int > cache( 1000, 10 );      // Rounded up to 16 shards of 63 entries.
+        EXPECT_EQ( cache.shard_count(), 16u );
+        EXPECT_EQ( cache.capacity(), 16u * 63u );
+        for ( int i{0} ; i < 100000 ; ++i ) cache.put( i, -i );
+        EXPECT_LE( cache.size(), cache.capacity() );
+        EXPECT_GT( cache.size(), 900u );
+        bool consistent{ true };
+        int value;
+        for ( int i{0} ; i < 100000 ; ++i )
+            if ( cache.get( i, value ) and value != -i ) consistent = false;
+        EXPECT_TRUE( consistent );
+        EXPECT_TRUE( cache.contains( 99999 ) );
+    }
+
+    {
+        BEGIN_TEST(tm10, "Concurrent", "threads reading and writing overlapping keys always see the value stored for a key.");
+        sc::sharded_lru< int, long long > cache( 512, 8 );
+        std::atomic<bool> consistent{ true };
+        std::vector< std::thread > threads;
+        for ( int t{0} ; t < 8 ; ++t )
+            threads.emplace_back( [&, t]{
+                unsigned seed = 17u * t + 1u;
+                long long value;
+                for ( int i{0} ; i < 50000 ; ++i ) {
+                    seed = seed * 1103515245u + 12345u;
+                    int key = ( seed >> 16 ) % 2048;
+                    if ( cache.get( key, value ) ) { if ( value != 3LL * key ) consistent = false; }
+                    else if ( i % 3 == 0 ) cache.erase( key ^ 1 );
+                    else cache.put( key, 3LL * key );
+                }
+            } );
+        for ( auto & t : threads ) t.join();
+        EXPECT_TRUE( consistent.load() );
+        EXPECT_LE( cache.size(), cache.capacity() );
+    }
+
+    std::cout << std::endl;
+    tm10.summary();
+
+    TestManager tm11{ "Sorted List Test Suite"};
+    {
+        BEGIN_TEST(tm11, "Insert", "elements are kept in ascending order, equivalents in insertion order.");
+        sc::sorted_list< int > l{ 5, 3, 9, 1, 3 };
+        EXPECT_EQ( l.size(), 5u );
+        EXPECT_TRUE( std::equal( l.begin(), l.end(), std::vector<int>{ 1, 3, 3, 5, 9 }.begin() ) );
+        EXPECT_EQ( *l.insert( 4 ), 4 );
+        l.emplace( 0 );
+        l.insert( 10 );
+        EXPECT_EQ( l.front(), 0 );
+        EXPECT_EQ( l.back(), 10 );
+        using pair_list = sc::sorted_list< std::pair<int, int>, bool (*)( const std::pair<int, int> &, const std::pair<int, int> & ) >;
+        pair_list by_key( []( const std::pair<int, int> & a, const std::pair<int, int> & b ){ return a.first < b.first; } );
+        for ( int i{0} ; i < 6 ; ++i ) by_key.insert( std::make_pair( i % 2, i ) );
+        std::vector<int> seconds;
+        for ( const auto & e : by_key ) seconds.push_back( e.second );
+        EXPECT_EQ( seconds, ( std::vector<int>{ 0, 2, 4, 1, 3, 5 } ) );
+        sc::sorted_list< int, std::greater<int> > descending{ 2, 7, 1 };
+        EXPECT_EQ( descending.front(), 7 );
+    }
+
+    {
+        BEGIN_TEST(tm11, "Lookup", "find, lower_bound, upper_bound, equal_range and count.");
+        sc::sorted_list< int > l;
+        for ( int i{0} ; i < 1000 ; ++i ) l.insert( ( i * 7919 ) % 1000 * 2 );   // Os pares de 0 a 1998.
+        l.insert( 500 );
+        EXPECT_EQ( *l.find( 998 ), 998 );
+        EXPECT_TRUE( ( l.find( 999 ) == l.end() ) );
+        EXPECT_EQ( *l.lower_bound( 999 ), 1000 );
+        EXPECT_EQ( *l.upper_bound( 1000 ), 1002 );
+        EXPECT_TRUE( ( l.lower_bound( 1999 ) == l.end() ) );
+        EXPECT_EQ( l.count( 500 ), 2u );
+        auto range = l.equal_range( 500 );
+        EXPECT_EQ( std::distance( range.first, range.second ), 2 );
+        EXPECT_TRUE( l.contains( 0 ) );
+        EXPECT_FALSE( l.contains( -2 ) );
+    }
+
+    {
+        BEGIN_TEST(tm11, "Erase", "random inserts and erases agree with std::multiset; no node is leaked.");
+        {
+            sc::sorted_list< int, std::less<int>, counting_allocator<int> > l;
+            std::multiset< int > reference;
+            unsigned seed{ 11 };
+            bool agree{ true };
+            for ( int i{0} ; i < 20000 ; ++i ) {
+                seed = seed * 1103515245u + 12345u;
+                int value = ( seed >> 16 ) % 500;
+                switch ( i % 4 ) {
+                    case 0: case 1: l.insert( value ); reference.insert( value ); break;
+                    case 2: if ( l.erase( value ) != reference.erase( value ) ) agree = false; break;
+                    default:
+                        auto found = l.find( value );
+                        if ( found != l.end() ) { l.erase( found ); reference.erase( reference.find( value ) ); }
+                }
+            }
+            EXPECT_TRUE( agree );
+            EXPECT_EQ( l.size(), reference.size() );
+            EXPECT_TRUE( std::equal( l.begin(), l.end(), reference.begin() ) );
+            l.pop_front();
+            l.pop_back();
+            EXPECT_EQ( l.front(), *std::next( reference.begin() ) );
+            EXPECT_EQ( l.back(), *std::prev( reference.end(), 2 ) );
+            l.erase( l.lower_bound( 100 ), l.lower_bound( 400 ) );
+            EXPECT_TRUE( ( l.lower_bound( 100 ) == l.lower_bound( 400 ) ) );
+            sc::sorted_list< int, std::less<int>, counting_allocator<int> > copy( l ), moved( std::move( l ) );
+            EXPECT_EQ( copy, moved );
+            EXPECT_TRUE( l.empty() );
+            l = copy;
+            EXPECT_EQ( l, moved );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    {
+        BEGIN_TEST(tm11, "MergeUnique", "merge is stable and linear; unique and remove_if keep the lookups working.");
+        sc::sorted_list< int > a{ 1, 4, 4, 9 }, b{ 0, 4, 10 };
+        a.merge( b );
+        EXPECT_TRUE( b.empty() );
+        EXPECT_EQ( a, ( sc::sorted_list< int >{ 0, 1, 4, 4, 4, 9, 10 } ) );
+        a.unique();
+        EXPECT_EQ( a, ( sc::sorted_list< int >{ 0, 1, 4, 9, 10 } ) );
+        sc::sorted_list< int > big;
+        big.insert( { 5, 3, 8 } );
+        std::vector<int> values( 5000 );
+        for ( int i{0} ; i < 5000 ; ++i ) values[i] = ( i * 31 ) % 5000;
+        big.insert( values.begin(), values.end() );           // Bulk: sorted aside and merged.
+        big.merge( a );
+        EXPECT_EQ( big.size(), 5008u );
+        EXPECT_TRUE( std::is_sorted( big.begin(), big.end() ) );
+        EXPECT_EQ( big.remove_if( []( int v ){ return v % 2 == 1; } ), 2504u );
+        bool found{ true };
+        for ( int v{0} ; v < 5000 ; v += 2 ) if ( big.find( v ) == big.end() ) found = false;
+        EXPECT_TRUE( found );
+        EXPECT_TRUE( ( big.find( 3 ) == big.end() ) );
+        big.insert( 3 );
+        EXPECT_EQ( *std::next( big.find( 3 ) ), 4 );
+    }
+
+    {
+        BEGIN_TEST(tm11, "ThrowingCompare", "a throwing comparison leaks no node; erase never compares.");
+        {
+            using throwing_list = sc::sorted_list< int, throwing_less, counting_allocator<int> >;
+            throwing_list l;
+            for ( int i{0} ; i < 2000 ; ++i ) l.insert( ( i * 7919 ) % 2000 );
+            compares_left = 5;
+            bool thrown{ false };
+            try { for ( int i{0} ; i < 100 ; ++i ) l.emplace( i ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( l.size(), 2000u );
+            EXPECT_EQ( live_allocations, 2000 );
+
+            std::vector<int> few{ 1, 2, 3, 4, 5, 6, 7, 8 };     // Poucos: inseridos um a um.
+            compares_left = 40;
+            thrown = false;
+            try { l.insert( few.begin(), few.end() ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( live_allocations, static_cast<int>( l.size() ) );
+            EXPECT_GE( l.size(), 2000u );
+            EXPECT_LT( l.size(), 2008u );
+
+            compares_left = 0;                              // Toda comparação agora lança.
+            throwing_list::const_iterator pos;
+            static_assert( noexcept( l.erase( pos ) ), "erase(pos) must not throw" );
+            for ( int i{0} ; l.size() > 1000 ; ++i ) {
+                if ( i % 2 == 0 ) l.pop_back();
+                else l.erase( std::next( l.cbegin(), 1 ) );
+            }
+            compares_left = -1;
+            EXPECT_EQ( l.size(), 1000u );
+            EXPECT_TRUE( std::is_sorted( l.begin(), l.end() ) );
+            bool found{ true };
+            for ( int v : l ) if ( l.find( v ) == l.end() ) found = false;
+            EXPECT_TRUE( found );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+        {
+            // The bulk path (sort aside, then merge) and merge() keep both lists sorted.
+            using throwing_list = sc::sorted_list< int, throwing_less, counting_allocator<int> >;
+            auto check = []( const throwing_list & l ){
+                bool ok = std::is_sorted( l.begin(), l.end() ) and live_allocations >= static_cast<int>( l.size() );
+                for ( int v : l ) if ( l.find( v ) == l.end() ) ok = false;
+                return ok;
+            };
+            std::vector<int> values( 300 );
+            for ( int i{0} ; i < 300 ; ++i ) values[i] = ( i * 7919 ) % 1000;
+            throwing_list l;
+            for ( int i{0} ; i < 100 ; ++i ) l.insert( i * 10 + 5 );
+
+            // How many comparisons the whole bulk insert takes.
+            throwing_list dry{ l };
+            compares_left = 1000000;
+            dry.insert( values.begin(), values.end() );
+            int total = 1000000 - compares_left;
+            dry.clear();
+
+            for ( int budget : { 10, total - 20 } ) {   // In the sort, then in the merge.
+                compares_left = budget;
+                bool thrown{ false };
+                try { l.insert( values.begin(), values.end() ); }
+                catch ( const std::runtime_error & ) { thrown = true; }
+                compares_left = -1;
+                EXPECT_TRUE( thrown );
+                EXPECT_TRUE( check( l ) );
+                EXPECT_EQ( live_allocations, static_cast<int>( l.size() ) );
+            }
+            EXPECT_GT( l.size(), 100u );
+            EXPECT_LT( l.size(), 400u );
+
+            throwing_list other( values.begin(), values.end() );
+            size_t both = l.size() + other.size();
+            compares_left = 50;
+            bool thrown{ false };
+            try { l.merge( other ); }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            compares_left = -1;
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( l.size() + other.size(), both );
+            EXPECT_FALSE( other.empty() );
+            EXPECT_TRUE( check( l ) );
+            EXPECT_TRUE( check( other ) );
+            l.merge( other );
+            EXPECT_TRUE( other.empty() );
+            EXPECT_EQ( l.size(), both );
+            EXPECT_TRUE( check( l ) );
+        }
+        EXPECT_EQ( live_allocations, 0 );
+    }
+
+    std::cout << std::endl;
+    tm11.summary();
+
     return 0;
 }
     